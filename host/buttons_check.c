@@ -0,0 +1,346 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           buttons_check.c                                       *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <main.h>
+#include <buttons.h>
+#include <scheduler.h>
+#include <telemetry.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Contact bounce patterns against buttons.c on its own , on a simulated
+// clock. Each pattern is a list of switch edges and the events it must give ,
+// times in us from the start of the pattern , played BOUNCE_PATTERN_US apart
+// with every switch released in between. Exits non-zero on any difference.
+#define BOUNCE_PATTERN_US       5000000
+#define BOUNCE_TIMERS_MAX       8
+#define BOUNCE_EVENTS_MAX       8
+
+typedef struct
+{
+    uint32_t Time;
+    uint8_t  Button;    // SW1 is 0
+    bool     Level;
+} Bounce_Edge_t;
+
+typedef struct
+{
+    const char          *Name;
+    const Bounce_Edge_t *Edges;
+    uint                 EdgeCount;
+    Button_Event_t       Events [ BOUNCE_EVENTS_MAX ];
+    uint                 EventCount;
+} Bounce_Pattern_t;
+
+typedef struct
+{
+    uint32_t             Time;
+    Hal_TimerCallback_t  Callback;
+    void                *User;
+    bool                 Active;
+} Bounce_Timer_t;
+
+static const uint Bounce_Pins [ BUTTON_COUNT ] = { SW1 , SW2 , SW3 , SW4 };
+
+static const Bounce_Edge_t Bounce_Tap [ ] = {
+    { 0 , 0 , 1 } , { 120000 , 0 , 0 } ,
+};
+
+static const Bounce_Edge_t Bounce_Chatter [ ] = {
+    {      0 , 0 , 1 } , {    700 , 0 , 0 } , {   1500 , 0 , 1 } , {   2600 , 0 , 0 } , {   4000 , 0 , 1 } ,
+    { 300000 , 0 , 0 } , { 300400 , 0 , 1 } , { 301000 , 0 , 0 } , { 302500 , 0 , 1 } , { 303000 , 0 , 0 } ,
+};
+
+static const Bounce_Edge_t Bounce_Spike [ ] = {
+    { 0 , 0 , 1 } , { 3000 , 0 , 0 } ,
+};
+
+static const Bounce_Edge_t Bounce_Long [ ] = {
+    { 0 , 0 , 1 } , { 800 , 0 , 0 } , { 1600 , 0 , 1 } , { 1500000 , 0 , 0 } ,
+};
+
+static const Bounce_Edge_t Bounce_Dropout [ ] = {
+    { 0 , 0 , 1 } , { 500000 , 0 , 0 } , { 500800 , 0 , 1 } , { 1400000 , 0 , 0 } ,
+};
+
+static const Bounce_Edge_t Bounce_Chord [ ] = {
+    {      0 , 0 , 1 } , { 100000 , 1 , 1 } , { 100500 , 1 , 0 } , { 101000 , 1 , 1 } ,
+    { 200000 , 1 , 0 } , { 250000 , 0 , 0 } ,
+};
+
+static const Bounce_Edge_t Bounce_Regrip [ ] = {
+    {      0 , 2 , 1 } , { 200000 , 2 , 0 } , { 205000 , 2 , 1 } , { 210000 , 2 , 0 } , { 215000 , 2 , 1 } ,
+    { 600000 , 2 , 0 } ,
+};
+
+static const Bounce_Edge_t Bounce_Slow [ ] = {
+    { 0 , 3 , 1 } , { 25000 , 3 , 0 } , { 50000 , 3 , 1 } , { 75000 , 3 , 0 } ,
+};
+
+#define BOUNCE_EDGES( edges )   ( edges ) , ( sizeof ( edges ) / sizeof ( ( edges ) [ 0 ] ) )
+
+static const Bounce_Pattern_t Bounce_Patterns [ ] = {
+    { "clean tap"          , BOUNCE_EDGES ( Bounce_Tap ) ,
+      { { 0 , 0x1 , BUTTON_EVENT_PRESS } , { 120000 , 0x1 , BUTTON_EVENT_RELEASE } } , 2 } ,
+    { "chatter"            , BOUNCE_EDGES ( Bounce_Chatter ) ,
+      { { 0 , 0x1 , BUTTON_EVENT_PRESS } , { 300000 , 0x1 , BUTTON_EVENT_RELEASE } } , 2 } ,
+    { "spike"              , BOUNCE_EDGES ( Bounce_Spike ) ,
+      { { 0 } } , 0 } ,
+    { "long press"         , BOUNCE_EDGES ( Bounce_Long ) ,
+      { { 0 , 0x1 , BUTTON_EVENT_PRESS } , { 1000000 , 0x1 , BUTTON_EVENT_LONG } , { 1500000 , 0x1 , BUTTON_EVENT_RELEASE } } , 3 } ,
+    { "dropout while held" , BOUNCE_EDGES ( Bounce_Dropout ) ,
+      { { 0 , 0x1 , BUTTON_EVENT_PRESS } , { 1000000 , 0x1 , BUTTON_EVENT_LONG } , { 1400000 , 0x1 , BUTTON_EVENT_RELEASE } } , 3 } ,
+    { "chord"              , BOUNCE_EDGES ( Bounce_Chord ) ,
+      { { 0 , 0x1 , BUTTON_EVENT_PRESS } , { 100000 , 0x3 , BUTTON_EVENT_CHORD } ,
+        { 200000 , 0x2 , BUTTON_EVENT_RELEASE } , { 250000 , 0x1 , BUTTON_EVENT_RELEASE } } , 4 } ,
+    { "release regripped"  , BOUNCE_EDGES ( Bounce_Regrip ) ,
+      { { 0 , 0x4 , BUTTON_EVENT_PRESS } , { 600000 , 0x4 , BUTTON_EVENT_RELEASE } } , 2 } ,
+    { "slower than debounce" , BOUNCE_EDGES ( Bounce_Slow ) ,
+      { { 0 , 0x8 , BUTTON_EVENT_PRESS } , { 25000 , 0x8 , BUTTON_EVENT_RELEASE } ,
+        { 50000 , 0x8 , BUTTON_EVENT_PRESS } , { 75000 , 0x8 , BUTTON_EVENT_RELEASE } } , 4 } ,
+};
+
+static Bounce_Timer_t Bounce_Timers [ BOUNCE_TIMERS_MAX ];
+static Hal_Handler_t  Bounce_Handler = NULL;
+static uint32_t       Bounce_Now     = 0;
+static uint32_t       Bounce_Pending [ BUTTON_COUNT ];
+static bool           Bounce_Level   [ BUTTON_COUNT ];
+
+static bool Bounce_Play  ( const Bounce_Pattern_t *pattern , uint32_t base );
+static void Bounce_RunTo ( uint32_t time );
+
+int main ( int argc , char **argv )
+{
+    uint32_t Failed          = 0;
+    uint     Counter_Pattern = 0;
+
+    Buttons_Init ( );
+
+    for ( Counter_Pattern = 0 ; Counter_Pattern < ( sizeof ( Bounce_Patterns ) / sizeof ( Bounce_Patterns [ 0 ] ) ) ; Counter_Pattern++ )
+    {
+        Failed += Bounce_Play ( &Bounce_Patterns [ Counter_Pattern ] , ( Counter_Pattern + 1 ) * BOUNCE_PATTERN_US ) ? 0 : 1;
+    }
+
+    printf ( "buttons    %u patterns , %u failed , %u edges , %u events , %u dropped\n" ,
+             Counter_Pattern , Failed , Buttons_Stats.Edges , Buttons_Stats.Events , Buttons_Stats.Dropped );
+
+    return ( 0 == Failed ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void Hal_Barrier ( void )
+{
+}
+
+uint32_t Hal_GpioEvents ( uint pin )
+{
+    uint32_t Events         = 0;
+    uint     Counter_Button = 0;
+
+    for ( Counter_Button = 0 ; Counter_Button < BUTTON_COUNT ; Counter_Button++ )
+    {
+        if ( Bounce_Pins [ Counter_Button ] == pin )
+        {
+            Events                            = Bounce_Pending [ Counter_Button ];
+            Bounce_Pending [ Counter_Button ] = 0;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Events;
+}
+
+bool Hal_GpioGet ( uint pin )
+{
+    bool Level          = false;
+    uint Counter_Button = 0;
+
+    for ( Counter_Button = 0 ; Counter_Button < BUTTON_COUNT ; Counter_Button++ )
+    {
+        Level = ( Bounce_Pins [ Counter_Button ] == pin ) ? Bounce_Level [ Counter_Button ] : Level;
+    }
+
+    return Level;
+}
+
+void Hal_GpioIrq ( uint32_t pins , uint32_t edges , Hal_Handler_t handler )
+{
+    Bounce_Handler = handler;
+}
+
+uint32_t Hal_Micros ( void )
+{
+    return Bounce_Now;
+}
+
+void Hal_TimerCancel ( int32_t id )
+{
+    if ( ( 0 < id ) && ( id <= BOUNCE_TIMERS_MAX ) )
+    {
+        Bounce_Timers [ id - 1 ].Active = false;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+int32_t Hal_TimerStart ( uint32_t delay_us , Hal_TimerCallback_t callback , void *user_data )
+{
+    int32_t Id            = 0;
+    uint    Counter_Timer = 0;
+
+    for ( Counter_Timer = 0 ; ( 0 == Id ) && ( Counter_Timer < BOUNCE_TIMERS_MAX ) ; Counter_Timer++ )
+    {
+        if ( !Bounce_Timers [ Counter_Timer ].Active )
+        {
+            Bounce_Timers [ Counter_Timer ] = ( Bounce_Timer_t ) { Bounce_Now + delay_us , callback , user_data , true };
+            Id = ( int32_t ) ( Counter_Timer + 1 );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Id;
+}
+
+void Scheduler_Event ( void )
+{
+}
+
+void Telemetry_ButtonDrop ( uint8_t mask , uint8_t type )
+{
+}
+
+// Drive the pattern's edges through the GPIO interrupt , let every alarm
+// run out and compare the queued events with the expected ones
+static bool Bounce_Play ( const Bounce_Pattern_t *pattern , uint32_t base )
+{
+    const Bounce_Edge_t  *Edge         = NULL;
+    const Button_Event_t *Expected     = NULL;
+    Button_Event_t        Event;
+    uint                  Counter_Edge = 0;
+    uint                  Count        = 0;
+    bool                  Same         = true;
+
+    for ( Counter_Edge = 0 ; Counter_Edge < pattern->EdgeCount ; Counter_Edge++ )
+    {
+        Edge = &pattern->Edges [ Counter_Edge ];
+
+        Bounce_RunTo ( base + Edge->Time );
+        Bounce_Now                       = base + Edge->Time;
+        Bounce_Level   [ Edge->Button ]  = Edge->Level;
+        Bounce_Pending [ Edge->Button ] |= Edge->Level ? HAL_EDGE_RISE : HAL_EDGE_FALL;
+        Bounce_Handler ( );
+    }
+
+    Bounce_RunTo ( base + BOUNCE_PATTERN_US - 1 );
+
+    while ( Buttons_Get ( &Event ) )
+    {
+        Expected = ( Count < pattern->EventCount ) ? &pattern->Events [ Count ] : NULL;
+
+        if ( ( NULL == Expected ) || ( Expected->Type != Event.Type ) || ( Expected->Mask != Event.Mask ) || ( ( base + Expected->Time ) != Event.Time ) )
+        {
+            fprintf ( stderr , "%s: event %u is type %u mask 0x%x at %u us" , pattern->Name , Count , Event.Type , Event.Mask , Event.Time - base );
+
+            if ( NULL != Expected )
+            {
+                fprintf ( stderr , " , expected type %u mask 0x%x at %u us\n" , Expected->Type , Expected->Mask , Expected->Time );
+            }
+            else
+            {
+                fprintf ( stderr , " , expected none\n" );
+            }
+
+            Same = false;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Count++;
+    }
+
+    if ( Count < pattern->EventCount )
+    {
+        fprintf ( stderr , "%s: %u events , expected %u\n" , pattern->Name , Count , pattern->EventCount );
+        Same = false;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Same;
+}
+
+// Fire every alarm due up to time , in time order , as the timer interrupt would
+static void Bounce_RunTo ( uint32_t time )
+{
+    Bounce_Timer_t *Timer         = NULL;
+    int64_t         Again         = 0;
+    uint            Counter_Timer = 0;
+
+    do
+    {
+        Timer = NULL;
+
+        for ( Counter_Timer = 0 ; Counter_Timer < BOUNCE_TIMERS_MAX ; Counter_Timer++ )
+        {
+            if ( Bounce_Timers [ Counter_Timer ].Active && ( Bounce_Timers [ Counter_Timer ].Time <= time ) &&
+                 ( ( NULL == Timer ) || ( Bounce_Timers [ Counter_Timer ].Time < Timer->Time ) ) )
+            {
+                Timer = &Bounce_Timers [ Counter_Timer ];
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+
+        if ( NULL != Timer )
+        {
+            Bounce_Now    = Timer->Time;
+            Timer->Active = false;
+            Again         = Timer->Callback ( ( int32_t ) ( Timer - Bounce_Timers ) + 1 , Timer->User );
+
+            if ( 0 < Again )
+            {
+                Timer->Time   = Bounce_Now + ( uint32_t ) Again;
+                Timer->Active = true;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    while ( NULL != Timer );
+}
+
+/*** end of file ***/
@@ -0,0 +1,185 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           check.c                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <check.h>
+#include <gamma.h>
+#include <host.h>
+#include <hub75.h>
+
+#define CHECK_ADDRESS_MASK  ( ( 1u << BIT_A_PIN ) | ( 1u << BIT_B_PIN ) | ( 1u << BIT_C_PIN ) | ( 1u << BIT_D_PIN ) )
+#define CHECK_RGB_MASK      ( ( 1u << LED_R1_PIN ) | ( 1u << LED_G1_PIN ) | ( 1u << LED_B1_PIN ) | ( 1u << LED_R2_PIN ) | ( 1u << LED_G2_PIN ) | ( 1u << LED_B2_PIN ) )
+
+static uint32_t Check_Level      = 0;       // Bit n = pin n
+static uint64_t Check_Address    = 0;       // Time of the last row address change
+static uint64_t Check_Clock      = 0;       // Time of the last CLK edge
+static uint64_t Check_Data       = 0;       // Time of the last colour change
+static uint64_t Check_Expected   = 0;       // Output on time for the current line at its brightness ( ns )
+static uint64_t Check_LineOn     = 0;       // Output on time for the current line ( ns )
+static uint64_t Check_OnStart    = 0;
+static bool     Check_OnValid    = false;   // The output was seen to turn on
+static uint32_t Check_Reported   = 0;
+
+Check_Stats_t Check_Stats;
+
+static void Check_Fail ( uint32_t *count , uint64_t time , const char *what , uint64_t value );
+
+bool Check_Passed ( void )
+{
+    return ( 0 == ( Check_Stats.Address + Check_Stats.Clock + Check_Stats.Data + Check_Stats.Dwell + Check_Stats.Latch ) );
+}
+
+// Times in ns , in order for the HUB75 pins
+void Check_Pin ( uint64_t time , uint pin , bool level )
+{
+    uint32_t Mask     = 1u << pin;
+    uint64_t Slack    = ( ( uint64_t ) HUB75_COLOUR_DEPTH * CHECK_DWELL_UNITS * HUB75_DWELL_UNIT * 1000 ) / ( HOST_CLOCK_HZ / 1000000 );
+    bool     LatchOn  = ( 0 != ( Check_Level & ( 1u << MATRIX_LAT_PIN ) ) );
+    bool     OutputOn = ( 0 == ( Check_Level & ( 1u << MATRIX_OE_PIN  ) ) ) && Check_OnValid;
+
+    if ( level == ( 0 != ( Check_Level & Mask ) ) )
+    {
+        // Not a change
+    }
+    else if ( MATRIX_CLK_PIN == pin )
+    {
+        if ( ( 0 != Check_Clock ) && ( ( time - Check_Clock ) < CHECK_CLOCK_MIN_NS ) )
+        {
+            Check_Fail ( &Check_Stats.Clock , time , "CLK pulse ( ns )" , time - Check_Clock );
+        }
+        else if ( level && ( 0 != Check_Data ) && ( ( time - Check_Data ) < CHECK_SETUP_MIN_NS ) )
+        {
+            Check_Fail ( &Check_Stats.Data , time , "colour setup ( ns )" , time - Check_Data );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Check_Stats.Clocks += level ? 1 : 0;
+        Check_Clock         = time;
+    }
+    else if ( MATRIX_LAT_PIN == pin )
+    {
+        if ( OutputOn )
+        {
+            Check_Fail ( &Check_Stats.Latch , time , "LAT with output on" , level );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else if ( MATRIX_OE_PIN == pin )
+    {
+        if ( !level && LatchOn )
+        {
+            Check_Fail ( &Check_Stats.Latch , time , "output on with LAT high" , 0 );
+        }
+        else if ( !level )
+        {
+            // Brightness only changes between frames , so the line's first on sets what it should add up to
+            if ( 0 == Check_LineOn )
+            {
+                Check_Expected = ( HUB75_DWELL_US * 1000ull * Gamma_Table [ Hub75_Host_Brightness ( ) ] ) / GAMMA_FULL;
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            Check_OnStart = time;
+            Check_OnValid = true;
+        }
+        else if ( Check_OnValid )
+        {
+            Check_LineOn += time - Check_OnStart;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else if ( CHECK_ADDRESS_MASK & Mask )
+    {
+        if ( OutputOn )
+        {
+            Check_Fail ( &Check_Stats.Address , time , "row address with output on" , pin );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        // Address lines of one change share a timestamp , the line ends at the first
+        if ( ( time != Check_Address ) && ( 0 != Check_LineOn ) )
+        {
+            if ( ( ( Check_LineOn > Check_Expected ) ? ( Check_LineOn - Check_Expected ) : ( Check_Expected - Check_LineOn ) ) > ( ( ( Check_Expected * CHECK_DWELL_TOLERANCE ) / 10000 ) + Slack ) )
+            {
+                Check_Fail ( &Check_Stats.Dwell , time , "line dwell ( ns )" , Check_LineOn );
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            Check_Stats.Lines++;
+            Check_LineOn = 0;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Check_Address = time;
+    }
+    else if ( CHECK_RGB_MASK & Mask )
+    {
+        if ( 0 != ( Check_Level & ( 1u << MATRIX_CLK_PIN ) ) )
+        {
+            Check_Fail ( &Check_Stats.Data , time , "colour with CLK high" , pin );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Check_Data = time;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Check_Level = level ? ( Check_Level | Mask ) : ( Check_Level & ~Mask );
+}
+
+static void Check_Fail ( uint32_t *count , uint64_t time , const char *what , uint64_t value )
+{
+    ( *count )++;
+
+    if ( Check_Reported < CHECK_REPORT_MAX )
+    {
+        fprintf ( stderr , "check: %llu ns : %s , %llu\n" , ( unsigned long long ) time , what , ( unsigned long long ) value );
+        Check_Reported++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+/*** end of file ***/
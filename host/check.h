@@ -0,0 +1,49 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           check.h                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __CHECK_H
+#define __CHECK_H
+
+#include <main.h>
+
+// HUB75 timing invariants , checked on every pin change of the host build
+#define CHECK_CLOCK_MIN_NS      25      // CLK high and low time
+#define CHECK_DWELL_TOLERANCE   100     // Per line output on time , parts per 10 000 ...
+#define CHECK_DWELL_UNITS       2       // ... plus this many HUB75_DWELL_UNIT per plane for the on / off split
+#define CHECK_REPORT_MAX        10      // Violations printed , the rest are only counted
+#define CHECK_SETUP_MIN_NS      10      // Colour data stable before CLK rises
+
+typedef struct
+{
+    uint32_t Address;   // Row address changed with the output on
+    uint32_t Clock;     // CLK pulse shorter than CHECK_CLOCK_MIN_NS
+    uint32_t Clocks;    // CLK rising edges seen
+    uint32_t Data;      // Colour changed with CLK high or too close to its rise
+    uint32_t Dwell;     // Line output on time off by more than CHECK_DWELL_TOLERANCE
+    uint32_t Latch;     // LAT changed with the output on , or output on with LAT high
+    uint32_t Lines;     // Scan lines checked for dwell
+} Check_Stats_t;
+
+extern Check_Stats_t Check_Stats;
+
+bool Check_Passed ( void );
+void Check_Pin    ( uint64_t time , uint pin , bool level );
+
+#endif /* __CHECK_H */
+
+/*** end of file ***/
@@ -0,0 +1,421 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           frames.c                                              *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <main.h>
+#include <animation.h>
+#include <hub75.h>
+#include <matrix.h>
+#include <matrix_layout.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Golden frames for Matrix_Compose , run against matrix.c on its own :
+//   frames write <dir>       Render every FRAMES_PASS pattern at every pos as <dir>/frame_<pass>_<pos>.ppm ,
+//                            pass being the whole bitmap in hex , pos running on to one past the end
+//                            of the jig and MATRIX_POS_UNKNOWN
+//   frames compare <dir>     Render the same frames and compare them with the ones in <dir>
+//   frames sweep [ count ]   Compose count sampled states in turn , default FRAMES_SWEEP_DEFAULT ,
+//                            checking each frame and its dirty rows against the display contract
+// The golden set is kept in host/golden and checked by the compare target.
+// Rewrite it only for an intended change to the display. Exits non-zero on
+// any difference.
+#define FRAMES_SWEEP_DEFAULT    1000000
+#define FRAMES_REPORT_MAX       10
+#define FRAMES_POS_PAST         ( SENSOR_COUNT + 1 )    // Any pos past the end of the jig , Expected index
+
+// SensorPass patterns rendered at each pos , repeated every 24 sensors
+static const uint32_t FRAMES_PASS [ ] = {
+    0x000000 ,      // All fail
+    0xFFFFFF ,      // All pass
+    0x555555 ,
+    0xAAAAAA ,
+    0x000FFF ,      // Top half passed , bottom half failed
+    0xFFF000 ,
+    0x8C31E7 ,
+};
+
+static uint32_t Frames_Buffer [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];
+
+volatile uint32_t Hub75_FrameCount = 0;    // Held at 0 , every tile shows its plain colour
+static uint32_t Frames_Random = 0x2545F491;
+
+static void     Frames_Bitmap  ( uint32_t pattern , uint8_t *pass );
+static bool     Frames_Compare ( const char *dir , const uint8_t *pass , uint8_t pos );
+static uint32_t Frames_Expect  ( const uint8_t *pass , uint8_t pos , uint row , uint column );
+static char    *Frames_Hex     ( const uint8_t *pass );
+static bool     Frames_Sweep   ( uint32_t count );
+static uint32_t Frames_Xorshift ( void );
+static bool     Frames_Write   ( const char *dir , const uint8_t *pass , uint8_t pos );
+
+int main ( int argc , char **argv )
+{
+    uint8_t Pass           [ SENSOR_BYTES ];
+    bool    Passed         = true;
+    uint8_t Counter_Pass   = 0;
+    uint8_t Counter_Pos    = 0;
+    uint8_t Pos            = 0;
+
+    if ( ( 3 == argc ) && ( ( 0 == strcmp ( argv [ 1 ] , "write" ) ) || ( 0 == strcmp ( argv [ 1 ] , "compare" ) ) ) )
+    {
+        for ( Counter_Pass = 0 ; Counter_Pass < ( sizeof ( FRAMES_PASS ) / sizeof ( FRAMES_PASS [ 0 ] ) ) ; Counter_Pass++ )
+        {
+            Frames_Bitmap ( FRAMES_PASS [ Counter_Pass ] , Pass );
+
+            for ( Counter_Pos = 0 ; Counter_Pos <= ( FRAMES_POS_PAST + 1 ) ; Counter_Pos++ )
+            {
+                Pos = ( Counter_Pos <= FRAMES_POS_PAST ) ? Counter_Pos : MATRIX_POS_UNKNOWN;
+
+                Matrix_Compose ( Pass , &Pos );
+
+                if ( 'w' == argv [ 1 ] [ 0 ] )
+                {
+                    Passed = Frames_Write ( argv [ 2 ] , Pass , Pos ) && Passed;
+                }
+                else
+                {
+                    Passed = Frames_Compare ( argv [ 2 ] , Pass , Pos ) && Passed;
+                }
+            }
+        }
+    }
+    else if ( ( 2 <= argc ) && ( 0 == strcmp ( argv [ 1 ] , "sweep" ) ) )
+    {
+        Passed = Frames_Sweep ( ( 3 == argc ) ? strtoul ( argv [ 2 ] , NULL , 0 ) : FRAMES_SWEEP_DEFAULT );
+    }
+    else
+    {
+        fprintf ( stderr , "usage: frames write <dir> | compare <dir> | sweep [ count ]\n" );
+        Passed = false;
+    }
+
+    return Passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// The compositor draws straight into Frames_Buffer
+void Hub75_Blit ( uint row , uint column , const uint32_t *lanes , uint words , uint32_t colour )
+{
+    uint Counter_Column = 0;
+
+    for ( Counter_Column = 0 ; ( Counter_Column < ( words * 4 ) ) && ( ( column + Counter_Column ) < MATRIX_WIDTH ) && ( row < MATRIX_HEIGHT ) ; Counter_Column++ )
+    {
+        Frames_Buffer [ row ] [ column + Counter_Column ] = ( ( lanes [ Counter_Column / 4 ] >> ( ( Counter_Column % 4 ) * 8 ) ) & 0xFF ) ? colour : 0;
+    }
+}
+
+void Hub75_FillRect ( uint row , uint column , uint width , uint height , uint32_t colour )
+{
+    uint Counter_Column = 0;
+    uint Counter_Row    = 0;
+
+    for ( Counter_Row = row ; ( Counter_Row < ( row + height ) ) && ( Counter_Row < MATRIX_HEIGHT ) ; Counter_Row++ )
+    {
+        for ( Counter_Column = column ; ( Counter_Column < ( column + width ) ) && ( Counter_Column < MATRIX_WIDTH ) ; Counter_Column++ )
+        {
+            Frames_Buffer [ Counter_Row ] [ Counter_Column ] = colour;
+        }
+    }
+}
+
+uint32_t Hal_Micros ( void )
+{
+    return 0;
+}
+
+void Hub75_Present ( uint32_t dirty_rows )
+{
+}
+
+void Hub75_SetPixel ( uint row , uint column , uint32_t colour )
+{
+    Hub75_FillRect ( row , column , 1 , 1 , colour );
+}
+
+static void Frames_Bitmap ( uint32_t pattern , uint8_t *pass )
+{
+    uint8_t Counter_Sensor = 0;
+
+    memset ( pass , 0 , SENSOR_BYTES );
+
+    for ( Counter_Sensor = 0 ; Counter_Sensor < SENSOR_COUNT ; Counter_Sensor++ )
+    {
+        pass [ Counter_Sensor / 8 ] |= ( uint8_t ) ( ( ( pattern >> ( Counter_Sensor % 24 ) ) & 1 ) << ( Counter_Sensor % 8 ) );
+    }
+}
+
+static bool Frames_Compare ( const char *dir , const uint8_t *pass , uint8_t pos )
+{
+    static uint32_t Reported = 0;
+
+    char     Name [ 256 ];
+    uint8_t  Pixel [ 3 ];
+    FILE    *File           = NULL;
+    uint32_t Colour         = 0;
+    uint     Columns        = 0;
+    uint     Rows           = 0;
+    uint     Counter_Column = 0;
+    uint     Counter_Row    = 0;
+    bool     Same           = false;
+
+    snprintf ( Name , sizeof ( Name ) , "%s/frame_%s_%02u.ppm" , dir , Frames_Hex ( pass ) , pos );
+    File = fopen ( Name , "rb" );
+
+    if ( ( NULL != File ) && ( 2 == fscanf ( File , "P6 %u %u 255" , &Columns , &Rows ) ) && ( MATRIX_WIDTH == Columns ) && ( MATRIX_HEIGHT == Rows ) )
+    {
+        Same = ( '\n' == fgetc ( File ) );
+
+        for ( Counter_Row = 0 ; Same && ( Counter_Row < MATRIX_HEIGHT ) ; Counter_Row++ )
+        {
+            for ( Counter_Column = 0 ; Same && ( Counter_Column < MATRIX_WIDTH ) ; Counter_Column++ )
+            {
+                Colour = ( 3 == fread ( Pixel , 1 , 3 , File ) ) ? ( ( ( uint32_t ) Pixel [ 0 ] << 16 ) | ( Pixel [ 1 ] << 8 ) | Pixel [ 2 ] ) : ~0u;
+                Same   = ( Colour == Frames_Buffer [ Counter_Row ] [ Counter_Column ] );
+            }
+        }
+
+        if ( !Same && ( Reported++ < FRAMES_REPORT_MAX ) )
+        {
+            fprintf ( stderr , "%s: differs at row %u column %u\n" , Name , Counter_Row - 1 , Counter_Column - 1 );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        fprintf ( stderr , "%s: missing or not a %u x %u frame\n" , Name , MATRIX_WIDTH , MATRIX_HEIGHT );
+    }
+
+    if ( NULL != File )
+    {
+        fclose ( File );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Same;
+}
+
+// The display contract written out longhand : completed sensors below pos
+// are green for a pass and red for a fail , pos is yellow and the rest blue.
+// A pos past the end of the jig is unknown , every tile dimmed blue with the
+// chase pixel at its first keyframe , the top left. The first half of the
+// sensors sit in the top half of the panel and the rest in the bottom.
+static uint32_t Frames_Expect ( const uint8_t *pass , uint8_t pos , uint row , uint column )
+{
+    uint32_t Colour         = COLOUR_BLACK;
+    uint8_t  Counter_Sensor = 0;
+
+    for ( Counter_Sensor = 0 ; Counter_Sensor < SENSOR_COUNT ; Counter_Sensor++ )
+    {
+        if ( ( row    >= MatrixTile [ Counter_Sensor ].Row    ) && ( row    < ( MatrixTile [ Counter_Sensor ].Row    + TILE_HEIGHT ) ) &&
+             ( column >= MatrixTile [ Counter_Sensor ].Column ) && ( column < ( MatrixTile [ Counter_Sensor ].Column + TILE_WIDTH  ) ) &&
+             ( ( Counter_Sensor < ( SENSOR_COUNT / 2 ) ) == ( row < ( MATRIX_HEIGHT / 2 ) ) ) )
+        {
+            if ( pos > SENSOR_COUNT )
+            {
+                Colour = ( ( row == MatrixTile [ Counter_Sensor ].Row ) && ( column == MatrixTile [ Counter_Sensor ].Column ) ) ? COLOUR_BLUE : ( COLOUR_BLUE / ANIMATION_CHASE_DIM );
+            }
+            else if ( Counter_Sensor < pos )
+            {
+                Colour = ( ( pass [ Counter_Sensor / 8 ] >> ( Counter_Sensor % 8 ) ) & 1 ) ? COLOUR_GREEN : COLOUR_RED;
+            }
+            else if ( Counter_Sensor == pos )
+            {
+                Colour = COLOUR_YELLOW;
+            }
+            else
+            {
+                Colour = COLOUR_BLUE;
+            }
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Colour;
+}
+
+// Bitmap as one hex number , sensor 0 in the least significant bit
+static char *Frames_Hex ( const uint8_t *pass )
+{
+    static char Text [ ( SENSOR_BYTES * 2 ) + 1 ];
+
+    uint8_t Counter_Byte = 0;
+
+    for ( Counter_Byte = 0 ; Counter_Byte < SENSOR_BYTES ; Counter_Byte++ )
+    {
+        snprintf ( &Text [ Counter_Byte * 2 ] , 3 , "%02x" , pass [ SENSOR_BYTES - 1 - Counter_Byte ] );
+    }
+
+    return Text;
+}
+
+// Sampled states in the order a jig run meets them , a sensor finishing
+// and pos moving on , with a jump to a random state one step in four. One
+// jump in eight is to a pos past the end of the jig , as a silent or stale
+// test bed is shown.
+static bool Frames_Sweep ( uint32_t count )
+{
+    static uint32_t Expected [ 2 ] [ FRAMES_POS_PAST + 1 ] [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];    // All fail , all pass
+    static uint32_t Previous [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];
+    static uint32_t Wanted   [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];
+
+    uint8_t  Pass           [ SENSOR_BYTES ];
+    uint8_t  All            [ 2 ] [ SENSOR_BYTES ];
+    uint32_t Dirty          = 0;
+    uint32_t Failed         = 0;
+    uint32_t Counter_Step   = 0;
+    uint     Counter_Column = 0;
+    uint     Counter_Row    = 0;
+    uint8_t  Completed      = 0;    // Sensors with a result
+    uint8_t  Pos            = 0;
+    uint8_t  Counter_Pos    = 0;
+    uint8_t  Counter_Sensor = 0;
+    bool     Same           = true;
+
+    memset ( Pass      , 0    , sizeof ( Pass      ) );
+    memset ( All [ 0 ] , 0    , sizeof ( All [ 0 ] ) );
+    memset ( All [ 1 ] , 0xFF , sizeof ( All [ 1 ] ) );
+
+    for ( Counter_Pos = 0 ; Counter_Pos <= FRAMES_POS_PAST ; Counter_Pos++ )
+    {
+        for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+        {
+            for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+            {
+                Expected [ 0 ] [ Counter_Pos ] [ Counter_Row ] [ Counter_Column ] = Frames_Expect ( All [ 0 ] , Counter_Pos , Counter_Row , Counter_Column );
+                Expected [ 1 ] [ Counter_Pos ] [ Counter_Row ] [ Counter_Column ] = Frames_Expect ( All [ 1 ] , Counter_Pos , Counter_Row , Counter_Column );
+            }
+        }
+    }
+
+    for ( Counter_Step = 0 ; Counter_Step < count ; Counter_Step++ )
+    {
+        if ( ( 0 == ( Frames_Xorshift ( ) & 3 ) ) || ( SENSOR_COUNT <= Pos ) )
+        {
+            for ( Counter_Sensor = 0 ; Counter_Sensor < SENSOR_BYTES ; Counter_Sensor++ )     // SENSOR_COUNT is a multiple of 8
+            {
+                Pass [ Counter_Sensor ] = ( uint8_t ) Frames_Xorshift ( );
+            }
+
+            if ( 0 == ( Frames_Xorshift ( ) & 7 ) )
+            {
+                Pos = ( uint8_t ) ( FRAMES_POS_PAST + ( Frames_Xorshift ( ) % ( MATRIX_POS_UNKNOWN - SENSOR_COUNT ) ) );
+            }
+            else
+            {
+                Pos = Frames_Xorshift ( ) % ( SENSOR_COUNT + 1 );
+            }
+        }
+        else
+        {
+            Pass [ Pos / 8 ] = ( uint8_t ) ( ( Pass [ Pos / 8 ] & ~( 1u << ( Pos % 8 ) ) ) | ( ( Frames_Xorshift ( ) & 1 ) << ( Pos % 8 ) ) );
+            Pos++;
+        }
+
+        memcpy ( Previous , Frames_Buffer , sizeof ( Previous ) );
+        Dirty = Matrix_Compose ( Pass , &Pos );
+
+        // Each completed tile from the all fail or all pass frame , none when unknown
+        Counter_Pos = ( Pos <= SENSOR_COUNT ) ? Pos : FRAMES_POS_PAST;
+        Completed   = ( Pos <= SENSOR_COUNT ) ? Pos : 0;
+
+        memcpy ( Wanted , Expected [ 0 ] [ Counter_Pos ] , sizeof ( Wanted ) );
+
+        for ( Counter_Sensor = 0 ; Counter_Sensor < Completed ; Counter_Sensor++ )
+        {
+            for ( Counter_Row = MatrixTile [ Counter_Sensor ].Row ; ( ( Pass [ Counter_Sensor / 8 ] >> ( Counter_Sensor % 8 ) ) & 1 ) && ( Counter_Row < ( MatrixTile [ Counter_Sensor ].Row + TILE_HEIGHT ) ) ; Counter_Row++ )
+            {
+                memcpy ( &Wanted [ Counter_Row ] [ MatrixTile [ Counter_Sensor ].Column ] , &Expected [ 1 ] [ Counter_Pos ] [ Counter_Row ] [ MatrixTile [ Counter_Sensor ].Column ] , TILE_WIDTH * sizeof ( uint32_t ) );
+            }
+        }
+
+        for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+        {
+            // A row that changed has to be one handed to Hub75_Present
+            Same = ( 0 == memcmp ( Frames_Buffer [ Counter_Row ] , Wanted [ Counter_Row ] , sizeof ( Wanted [ 0 ] ) ) ) &&
+                   ( ( Dirty & ( 1u << Counter_Row ) ) || ( 0 == memcmp ( Frames_Buffer [ Counter_Row ] , Previous [ Counter_Row ] , sizeof ( Previous [ 0 ] ) ) ) );
+
+            if ( !Same && ( Failed++ < FRAMES_REPORT_MAX ) )
+            {
+                fprintf ( stderr , "step %u pass 0x%s pos %u : row %u wrong%s\n" , Counter_Step , Frames_Hex ( Pass ) , Pos , Counter_Row ,
+                          ( Dirty & ( 1u << Counter_Row ) ) ? "" : " or not dirty" );
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+    }
+
+    printf ( "sweep      %u states , %u rows wrong\n" , count , Failed );
+
+    return ( 0 == Failed );
+}
+
+static uint32_t Frames_Xorshift ( void )
+{
+    Frames_Random ^= Frames_Random << 13;
+    Frames_Random ^= Frames_Random >> 17;
+    Frames_Random ^= Frames_Random << 5;
+
+    return Frames_Random;
+}
+
+// Binary PPM , 8 bits per channel as composed ( before any HUB75_COLOUR_DEPTH quantizing )
+static bool Frames_Write ( const char *dir , const uint8_t *pass , uint8_t pos )
+{
+    char  Name [ 256 ];
+    FILE *File           = NULL;
+    uint  Counter_Column = 0;
+    uint  Counter_Row    = 0;
+    bool  Written        = false;
+
+    snprintf ( Name , sizeof ( Name ) , "%s/frame_%s_%02u.ppm" , dir , Frames_Hex ( pass ) , pos );
+    File = fopen ( Name , "wb" );
+
+    if ( NULL != File )
+    {
+        fprintf ( File , "P6\n%u %u\n255\n" , MATRIX_WIDTH , MATRIX_HEIGHT );
+
+        for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+        {
+            for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+            {
+                fputc ( ( Frames_Buffer [ Counter_Row ] [ Counter_Column ] >> 16 ) & 0xFF , File );
+                fputc ( ( Frames_Buffer [ Counter_Row ] [ Counter_Column ] >>  8 ) & 0xFF , File );
+                fputc (   Frames_Buffer [ Counter_Row ] [ Counter_Column ]         & 0xFF , File );
+            }
+        }
+
+        Written = ( 0 == fclose ( File ) );
+    }
+    else
+    {
+        perror ( Name );
+    }
+
+    return Written;
+}
+
+/*** end of file ***/
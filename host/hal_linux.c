@@ -0,0 +1,444 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           hal_linux.c                                           *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <host.h>
+#include <check.h>
+#include <trace.h>
+
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct
+{
+    uint64_t            Time;
+    Host_Function_t     Function;   // Plain event , or
+    Hal_TimerCallback_t Timer;      // Hal_TimerStart callback
+    void               *Arg;
+    int32_t             Id;
+    bool                Valid;
+} Host_Event_t;
+
+static Host_Event_t  Host_Events [ HOST_EVENTS_MAX ];
+static int32_t       Host_NextId    = 1;
+static uint64_t      Host_Offset    = 0;             // Virtual time skipped while asleep
+static uint64_t      Host_RunUntil  = 0;
+static uint64_t      Host_Start     = 0;             // Real clock at Hal_Init ( ns )
+static uint64_t      Host_Wake      = UINT64_MAX;    // Hal_WakeAt target
+static uint64_t      Host_Fed       = 0;             // Last Hal_WatchdogFeed
+static FILE         *Host_Telemetry = NULL;          // Hal_HostWrite
+static FILE         *Host_Trace     = NULL;
+
+// GPIO , bit n = pin n
+static Hal_Handler_t Host_Handler [ 32 ];
+static uint32_t      Host_Enabled [ 32 ];   // Edges that interrupt
+static uint32_t      Host_Pending [ 32 ];
+static uint32_t      Host_Level   = 0;
+static uint32_t      Host_Output  = 0;
+
+Host_Stats_t Host_Stats;
+
+static void     Host_Advance  ( uint64_t time );
+static void     Host_Dispatch ( Host_Event_t *event );
+static uint64_t Host_Real     ( void );   // ns
+
+int32_t Host_At ( uint64_t time , Host_Function_t function , void *arg )
+{
+    uint Counter_Event = 0;
+
+    for ( Counter_Event = 0 ; Counter_Event < HOST_EVENTS_MAX ; Counter_Event++ )
+    {
+        if ( !Host_Events [ Counter_Event ].Valid )
+        {
+            Host_Events [ Counter_Event ].Time     = time;
+            Host_Events [ Counter_Event ].Function = function;
+            Host_Events [ Counter_Event ].Timer    = NULL;
+            Host_Events [ Counter_Event ].Arg      = arg;
+            Host_Events [ Counter_Event ].Id       = Host_NextId++;
+            Host_Events [ Counter_Event ].Valid    = true;
+
+            return Host_Events [ Counter_Event ].Id;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    fprintf ( stderr , "host: event table full\n" );
+    exit ( EXIT_FAILURE );
+}
+
+void Host_Cancel ( int32_t id )
+{
+    uint Counter_Event = 0;
+
+    for ( Counter_Event = 0 ; Counter_Event < HOST_EVENTS_MAX ; Counter_Event++ )
+    {
+        if ( Host_Events [ Counter_Event ].Valid && ( id == Host_Events [ Counter_Event ].Id ) )
+        {
+            Host_Events [ Counter_Event ].Valid = false;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+}
+
+// Run every event that has fallen due , in time order
+void Host_Service ( void )
+{
+    Host_Event_t *Next          = NULL;
+    uint64_t      Now           = Hal_Micros64 ( );
+    uint          Counter_Event = 0;
+
+    if ( Now >= Host_RunUntil )
+    {
+        Host_Report ( );
+        Trace_Close ( );
+        exit ( Check_Passed ( ) ? EXIT_SUCCESS : EXIT_FAILURE );
+    }
+    else if ( ( Now - Host_Fed ) > ( WATCHDOG_MILLISECONDS * 1000ull ) )
+    {
+        fprintf ( stderr , "host: watchdog expired at %llu us\n" , ( unsigned long long ) Now );
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    do
+    {
+        Next = NULL;
+
+        for ( Counter_Event = 0 ; Counter_Event < HOST_EVENTS_MAX ; Counter_Event++ )
+        {
+            if ( Host_Events [ Counter_Event ].Valid && ( Host_Events [ Counter_Event ].Time <= Now ) && ( ( NULL == Next ) || ( Host_Events [ Counter_Event ].Time < Next->Time ) ) )
+            {
+                Next = &Host_Events [ Counter_Event ];
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+
+        if ( NULL != Next )
+        {
+            Host_Dispatch ( Next );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    } while ( NULL != Next );
+}
+
+// Drive an input pin , raising its interrupt for an enabled edge
+void Host_SetInput ( uint pin , bool level )
+{
+    uint32_t Edge = 0;
+
+    if ( level != ( 0 != ( ( Host_Level >> pin ) & 1 ) ) )
+    {
+        Host_Level ^= 1u << pin;
+        Edge        = level ? HAL_EDGE_RISE : HAL_EDGE_FALL;
+        Trace_Pin ( Hal_Micros64 ( ) * 1000 , pin , level );
+
+        if ( ( 0 != ( Host_Enabled [ pin ] & Edge ) ) && ( NULL != Host_Handler [ pin ] ) )
+        {
+            Host_Pending [ pin ] |= Edge;
+            Host_Handler [ pin ] ( );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+void Hal_Init ( void )
+{
+    const char *Run       = getenv ( "HOST_RUN_MS"     );
+    const char *Telemetry = getenv ( "HOST_TELEMETRY"  );
+    const char *Trace     = getenv ( "HOST_GPIO_TRACE" );
+
+    Host_Start     = Host_Real ( );
+    Host_RunUntil  = ( ( NULL != Run ) ? strtoull ( Run , NULL , 0 ) : HOST_RUN_MS_DEFAULT ) * 1000ull;
+    Host_Telemetry = ( NULL != Telemetry ) ? fopen ( Telemetry , "wb" ) : NULL;
+    Host_Trace     = ( NULL != Trace     ) ? fopen ( Trace , "w" ) : NULL;
+
+    Trace_Init ( );
+}
+
+// Busy waits take no real time , the clock just moves on
+void Hal_DelayUs ( uint32_t us )
+{
+    Host_Advance ( Hal_Micros64 ( ) + us );
+    Host_Service ( );
+}
+
+uint32_t Hal_ClockHz ( void )
+{
+    return HOST_CLOCK_HZ;
+}
+
+// Virtual time at the target's clock rate , firmware code runs at the host's speed
+uint32_t Hal_Cycles ( void )
+{
+    uint64_t Nanoseconds = Host_Real ( ) - Host_Start + ( Host_Offset * 1000 );
+
+    return ( uint32_t ) ( ( Nanoseconds * ( HOST_CLOCK_HZ / 1000000 ) ) / 1000 ) & HAL_CYCLES_MASK;
+}
+
+void Hal_CyclesStart ( void )
+{
+    // Nothing to do
+}
+
+uint32_t Hal_Micros ( void )
+{
+    return ( uint32_t ) Hal_Micros64 ( );
+}
+
+uint64_t Hal_Micros64 ( void )
+{
+    return ( ( Host_Real ( ) - Host_Start ) / 1000 ) + Host_Offset;
+}
+
+// Connected when HOST_TELEMETRY names a file to write to
+bool Hal_HostConnected ( void )
+{
+    return ( NULL != Host_Telemetry );
+}
+
+void Hal_HostWrite ( const uint8_t *data , uint32_t length )
+{
+    if ( NULL != Host_Telemetry )
+    {
+        fwrite ( data , 1 , length , Host_Telemetry );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+uint32_t Hal_GpioEvents ( uint pin )
+{
+    uint32_t Events = Host_Pending [ pin ];
+
+    Host_Pending [ pin ] = 0;
+
+    return Events;
+}
+
+bool Hal_GpioGet ( uint pin )
+{
+    return ( Host_Level >> pin ) & 1;
+}
+
+void Hal_GpioInput ( uint pin , bool pull_down )
+{
+    Host_Output &= ~( 1u << pin );
+}
+
+void Hal_GpioIrq ( uint32_t pins , uint32_t edges , Hal_Handler_t handler )
+{
+    uint Counter_Pin = 0;
+
+    for ( Counter_Pin = 0 ; Counter_Pin < 32 ; Counter_Pin++ )
+    {
+        if ( ( pins >> Counter_Pin ) & 1 )
+        {
+            Host_Enabled [ Counter_Pin ] = edges;
+            Host_Handler [ Counter_Pin ] = handler;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+}
+
+void Hal_GpioOutput ( uint pin )
+{
+    Host_Output |= 1u << pin;
+}
+
+// Output edges are counted and optionally written to HOST_GPIO_TRACE
+void Hal_GpioPut ( uint pin , bool level )
+{
+    if ( level != ( 0 != ( ( Host_Level >> pin ) & 1 ) ) )
+    {
+        Host_Level ^= 1u << pin;
+        Host_Stats.Edges++;
+        Trace_Pin ( Hal_Micros64 ( ) * 1000 , pin , level );
+
+        if ( NULL != Host_Trace )
+        {
+            fprintf ( Host_Trace , "%llu %u %u\n" , ( unsigned long long ) Hal_Micros64 ( ) , pin , level ? 1u : 0u );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Single threaded , events only run from the dispatch points
+void Hal_Barrier ( void )
+{
+    // Nothing to do
+}
+
+uint32_t Hal_IrqDisable ( void )
+{
+    return 0;
+}
+
+void Hal_IrqRestore ( uint32_t state )
+{
+    // Nothing to do
+}
+
+void Hal_TimerCancel ( int32_t id )
+{
+    Host_Cancel ( id );
+}
+
+int32_t Hal_TimerStart ( uint32_t delay_us , Hal_TimerCallback_t callback , void *user_data )
+{
+    int32_t Id            = Host_At ( Hal_Micros64 ( ) + delay_us , NULL , user_data );
+    uint    Counter_Event = 0;
+
+    for ( Counter_Event = 0 ; Counter_Event < HOST_EVENTS_MAX ; Counter_Event++ )
+    {
+        if ( Host_Events [ Counter_Event ].Valid && ( Id == Host_Events [ Counter_Event ].Id ) )
+        {
+            Host_Events [ Counter_Event ].Timer = callback;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Id;
+}
+
+// Skip to the earlier of the wake alarm and the next event
+void Hal_Sleep ( void )
+{
+    uint64_t Next          = Host_Wake;
+    uint     Counter_Event = 0;
+
+    for ( Counter_Event = 0 ; Counter_Event < HOST_EVENTS_MAX ; Counter_Event++ )
+    {
+        if ( Host_Events [ Counter_Event ].Valid && ( Host_Events [ Counter_Event ].Time < Next ) )
+        {
+            Next = Host_Events [ Counter_Event ].Time;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    if ( UINT64_MAX == Next )
+    {
+        fprintf ( stderr , "host: asleep with nothing to wake it\n" );
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Host_Stats.Sleeps++;
+    Host_Advance ( ( Next < Host_RunUntil ) ? Next : Host_RunUntil );
+    Host_Wake = ( Hal_Micros64 ( ) >= Host_Wake ) ? UINT64_MAX : Host_Wake;
+    Host_Service ( );
+}
+
+bool Hal_WakeAt ( uint64_t time )
+{
+    bool Armed = ( time > Hal_Micros64 ( ) );
+
+    Host_Wake = Armed ? time : UINT64_MAX;
+
+    return Armed;
+}
+
+void Hal_WatchdogFeed ( void )
+{
+    Host_Fed = Hal_Micros64 ( );
+}
+
+static void Host_Advance ( uint64_t time )
+{
+    uint64_t Now = Hal_Micros64 ( );
+
+    Host_Offset += ( time > Now ) ? ( time - Now ) : 0;
+}
+
+// Timers that return a positive delay stay in the table
+static void Host_Dispatch ( Host_Event_t *event )
+{
+    int64_t Again = 0;
+
+    Host_Stats.Events++;
+
+    if ( NULL != event->Timer )
+    {
+        Again = event->Timer ( event->Id , event->Arg );
+
+        if ( 0 < Again )
+        {
+            event->Time += ( uint64_t ) Again;
+        }
+        else
+        {
+            event->Valid = false;
+        }
+    }
+    else
+    {
+        event->Valid = false;
+        event->Function ( event->Arg );
+    }
+}
+
+static uint64_t Host_Real ( void )
+{
+    struct timespec Now;
+
+    clock_gettime ( CLOCK_MONOTONIC , &Now );
+
+    return ( ( uint64_t ) Now.tv_sec * 1000000000ull ) + ( uint64_t ) Now.tv_nsec;
+}
+
+/*** end of file ***/
@@ -0,0 +1,74 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           host.h                                                *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __HOST_H
+#define __HOST_H
+
+#include <main.h>
+
+// Linux backend of the HAL. Time is virtual : it runs at the real rate
+// while firmware code executes and jumps straight to the next event when
+// the firmware sleeps , so a run of minutes finishes in well under a second.
+// Interrupts are events on that clock , dispatched from Hal_Sleep ,
+// Hal_DelayUs and SPI_Poll.
+//
+// Environment :
+//   HOST_RUN_MS      Virtual run time , default HOST_RUN_MS_DEFAULT
+//   HOST_GPIO_TRACE  File to write output pin edges to , "time_us pin level" per line
+//   HOST_SCRIPT      Test bed script , see testbed.c
+//   HOST_SPI_MAX     Fastest clean SPI clock ( Hz ) , default TESTBED_BAUD_MAX
+//   HOST_LEGACY      1 for a test bed that only speaks the original exchange
+//   HOST_MUTE        Test bed that goes silent , the run fails unless its tiles show unknown
+//   HOST_BUTTONS     Press or release all the switches together every this many ms
+//   HOST_TELEMETRY   File to write the USB telemetry stream to , see telemetry.h
+//   HOST_VCD ...     Signal trace and timing checks , see trace.h
+//   HOST_BENCH       1 to print only the Bench_Report line at the end of the run
+#define HOST_CLOCK_HZ           125000000   // Hal_Cycles rate , the target's clk_sys
+#define HOST_EVENTS_MAX         64
+#define HOST_RUN_MS_DEFAULT     10000
+
+typedef void ( *Host_Function_t ) ( void *arg );
+
+typedef struct
+{
+    uint32_t Edges;         // Output pin changes
+    uint32_t Events;        // Events dispatched
+    uint32_t Sleeps;
+} Host_Stats_t;
+
+extern Host_Stats_t Host_Stats;
+
+// Events
+int32_t  Host_At        ( uint64_t time , Host_Function_t function , void *arg );
+void     Host_Cancel    ( int32_t id );
+void     Host_Service   ( void );
+
+// Test bed side of the GPIO
+void     Host_SetInput  ( uint pin , bool level );
+
+// Display backend
+uint8_t  Hub75_Host_Brightness ( void );   // As being scanned
+uint32_t Hub75_Host_Frames     ( void );
+uint32_t Hub75_Host_Pixel      ( uint row , uint column );   // As shown on the panel
+
+// Run summary , printed when HOST_RUN_MS is reached
+void     Host_Report    ( void );
+
+#endif /* __HOST_H */
+
+/*** end of file ***/
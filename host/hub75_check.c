@@ -0,0 +1,813 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           hub75_check.c                                         *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <hub75.h>
+#include <bench.h>
+#include <gamma.h>
+
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hardware/clocks.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/pio.h>
+#include <hardware/sync.h>
+#include <pico/multicore.h>
+#include <pio_sim.h>
+
+// Refresh engine cases against src/hub75.c , built with the stand-ins in
+// host/sdk. Hub75_Init runs core 1 up to its idle loop , the DMA channel
+// setup is recorded and a frame boundary is the captured interrupt handler.
+//   hub75_check packing    Every pixel of both halves written through
+//                          Hub75_SetPixel and read back through
+//                          Hub75_GetPixel , and the frame the data channel
+//                          feeds hub75_data decoded and compared with the
+//                          row-major bit-planes the panel used before
+//                          scan order packing
+//   hub75_check pio        src/hub75.pio as assembled for the build , run in
+//                          pio_sim.c on the words the DMA channels feed it ,
+//                          driving a model panel. Each output on pulse is
+//                          checked for its line , its latched columns and its
+//                          plane's binary weight , then a frame of full on
+//                          and off colours is drawn by the original
+//                          Matrix_Draw and by the engine and the pixels each
+//                          lights compared. Last a frame at brightness 0 ,
+//                          which must leave the output off throughout
+// Exits non-zero on any failure.
+#define CHECK_CLOCK_HZ          125000000
+#define CHECK_PASSES            2       // Whole panel , then overwritten in a random order
+
+#define CHECK_RED_TOP           ( 1u << ( LED_R1_PIN - HUB75_RGB_BASE_PIN ) )
+#define CHECK_GREEN_TOP         ( 1u << ( LED_G1_PIN - HUB75_RGB_BASE_PIN ) )
+#define CHECK_BLUE_TOP          ( 1u << ( LED_B1_PIN - HUB75_RGB_BASE_PIN ) )
+#define CHECK_RED_BOTTOM        ( 1u << ( LED_R2_PIN - HUB75_RGB_BASE_PIN ) )
+#define CHECK_GREEN_BOTTOM      ( 1u << ( LED_G2_PIN - HUB75_RGB_BASE_PIN ) )
+#define CHECK_BLUE_BOTTOM       ( 1u << ( LED_B2_PIN - HUB75_RGB_BASE_PIN ) )
+#define CHECK_TOP               ( CHECK_RED_TOP    | CHECK_GREEN_TOP    | CHECK_BLUE_TOP    )
+#define CHECK_BOTTOM            ( CHECK_RED_BOTTOM | CHECK_GREEN_BOTTOM | CHECK_BLUE_BOTTOM )
+
+#define CHECK_SM_ROW            0       // Claimed in this order by Hub75_Core1
+#define CHECK_SM_DATA           1
+
+// Output on pulses in a frame , one per line and plane from the engine and
+// one per row from the original Matrix_Draw
+#define CHECK_PULSES_MAX        ( ( HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH ) + MATRIX_HEIGHT )
+#define CHECK_CHANNELS          3       // Red , green , blue
+
+// The original Matrix_Draw's MatrixData , colour bits over the MatrixRow
+// address bits with rows 16 to 31 on the bottom half pins
+#define LED_BLUE_TOP            0b0000000000010000
+#define LED_BLUE_BOTTOM         0b0000000010000000
+#define LED_GREEN_TOP           0b0000000000100000
+#define LED_GREEN_BOTTOM        0b0000000100000000
+#define LED_RED_TOP             0b0000000001000000
+#define LED_RED_BOTTOM          0b0000001000000000
+
+typedef struct
+{
+    uint8_t  Address;                   // MatrixRow bits decoded from the address pins
+    uint8_t  Data [ MATRIX_WIDTH ];     // Columns latched , colour pins from HUB75_RGB_BASE_PIN
+    uint64_t Duration;                  // Output on , in the trace's time units
+} Check_Pulse_t;
+
+// HUB75 panel as its pins drive it : a shift register clocked on the CLK
+// rising edge , copied to the outputs as LAT falls and shown on the
+// addressed line while OE is low. Column 0 is clocked in first , as the
+// original Matrix_Draw sends it.
+typedef struct
+{
+    Check_Pulse_t Pulses [ CHECK_PULSES_MAX ];
+    uint          Count;
+    uint8_t       Latched [ MATRIX_WIDTH ];
+    uint8_t       Shift   [ MATRIX_WIDTH ];
+    uint32_t      Gpio;
+    uint64_t      Since;                // Start of the pulse being timed
+} Check_Panel_t;
+
+typedef struct
+{
+    volatile void       *Write;
+    const volatile void *Read;
+    uint                 Count;
+} Check_Channel_t;
+
+static Check_Channel_t Check_Channels [ DMA_CHANNELS ];
+static Check_Panel_t   Check_Engine;
+static Check_Panel_t   Check_Original;
+static uint32_t        Check_Colours     [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];
+static uint64_t        Check_LitEngine   [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ] [ CHECK_CHANNELS ];
+static uint64_t        Check_LitOriginal [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ] [ CHECK_CHANNELS ];
+static uint8_t         Check_Old         [ MATRIX_HEIGHT ] [ HUB75_COLOUR_DEPTH ] [ MATRIX_WIDTH ];   // Before scan order
+static irq_handler_t   Check_Frame    = NULL;
+static uint            Check_DMA      = 0;      // Channels claimed
+static uint64_t        Check_Time     = 0;      // Original Matrix_Draw's virtual us
+static uint32_t        Check_Random   = 0x2545F491;
+static uint32_t        Check_Failed   = 0;
+static jmp_buf         Check_Core1;
+
+static dma_hw_t        Check_DMA_hw;
+
+dma_hw_t              *dma_hw = &Check_DMA_hw;
+
+extern const uint16_t  MatrixRow [ ];           // matrix_default.h , built into hub75.c
+
+// The original Matrix_Draw and its frame , from src/main.c before the PIO
+// engine replaced it
+static const uint64_t  MATRIX_DELAY_REFRESH = 450;  // microseconds
+static uint16_t        MatrixData [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];
+
+static void            gpio_put          ( uint gpio , bool value );
+static void            sleep_us          ( uint64_t us );
+
+static uint32_t        Check_Correct     ( uint32_t colour );
+static void            Check_Fill        ( void );
+static uint32_t        Check_Lit         ( const Check_Panel_t *panel , uint64_t lit [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ] [ CHECK_CHANNELS ] , const char *name );
+static void            Check_MatrixDraw  ( void );
+static uint32_t        Check_Next        ( void );
+static void            Check_OldSet      ( uint row , uint column , uint32_t colour );
+static void            Check_Packing     ( void );
+static void            Check_Panel       ( Check_Panel_t *panel , uint32_t gpio , uint64_t time );
+static void            Check_PIO         ( void );
+static uint32_t        Check_Planes      ( const uint32_t *lines );
+static const uint32_t *Check_Run         ( void );
+static const uint32_t *Check_Words       ( uint sm , uint *count );
+
+int main ( int argc , char **argv )
+{
+    if ( ( 2 == argc ) && ( 0 == strcmp ( argv [ 1 ] , "packing" ) ) )
+    {
+        Check_Packing ( );
+    }
+    else if ( ( 2 == argc ) && ( 0 == strcmp ( argv [ 1 ] , "pio" ) ) )
+    {
+        Check_PIO ( );
+    }
+    else
+    {
+        fprintf ( stderr , "usage: hub75_check packing | pio\n" );
+        Check_Failed++;
+    }
+
+    return ( 0 == Check_Failed ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Colour as the panel shows it , the gamma corrected level of each channel
+// in its HUB75_COLOUR_DEPTH most significant bits
+static uint32_t Check_Correct ( uint32_t colour )
+{
+    return ( GAMMA_LEVEL ( colour >> 16 , ( 1u << HUB75_COLOUR_DEPTH ) - 1 ) << ( 24 - HUB75_COLOUR_DEPTH ) )
+         | ( GAMMA_LEVEL ( colour >>  8 , ( 1u << HUB75_COLOUR_DEPTH ) - 1 ) << ( 16 - HUB75_COLOUR_DEPTH ) )
+         | ( GAMMA_LEVEL ( colour       , ( 1u << HUB75_COLOUR_DEPTH ) - 1 ) << (  8 - HUB75_COLOUR_DEPTH ) );
+}
+
+// Next value of a xorshift generator
+static uint32_t Check_Next ( void )
+{
+    Check_Random ^= Check_Random << 13;
+    Check_Random ^= Check_Random >> 17;
+    Check_Random ^= Check_Random << 5;
+
+    return Check_Random;
+}
+
+// The old Hub75_SetPixel : one line per row , top half rows on R1 G1 B1 and
+// bottom half rows on R2 G2 B2 , plane n from bit n of the corrected level
+static void Check_OldSet ( uint row , uint column , uint32_t colour )
+{
+    uint8_t Blue          = ( row < HUB75_SCAN_LINES ) ? CHECK_BLUE_TOP  : CHECK_BLUE_BOTTOM;
+    uint8_t Green         = ( row < HUB75_SCAN_LINES ) ? CHECK_GREEN_TOP : CHECK_GREEN_BOTTOM;
+    uint8_t Red           = ( row < HUB75_SCAN_LINES ) ? CHECK_RED_TOP   : CHECK_RED_BOTTOM;
+    uint8_t Pixel         = 0;
+    uint    Counter_Plane = 0;
+    uint    Shift         = 0;
+
+    for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+    {
+        Shift  = 8 - HUB75_COLOUR_DEPTH + Counter_Plane;
+        Pixel  = Check_Old [ row ] [ Counter_Plane ] [ column ] & ( uint8_t ) ~( Red | Green | Blue );
+        Pixel |= ( ( colour >> ( 16 + Shift ) ) & 1 ) ? Red   : 0;
+        Pixel |= ( ( colour >> (  8 + Shift ) ) & 1 ) ? Green : 0;
+        Pixel |= ( ( colour >>        Shift   ) & 1 ) ? Blue  : 0;
+
+        Check_Old [ row ] [ Counter_Plane ] [ column ] = Pixel;
+    }
+}
+
+// Row by row , then every pixel again in a random order so each write
+// lands next to a line already holding the other half. The old encoding is
+// kept alongside in Check_Old and the colours shown in Check_Colours.
+static void Check_Fill ( void )
+{
+    uint32_t Colour         = 0;
+    uint     Row            = 0;
+    uint     Counter_Column = 0;
+    uint     Counter_Pass   = 0;
+    uint     Counter_Pixel  = 0;
+
+    for ( Counter_Pass = 0 ; Counter_Pass < CHECK_PASSES ; Counter_Pass++ )
+    {
+        for ( Counter_Pixel = 0 ; Counter_Pixel < ( MATRIX_HEIGHT * MATRIX_WIDTH ) ; Counter_Pixel++ )
+        {
+            Row            = ( 0 == Counter_Pass ) ? ( Counter_Pixel / MATRIX_WIDTH ) : ( Check_Next ( ) % MATRIX_HEIGHT );
+            Counter_Column = ( 0 == Counter_Pass ) ? ( Counter_Pixel % MATRIX_WIDTH ) : ( Check_Next ( ) % MATRIX_WIDTH  );
+            Colour         = Check_Next ( ) & 0xFFFFFF;
+
+            Hub75_SetPixel ( Row , Counter_Column , Colour );
+            Check_OldSet   ( Row , Counter_Column , Check_Correct ( Colour ) );
+            Check_Colours [ Row ] [ Counter_Column ] = Check_Correct ( Colour );
+        }
+    }
+}
+
+static void Check_Packing ( void )
+{
+    const uint32_t *Words          = NULL;
+    uint32_t        Mismatched     = 0;
+    uint8_t         Column         = 0;
+    uint8_t         Expected       = 0;
+    uint            Count          = 0;
+    uint            Counter_Column = 0;
+    uint            Counter_Line   = 0;
+    uint            Counter_Plane  = 0;
+    uint            Counter_Row    = 0;
+
+    Hub75_Init ( );
+    Check_Fill ( );
+
+    for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+    {
+        for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+        {
+            if ( Hub75_GetPixel ( Counter_Row , Counter_Column ) != Check_Colours [ Counter_Row ] [ Counter_Column ] )
+            {
+                fprintf ( stderr , "packing: pixel %u , %u reads %06X , set %06X\n" , Counter_Row , Counter_Column ,
+                          Hub75_GetPixel ( Counter_Row , Counter_Column ) , Check_Colours [ Counter_Row ] [ Counter_Column ] );
+                Mismatched++;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+    }
+
+    // Shown from the next frame boundary , then read as the data channel does
+    Hub75_Present ( 0xFFFFFFFF );
+    Check_Frame   ( );
+    Words = Check_Words ( CHECK_SM_DATA , &Count );
+
+    if ( Count != ( HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH * HUB75_WORDS_PER_LINE ) )
+    {
+        fprintf ( stderr , "packing: data channel moves %u words a frame\n" , Count );
+        Check_Failed++;
+    }
+    else
+    {
+        for ( Counter_Line = 0 ; Counter_Line < HUB75_SCAN_LINES ; Counter_Line++ )
+        {
+            for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+            {
+                for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+                {
+                    // Four columns a word , the first in the low byte as out shifts right
+                    Column   = ( uint8_t ) ( Words [ ( ( ( Counter_Line * HUB75_COLOUR_DEPTH ) + Counter_Plane ) * HUB75_WORDS_PER_LINE ) + ( Counter_Column / 4 ) ] >> ( 8 * ( Counter_Column % 4 ) ) );
+                    Expected = ( Check_Old [ Counter_Line                    ] [ Counter_Plane ] [ Counter_Column ] & CHECK_TOP    )
+                             | ( Check_Old [ Counter_Line + HUB75_SCAN_LINES ] [ Counter_Plane ] [ Counter_Column ] & CHECK_BOTTOM );
+
+                    if ( Column != Expected )
+                    {
+                        fprintf ( stderr , "packing: line %u plane %u column %u is %02X , rows %u and %u were %02X\n" , Counter_Line , Counter_Plane ,
+                                  Counter_Column , Column , Counter_Line , Counter_Line + HUB75_SCAN_LINES , Expected );
+                        Mismatched++;
+                    }
+                    else
+                    {
+                        // Nothing to do
+                    }
+                }
+            }
+        }
+    }
+
+    printf ( "packing    %u x %u pixels , %u planes , %u mismatched\n" , MATRIX_WIDTH , MATRIX_HEIGHT , HUB75_COLOUR_DEPTH , Mismatched );
+    Check_Failed += Mismatched;
+}
+
+// Verbatim from src/main.c before the PIO engine , on the stand-ins below.
+// 32 rows of one bit colour , each half drawn on its own pass.
+static void Check_MatrixDraw ( void )
+{
+    volatile uint8_t Counter_Column = 0;
+    volatile uint8_t Counter_Row    = 0;
+
+    for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+    {
+        MATRIX_OUTPUT_OFF;
+        MATRIX_LAT_HIGH;
+
+        for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+        {
+            gpio_put ( LED_R1_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_RED_TOP      ) );
+            gpio_put ( LED_G1_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_GREEN_TOP    ) );
+            gpio_put ( LED_B1_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_BLUE_TOP     ) );
+            gpio_put ( LED_R2_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_RED_BOTTOM   ) );
+            gpio_put ( LED_G2_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_GREEN_BOTTOM ) );
+            gpio_put ( LED_B2_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_BLUE_BOTTOM  ) );
+
+            gpio_put ( BIT_D_PIN  , ( MatrixData [ Counter_Row ] [ Counter_Column ] & BIT_D_MASK ) );
+            gpio_put ( BIT_C_PIN  , ( MatrixData [ Counter_Row ] [ Counter_Column ] & BIT_C_MASK ) );
+            gpio_put ( BIT_B_PIN  , ( MatrixData [ Counter_Row ] [ Counter_Column ] & BIT_B_MASK ) );
+            gpio_put ( BIT_A_PIN  , ( MatrixData [ Counter_Row ] [ Counter_Column ] & BIT_A_MASK ) );
+
+            MATRIX_CLK_HIGH;
+            sleep_us ( 1 );
+            MATRIX_CLK_LOW;
+        }
+
+        MATRIX_LAT_LOW;
+        MATRIX_OUTPUT_ON;
+        sleep_us ( MATRIX_DELAY_REFRESH );
+    }
+}
+
+// Per pixel and channel , how long each was lit over a frame. Every lit
+// channel must have been lit for the same time , the frame being full on
+// or off colours. Returns the mismatches.
+static uint32_t Check_Lit ( const Check_Panel_t *panel , uint64_t lit [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ] [ CHECK_CHANNELS ] , const char *name )
+{
+    static const uint8_t Top    [ CHECK_CHANNELS ] = { CHECK_RED_TOP    , CHECK_GREEN_TOP    , CHECK_BLUE_TOP    };
+    static const uint8_t Bottom [ CHECK_CHANNELS ] = { CHECK_RED_BOTTOM , CHECK_GREEN_BOTTOM , CHECK_BLUE_BOTTOM };
+    const Check_Pulse_t *Pulse           = NULL;
+    uint64_t             Time            = 0;
+    uint32_t             Mismatched      = 0;
+    uint                 Counter_Channel = 0;
+    uint                 Counter_Column  = 0;
+    uint                 Counter_Pulse   = 0;
+    uint                 Counter_Row     = 0;
+
+    memset ( lit , 0 , sizeof ( uint64_t ) * MATRIX_HEIGHT * MATRIX_WIDTH * CHECK_CHANNELS );
+
+    for ( Counter_Pulse = 0 ; Counter_Pulse < panel->Count ; Counter_Pulse++ )
+    {
+        Pulse = &panel->Pulses [ Counter_Pulse ];
+
+        for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+        {
+            for ( Counter_Channel = 0 ; Counter_Channel < CHECK_CHANNELS ; Counter_Channel++ )
+            {
+                lit [ Pulse->Address                    ] [ Counter_Column ] [ Counter_Channel ] += ( Pulse->Data [ Counter_Column ] & Top    [ Counter_Channel ] ) ? Pulse->Duration : 0;
+                lit [ Pulse->Address + HUB75_SCAN_LINES ] [ Counter_Column ] [ Counter_Channel ] += ( Pulse->Data [ Counter_Column ] & Bottom [ Counter_Channel ] ) ? Pulse->Duration : 0;
+            }
+        }
+    }
+
+    for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+    {
+        for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+        {
+            for ( Counter_Channel = 0 ; Counter_Channel < CHECK_CHANNELS ; Counter_Channel++ )
+            {
+                Time = ( 0 == Time ) ? lit [ Counter_Row ] [ Counter_Column ] [ Counter_Channel ] : Time;
+
+                if ( ( 0 != lit [ Counter_Row ] [ Counter_Column ] [ Counter_Channel ] ) && ( Time != lit [ Counter_Row ] [ Counter_Column ] [ Counter_Channel ] ) )
+                {
+                    fprintf ( stderr , "pio: %s lights pixel %u , %u channel %u for %llu , others for %llu\n" , name , Counter_Row , Counter_Column ,
+                              Counter_Channel , ( unsigned long long ) lit [ Counter_Row ] [ Counter_Column ] [ Counter_Channel ] , ( unsigned long long ) Time );
+                    Mismatched++;
+                }
+                else
+                {
+                    // Nothing to do
+                }
+            }
+        }
+    }
+
+    return Mismatched;
+}
+
+// Panel pins at a given time. A pulse ends as OE goes high , or as the
+// address or the latched columns change under it , and a new one starts if
+// the output is still on.
+static void Check_Panel ( Check_Panel_t *panel , uint32_t gpio , uint64_t time )
+{
+    Check_Pulse_t *Pulse   = NULL;
+    uint8_t        Address = ( ( gpio & ( 1u << BIT_A_PIN ) ) ? BIT_A_MASK : 0 ) | ( ( gpio & ( 1u << BIT_B_PIN ) ) ? BIT_B_MASK : 0 )
+                           | ( ( gpio & ( 1u << BIT_C_PIN ) ) ? BIT_C_MASK : 0 ) | ( ( gpio & ( 1u << BIT_D_PIN ) ) ? BIT_D_MASK : 0 );
+    bool           Latch   = ( panel->Gpio & HUB75_LAT_MASK ) && !( gpio & HUB75_LAT_MASK );
+    bool           Was     = !( panel->Gpio & HUB75_OE_MASK ) && ( panel->Count > 0 );
+    bool           On      = !( gpio & HUB75_OE_MASK );
+    bool           Ended   = Was && ( !On || Latch || ( Address != panel->Pulses [ panel->Count - 1 ].Address ) );
+
+    if ( ( gpio & HUB75_CLK_MASK ) && !( panel->Gpio & HUB75_CLK_MASK ) )
+    {
+        memmove ( panel->Shift , panel->Shift + 1 , MATRIX_WIDTH - 1 );
+        panel->Shift [ MATRIX_WIDTH - 1 ] = ( uint8_t ) ( ( gpio & HUB75_RGB_MASK ) >> HUB75_RGB_BASE_PIN );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( Latch )
+    {
+        memcpy ( panel->Latched , panel->Shift , MATRIX_WIDTH );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( Ended )
+    {
+        panel->Pulses [ panel->Count - 1 ].Duration = time - panel->Since;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( On && ( Ended || !Was ) && ( panel->Count < CHECK_PULSES_MAX ) )
+    {
+        Pulse          = &panel->Pulses [ panel->Count++ ];
+        Pulse->Address = Address;
+        memcpy ( Pulse->Data , panel->Latched , MATRIX_WIDTH );
+        panel->Since   = time;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    panel->Gpio = gpio;
+}
+
+// Each line and plane lit once in scan order , on the address MatrixRow
+// gives the line , with both halves' columns as Check_Old has them and for
+// the on time its line word asks for. Plane n's on time is 2^n times plane
+// 0's , to the rounding of each. Returns the mismatches.
+static uint32_t Check_Planes ( const uint32_t *lines )
+{
+    const Check_Pulse_t *Pulse          = NULL;
+    uint64_t             Base           = 0;
+    uint64_t             On             = 0;
+    uint32_t             Mismatched     = 0;
+    uint8_t              Expected       = 0;
+    uint                 Counter_Column = 0;
+    uint                 Counter_Pulse  = 0;
+    uint                 Line           = 0;
+    uint                 Plane          = 0;
+
+    if ( Check_Engine.Count != ( HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH ) )
+    {
+        fprintf ( stderr , "pio: %u output on pulses a frame\n" , Check_Engine.Count );
+        Mismatched++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    for ( Counter_Pulse = 0 ; ( Counter_Pulse < Check_Engine.Count ) && ( 0 == Mismatched ) ; Counter_Pulse++ )
+    {
+        Pulse = &Check_Engine.Pulses [ Counter_Pulse ];
+        Line  = Counter_Pulse / HUB75_COLOUR_DEPTH;
+        Plane = Counter_Pulse % HUB75_COLOUR_DEPTH;
+        On    = ( ( lines [ Counter_Pulse ] >> 6 ) & ( HUB75_DWELL_FIELD - 1 ) ) * HUB75_DWELL_UNIT;
+        Base  = ( 0 == Plane ) ? Pulse->Duration : Base;
+
+        if ( ( Pulse->Address != MatrixRow [ Line ] ) || ( Pulse->Duration != On )
+          || ( ( Pulse->Duration + ( 2u << Plane ) * HUB75_DWELL_UNIT ) < ( Base << Plane ) ) || ( Pulse->Duration > ( ( Base << Plane ) + ( 2u << Plane ) * HUB75_DWELL_UNIT ) ) )
+        {
+            fprintf ( stderr , "pio: line %u plane %u lit on address %u for %llu cycles , line word asks %llu , plane 0 had %llu\n" , Line , Plane ,
+                      Pulse->Address , ( unsigned long long ) Pulse->Duration , ( unsigned long long ) On , ( unsigned long long ) Base );
+            Mismatched++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+        {
+            Expected = ( Check_Old [ Line                    ] [ Plane ] [ Counter_Column ] & CHECK_TOP    )
+                     | ( Check_Old [ Line + HUB75_SCAN_LINES ] [ Plane ] [ Counter_Column ] & CHECK_BOTTOM );
+
+            if ( Pulse->Data [ Counter_Column ] != Expected )
+            {
+                fprintf ( stderr , "pio: line %u plane %u column %u latched %02X , rows %u and %u were %02X\n" , Line , Plane , Counter_Column ,
+                          Pulse->Data [ Counter_Column ] , Line , Line + HUB75_SCAN_LINES , Expected );
+                Mismatched++;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+    }
+
+    return Mismatched;
+}
+
+// Both cases , random colours against the bit-planes and then a frame of
+// full on and off colours against the original Matrix_Draw. The original
+// drives 32 half lit rows of one bit colour and the engine 16 lines of
+// both halves per plane , so the two are compared by the pixels they light
+// rather than edge for edge.
+static void Check_PIO ( void )
+{
+    const uint32_t *Lines           = NULL;
+    uint32_t        Colour          = 0;
+    uint32_t        Mismatched      = 0;
+    uint            Counter_Channel = 0;
+    uint            Counter_Column  = 0;
+    uint            Counter_Row     = 0;
+    bool            Lit             = false;
+
+    // Both panels start from the pins as Hub75_Core1 leaves them , output off
+    Hub75_Init ( );
+    Check_Fill ( );
+    Check_Engine.Gpio   = Sim_Pins ( );
+    Check_Original.Gpio = HUB75_OE_MASK;
+
+    Lines       = Check_Run    ( );
+    Mismatched += Check_Planes ( Lines );
+
+    printf ( "pio        %u x %u pixels , %u planes , %u pulses , %u mismatched\n" , MATRIX_WIDTH , MATRIX_HEIGHT , HUB75_COLOUR_DEPTH , Check_Engine.Count , Mismatched );
+    Check_Failed += Mismatched;
+    Mismatched    = 0;
+
+    for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+    {
+        for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+        {
+            Colour = ( Check_Next ( ) & 0x010101 ) * 0xFF;
+
+            Hub75_SetPixel ( Counter_Row , Counter_Column , Colour );
+            Check_Colours [ Counter_Row ] [ Counter_Column ] = Colour;
+            MatrixData    [ Counter_Row ] [ Counter_Column ] = MatrixRow [ Counter_Row ]
+                          | ( ( Colour & 0xFF0000 ) ? ( ( Counter_Row < HUB75_SCAN_LINES ) ? LED_RED_TOP   : LED_RED_BOTTOM   ) : 0 )
+                          | ( ( Colour & 0x00FF00 ) ? ( ( Counter_Row < HUB75_SCAN_LINES ) ? LED_GREEN_TOP : LED_GREEN_BOTTOM ) : 0 )
+                          | ( ( Colour & 0x0000FF ) ? ( ( Counter_Row < HUB75_SCAN_LINES ) ? LED_BLUE_TOP  : LED_BLUE_BOTTOM  ) : 0 );
+        }
+    }
+
+    // The original ends with the last row lit , turned off as the next frame starts
+    Check_Run        ( );
+    Check_MatrixDraw ( );
+    MATRIX_OUTPUT_OFF;
+
+    Mismatched += Check_Lit ( &Check_Engine   , Check_LitEngine   , "engine"   );
+    Mismatched += Check_Lit ( &Check_Original , Check_LitOriginal , "original" );
+
+    for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+    {
+        for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+        {
+            for ( Counter_Channel = 0 ; Counter_Channel < CHECK_CHANNELS ; Counter_Channel++ )
+            {
+                Lit = ( ( Check_Colours [ Counter_Row ] [ Counter_Column ] >> ( 16 - ( 8 * Counter_Channel ) ) ) & 0xFF ) ? true : false;
+
+                if ( ( Lit != ( 0 != Check_LitEngine [ Counter_Row ] [ Counter_Column ] [ Counter_Channel ] ) )
+                  || ( Lit != ( 0 != Check_LitOriginal [ Counter_Row ] [ Counter_Column ] [ Counter_Channel ] ) ) )
+                {
+                    fprintf ( stderr , "pio: pixel %u , %u channel %u is %s , engine lights it %s , original %s\n" , Counter_Row , Counter_Column , Counter_Channel ,
+                              Lit ? "on" : "off" , Check_LitEngine [ Counter_Row ] [ Counter_Column ] [ Counter_Channel ] ? "on" : "off" ,
+                              Check_LitOriginal [ Counter_Row ] [ Counter_Column ] [ Counter_Channel ] ? "on" : "off" );
+                    Mismatched++;
+                }
+                else
+                {
+                    // Nothing to do
+                }
+            }
+        }
+    }
+
+    printf ( "original   %u x %u pixels , %u pulses bit-banged , %u from the engine , %u mismatched\n" , MATRIX_WIDTH , MATRIX_HEIGHT ,
+             Check_Original.Count , Check_Engine.Count , Mismatched );
+    Check_Failed += Mismatched;
+
+    // Brightness 0 , the output stays off through the whole frame
+    Hub75_SetBrightness ( 0 );
+    Check_Run ( );
+
+    printf ( "dark       %u pulses at brightness 0\n" , Check_Engine.Count );
+    Check_Failed += Check_Engine.Count + Sim_Faults ( );
+}
+
+// Present the back buffer , then run both state machines on the words
+// their channels feed them until the frame is drawn. Returns the line words.
+static const uint32_t *Check_Run ( void )
+{
+    const uint32_t *Lines = NULL;
+    const uint32_t *Words = NULL;
+    uint            Count = 0;
+
+    Hub75_Present ( 0xFFFFFFFF );
+    Check_Frame   ( );
+
+    Lines = Check_Words ( CHECK_SM_ROW  , &Count );
+    Sim_Feed ( CHECK_SM_ROW , Lines , Count );
+    Words = Check_Words ( CHECK_SM_DATA , &Count );
+    Sim_Feed ( CHECK_SM_DATA , Words , Count );
+
+    Check_Engine.Count = 0;
+
+    while ( Sim_Step ( ) )
+    {
+        if ( Sim_Pins ( ) != Check_Engine.Gpio )
+        {
+            Check_Panel ( &Check_Engine , Sim_Pins ( ) , Sim_Cycles ( ) );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Lines;
+}
+
+// The words a state machine is fed each frame , its channel reloaded from
+// the address the control channel holds
+static const uint32_t *Check_Words ( uint sm , uint *count )
+{
+    const uint32_t *Words           = NULL;
+    uint            Data            = DMA_CHANNELS;
+    uint            Counter_Channel = 0;
+
+    *count = 0;
+
+    for ( Counter_Channel = 0 ; Counter_Channel < Check_DMA ; Counter_Channel++ )
+    {
+        Data = ( Check_Channels [ Counter_Channel ].Write == &pio0_hw.txf [ sm ] ) ? Counter_Channel : Data;
+    }
+
+    for ( Counter_Channel = 0 ; ( Counter_Channel < Check_DMA ) && ( Data < DMA_CHANNELS ) ; Counter_Channel++ )
+    {
+        if ( Check_Channels [ Counter_Channel ].Write == &dma_hw->ch [ Data ].al3_read_addr_trig )
+        {
+            Words  = *( const uint32_t * const * ) Check_Channels [ Counter_Channel ].Read;
+            *count = Check_Channels [ Data ].Count;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Words;
+}
+
+// Pico SDK stand-ins
+void channel_config_set_chain_to ( dma_channel_config *config , uint channel )
+{
+    config->Chain = channel;
+}
+
+void channel_config_set_dreq ( dma_channel_config *config , uint dreq )
+{
+
+}
+
+void channel_config_set_read_increment ( dma_channel_config *config , bool increment )
+{
+    config->Read = increment;
+}
+
+void channel_config_set_transfer_data_size ( dma_channel_config *config , enum dma_channel_transfer_size size )
+{
+
+}
+
+void channel_config_set_write_increment ( dma_channel_config *config , bool increment )
+{
+    config->Write = increment;
+}
+
+uint32_t clock_get_hz ( enum clock_index clock )
+{
+    return CHECK_CLOCK_HZ;
+}
+
+void dma_channel_acknowledge_irq1 ( uint channel )
+{
+
+}
+
+void dma_channel_configure ( uint channel , const dma_channel_config *config , volatile void *write , const volatile void *read , uint count , bool trigger )
+{
+    Check_Channels [ channel ].Write = write;
+    Check_Channels [ channel ].Read  = read;
+    Check_Channels [ channel ].Count = count;
+}
+
+dma_channel_config dma_channel_get_default_config ( uint channel )
+{
+    dma_channel_config Config = { channel , true , false };
+
+    return Config;
+}
+
+void dma_channel_set_irq1_enabled ( uint channel , bool enabled )
+{
+
+}
+
+int dma_claim_unused_channel ( bool required )
+{
+    return ( int ) Check_DMA++;
+}
+
+void irq_set_enabled ( uint irq , bool enabled )
+{
+
+}
+
+void irq_set_exclusive_handler ( uint irq , irq_handler_t handler )
+{
+    Check_Frame = handler;
+}
+
+// Core 1 runs on this thread until it first waits for an interrupt
+void multicore_launch_core1 ( void ( *entry ) ( void ) )
+{
+    if ( 0 == setjmp ( Check_Core1 ) )
+    {
+        entry ( );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// The original Matrix_Draw's gpio_put and sleep_us , on virtual time
+static void gpio_put ( uint gpio , bool value )
+{
+    Check_Panel ( &Check_Original , ( Check_Original.Gpio & ~( 1u << gpio ) ) | ( value ? ( 1u << gpio ) : 0 ) , Check_Time );
+}
+
+static void sleep_us ( uint64_t us )
+{
+    Check_Time += us;
+}
+
+uint32_t time_us_32 ( void )
+{
+    return 0;
+}
+
+void __dmb ( void )
+{
+
+}
+
+void __wfi ( void )
+{
+    longjmp ( Check_Core1 , 1 );
+}
+
+void Bench_Add ( uint stage , uint32_t cycles )
+{
+
+}
+
+void Bench_Stop ( uint stage , uint32_t start )
+{
+
+}
+
+// As on the target , the original's MATRIX_ macros go through here
+void Hal_GpioPut ( uint pin , bool level )
+{
+    gpio_put ( pin , level );
+}
+
+uint32_t Hal_Cycles ( void )
+{
+    return 0;
+}
+
+void Hal_CyclesStart ( void )
+{
+
+}
+
+/*** end of file ***/
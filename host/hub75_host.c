@@ -0,0 +1,352 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           hub75_host.c                                          *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <host.h>
+#include <hub75.h>
+#include <bench.h>
+#include <gamma.h>
+#include <matrix_default.h>
+#include <trace.h>
+
+#include <string.h>
+
+// Least significant plane dwell in clk_sys cycles , as Hub75_Core1 works it out
+#define HUB75_HOST_DWELL        ( ( HUB75_DWELL_US * ( HOST_CLOCK_HZ / 1000000 ) ) / ( ( 1u << HUB75_COLOUR_DEPTH ) - 1 ) )
+
+static uint32_t         Hub75_Back  [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];    // Composed by core 0
+static uint32_t         Hub75_Front [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];    // On the panel
+static uint8_t          Hub75_Gamma [ 256 ];
+static uint32_t         Hub75_On    [ HUB75_COLOUR_DEPTH ];    // Output on per plane , HUB75_DWELL_UNIT cycles
+static uint32_t         Hub75_Units [ HUB75_COLOUR_DEPTH ];    // Whole dwell per plane , the same units
+static uint8_t          Hub75_Brightness = HUB75_BRIGHTNESS;
+static uint8_t          Hub75_LineLevel  = 0;
+static uint32_t         Hub75_Cycles    = 0;   // Hal_Cycles at the last frame boundary
+static uint32_t         Hub75_FrameUs   = 0;   // Frame period of the modelled refresh
+static uint64_t         Hub75_ScanEnd   = 0;   // ns , end of the last frame given to the trace
+static volatile uint8_t Hub75_SwapState = HUB75_SWAP_IDLE;
+
+volatile uint32_t Hub75_FrameCount = 0;
+volatile Jitter_t Hub75_Jitter;
+volatile uint32_t Hub75_ShownTime = 0;
+
+static uint32_t Hub75_Correct ( uint32_t colour );
+static int64_t  Hub75_Frame   ( int32_t id , void *user_data );
+static void     Hub75_Lines   ( void );
+static void     Hub75_Pin     ( uint64_t time , uint64_t cycle , uint pin , bool level );
+static void     Hub75_Scan    ( uint64_t time );
+
+void Hub75_Blit ( uint row , uint column , const uint32_t *lanes , uint words , uint32_t colour )
+{
+    uint Counter_Column = 0;
+
+    colour = Hub75_Correct ( colour );
+
+    if ( ( row < MATRIX_HEIGHT ) && ( 0 == ( column & 3 ) ) )
+    {
+        for ( Counter_Column = 0 ; ( Counter_Column < ( words * 4 ) ) && ( ( column + Counter_Column ) < MATRIX_WIDTH ) ; Counter_Column++ )
+        {
+            Hub75_Back [ row ] [ column + Counter_Column ] = ( ( lanes [ Counter_Column / 4 ] >> ( ( Counter_Column % 4 ) * 8 ) ) & 0xFF ) ? colour : 0;
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+void Hub75_FillRect ( uint row , uint column , uint width , uint height , uint32_t colour )
+{
+    uint Counter_Column = 0;
+    uint Counter_Row    = 0;
+
+    colour = Hub75_Correct ( colour );
+
+    for ( Counter_Row = row ; ( Counter_Row < ( row + height ) ) && ( Counter_Row < MATRIX_HEIGHT ) ; Counter_Row++ )
+    {
+        for ( Counter_Column = column ; ( Counter_Column < ( column + width ) ) && ( Counter_Column < MATRIX_WIDTH ) ; Counter_Column++ )
+        {
+            Hub75_Back [ Counter_Row ] [ Counter_Column ] = colour;
+        }
+    }
+}
+
+uint32_t Hub75_GetPixel ( uint row , uint column )
+{
+    return ( ( row < MATRIX_HEIGHT ) && ( column < MATRIX_WIDTH ) ) ? Hub75_Back [ row ] [ column ] : 0;
+}
+
+uint8_t Hub75_Host_Brightness ( void )
+{
+    return Hub75_LineLevel;
+}
+
+uint32_t Hub75_Host_Frames ( void )
+{
+    return Hub75_FrameCount;
+}
+
+uint32_t Hub75_Host_Pixel ( uint row , uint column )
+{
+    return ( ( row < MATRIX_HEIGHT ) && ( column < MATRIX_WIDTH ) ) ? Hub75_Front [ row ] [ column ] : 0;
+}
+
+// Frames come round at the rate Hub75_Timing gives for the target , rounded
+// up so the traced frames never overlap
+void Hub75_Init ( void )
+{
+    Hub75_Timing_t Timing;
+    uint           Counter_Level = 0;
+
+    for ( Counter_Level = 0 ; Counter_Level < 256 ; Counter_Level++ )
+    {
+        Hub75_Gamma [ Counter_Level ] = ( uint8_t ) GAMMA_LEVEL ( Counter_Level , ( 1u << HUB75_COLOUR_DEPTH ) - 1 );
+    }
+
+    Hub75_Lines ( );
+
+    Hub75_Timing ( &Timing );
+    Hub75_FrameUs = ( Timing.Shift + Timing.Latch + Timing.Dwell + ( HOST_CLOCK_HZ / 1000000 ) - 1 ) / ( HOST_CLOCK_HZ / 1000000 );
+
+    Jitter_Reset   ( &Hub75_Jitter );
+    Hal_TimerStart ( Hub75_FrameUs , Hub75_Frame , NULL );
+}
+
+bool Hub75_IsReady ( void )
+{
+    return ( HUB75_SWAP_IDLE == Hub75_SwapState );
+}
+
+void Hub75_Present ( uint32_t dirty_rows )
+{
+    if ( ( HUB75_SWAP_IDLE == Hub75_SwapState ) && ( 0 != dirty_rows ) )
+    {
+        Hub75_SwapState = HUB75_SWAP_REQUESTED;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+void Hub75_SetBrightness ( uint8_t level )
+{
+    Hub75_Brightness = level;
+}
+
+void Hub75_SetPixel ( uint row , uint column , uint32_t colour )
+{
+    if ( ( row < MATRIX_HEIGHT ) && ( column < MATRIX_WIDTH ) )
+    {
+        Hub75_Back [ row ] [ column ] = Hub75_Correct ( colour );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// The target's dwell and PIO cycle counts at HOST_CLOCK_HZ
+void Hub75_Timing ( Hub75_Timing_t *timing )
+{
+    uint Counter_Plane = 0;
+
+    Hub75_Lines ( );
+
+    timing->Dwell = 0;
+
+    for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+    {
+        timing->Dwell += HUB75_SCAN_LINES * Hub75_Units [ Counter_Plane ] * HUB75_DWELL_UNIT;
+    }
+
+    timing->Latch = HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH * ( ( uint32_t ) ( HUB75_LATCH_CYCLES * HUB75_CLK_DIV ) + HUB75_ROW_CYCLES );
+    timing->Shift = HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH * ( uint32_t ) ( HUB75_SHIFT_CYCLES * HUB75_CLK_DIV );
+}
+
+// Frame boundary , the same swap sequence as Hub75_FrameISR
+static int64_t Hub75_Frame ( int32_t id , void *user_data )
+{
+    uint32_t Start = Hal_Cycles ( );
+
+    Jitter_Sample ( &Hub75_Jitter , Hal_Micros ( ) );
+    Hub75_FrameCount++;
+
+    if ( 1 < Hub75_Jitter.Count )
+    {
+        Bench_Add ( BENCH_STAGE_FRAME , ( Start - Hub75_Cycles ) & HAL_CYCLES_MASK );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Hub75_Cycles = Start;
+
+    if ( Hub75_Brightness != Hub75_LineLevel )
+    {
+        Hub75_Lines ( );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    switch ( Hub75_SwapState )
+    {
+        case HUB75_SWAP_REQUESTED:
+            memcpy ( Hub75_Front , Hub75_Back , sizeof ( Hub75_Front ) );
+            Hub75_SwapState = HUB75_SWAP_LATCHED;
+        break;
+
+        case HUB75_SWAP_LATCHED:
+            Hub75_ShownTime = Hal_Micros ( );
+            Hub75_SwapState = HUB75_SWAP_SHOWN;
+        break;
+
+        case HUB75_SWAP_SHOWN:
+            Hub75_SwapState = HUB75_SWAP_IDLE;
+        break;
+
+        default:
+        break;
+    }
+
+    Bench_Stop ( BENCH_STAGE_SWAP , Start );
+
+    if ( Trace_Active ( ) )
+    {
+        Hub75_Scan ( Hal_Micros64 ( ) * 1000 );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Hub75_FrameUs;
+}
+
+// Gamma corrected levels in the HUB75_COLOUR_DEPTH most significant bits
+// of each channel , as Hub75_GetPixel reads them back from the bit-planes
+static uint32_t Hub75_Correct ( uint32_t colour )
+{
+    return ( ( uint32_t ) Hub75_Gamma [ ( colour >> 16 ) & 0xFF ] << ( 24 - HUB75_COLOUR_DEPTH ) )
+         | ( ( uint32_t ) Hub75_Gamma [ ( colour >>  8 ) & 0xFF ] << ( 16 - HUB75_COLOUR_DEPTH ) )
+         | ( ( uint32_t ) Hub75_Gamma [   colour         & 0xFF ] << (  8 - HUB75_COLOUR_DEPTH ) );
+}
+
+// On / off split of each plane's dwell for Hub75_Brightness , as Hub75_Lines on the target
+static void Hub75_Lines ( void )
+{
+    uint32_t Level         = 0;
+    uint     Counter_Plane = 0;
+
+    Hub75_LineLevel = Hub75_Brightness;
+    Level           = Gamma_Table [ Hub75_LineLevel ];
+
+    for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+    {
+        Hub75_Units [ Counter_Plane ] = ( HUB75_HOST_DWELL << Counter_Plane ) / HUB75_DWELL_UNIT;
+        Hub75_Units [ Counter_Plane ] = ( Hub75_Units [ Counter_Plane ] < 2 ) ? 2 : ( ( Hub75_Units [ Counter_Plane ] > HUB75_DWELL_FIELD ) ? HUB75_DWELL_FIELD : Hub75_Units [ Counter_Plane ] );
+        Hub75_On    [ Counter_Plane ] = ( Hub75_Units [ Counter_Plane ] * Level ) / GAMMA_FULL;
+        Hub75_On    [ Counter_Plane ] = ( Hub75_On [ Counter_Plane ] > ( Hub75_Units [ Counter_Plane ] - 1 ) ) ? ( Hub75_Units [ Counter_Plane ] - 1 ) : Hub75_On [ Counter_Plane ];
+    }
+}
+
+static void Hub75_Pin ( uint64_t time , uint64_t cycle , uint pin , bool level )
+{
+    Trace_Pin ( time + ( ( cycle * 1000 ) / ( HOST_CLOCK_HZ / 1000000 ) ) , pin , level );
+}
+
+// The panel pins through one frame as hub75.pio drives them , from time ( ns ).
+// hub75_row runs at clk_sys and hub75_data one instruction every
+// HUB75_CLK_DIV cycles , starting as the row program raises irq 4.
+static void Hub75_Scan ( uint64_t time )
+{
+    uint64_t Cycle          = 0;    // Start of the line and plane
+    uint64_t Data           = 0;    // Current hub75_data instruction
+    uint32_t Bottom         = 0;
+    uint32_t Top            = 0;
+    uint     Divider        = ( uint ) HUB75_CLK_DIV;
+    uint     Counter_Column = 0;
+    uint     Counter_Line   = 0;
+    uint     Counter_Plane  = 0;
+    uint     Shift          = 0;
+
+    time = ( time > Hub75_ScanEnd ) ? time : Hub75_ScanEnd;
+
+    for ( Counter_Line = 0 ; Counter_Line < HUB75_SCAN_LINES ; Counter_Line++ )
+    {
+        for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+        {
+            Shift = 8 - HUB75_COLOUR_DEPTH + Counter_Plane;
+
+            // hub75_row : output off and row address
+            Hub75_Pin ( time , Cycle , MATRIX_OE_PIN , true );
+            Hub75_Pin ( time , Cycle , BIT_A_PIN     , MatrixRow [ Counter_Line ] & BIT_A_MASK );
+            Hub75_Pin ( time , Cycle , BIT_B_PIN     , MatrixRow [ Counter_Line ] & BIT_B_MASK );
+            Hub75_Pin ( time , Cycle , BIT_C_PIN     , MatrixRow [ Counter_Line ] & BIT_C_MASK );
+            Hub75_Pin ( time , Cycle , BIT_D_PIN     , MatrixRow [ Counter_Line ] & BIT_D_MASK );
+
+            // hub75_data : wait , LAT high , set x , then out / out / jmp per column.
+            // irq 4 is raised two instructions before hub75_row reaches the dwell.
+            Data = Cycle + HUB75_ROW_CYCLES - 2 + Divider;
+            Hub75_Pin ( time , Data , MATRIX_LAT_PIN , true );
+            Data += 2 * Divider;
+
+            for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
+            {
+                Top    = Hub75_Front [ Counter_Line                    ] [ Counter_Column ];
+                Bottom = Hub75_Front [ Counter_Line + HUB75_SCAN_LINES ] [ Counter_Column ];
+
+                Hub75_Pin ( time , Data , LED_R1_PIN     , ( Top    >> ( 16 + Shift ) ) & 1 );
+                Hub75_Pin ( time , Data , LED_G1_PIN     , ( Top    >> (  8 + Shift ) ) & 1 );
+                Hub75_Pin ( time , Data , LED_B1_PIN     , ( Top    >>        Shift   ) & 1 );
+                Hub75_Pin ( time , Data , LED_R2_PIN     , ( Bottom >> ( 16 + Shift ) ) & 1 );
+                Hub75_Pin ( time , Data , LED_G2_PIN     , ( Bottom >> (  8 + Shift ) ) & 1 );
+                Hub75_Pin ( time , Data , LED_B2_PIN     , ( Bottom >>        Shift   ) & 1 );
+                Hub75_Pin ( time , Data , MATRIX_CLK_PIN , false );
+                Hub75_Pin ( time , Data + Divider       , MATRIX_CLK_PIN , true  );
+                Hub75_Pin ( time , Data + ( 2 * Divider ) , MATRIX_CLK_PIN , false );
+
+                Data += 3 * Divider;
+            }
+
+            Hub75_Pin ( time , Data , MATRIX_LAT_PIN , false );
+
+            // irq 5 releases hub75_row into the dwell , on then off for the rest
+            // and off throughout at no on time
+            Cycle += HUB75_ROW_CYCLES + ( ( HUB75_LATCH_CYCLES + HUB75_SHIFT_CYCLES ) * Divider );
+
+            if ( 0 != Hub75_On [ Counter_Plane ] )
+            {
+                Hub75_Pin ( time , Cycle , MATRIX_OE_PIN , false );
+                Hub75_Pin ( time , Cycle + ( Hub75_On [ Counter_Plane ] * HUB75_DWELL_UNIT ) , MATRIX_OE_PIN , true );
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            Cycle += Hub75_Units [ Counter_Plane ] * HUB75_DWELL_UNIT;
+        }
+    }
+
+    Hub75_Pin ( time , Cycle , MATRIX_OE_PIN , true );
+    Hub75_ScanEnd = time + ( ( Cycle * 1000 ) / ( HOST_CLOCK_HZ / 1000000 ) );
+}
+
+/*** end of file ***/
@@ -0,0 +1,761 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           pio_asm.c                                             *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <main.h>
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+// PIO assembler for the host build , used when pioasm from the Pico SDK is
+// not on the path. Takes the pioasm command line and writes the same c-sdk
+// header , so src/hub75.pio is built from source for hub75_check :
+//   pio_asm [ -o c-sdk ] input.pio output.h
+// Covers the RP2040 instruction set with side-set , delays , labels ,
+// .wrap_target , .wrap , .origin and % c-sdk blocks. .define , .lang_opt ,
+// expressions and the other output formats are not taken , anything not
+// understood stops the build with the file and line.
+#define ASM_LINE_MAX            256
+#define ASM_NAME_MAX            32
+#define ASM_PROGRAMS_MAX        4
+#define ASM_INSTRUCTIONS_MAX    32      // RP2040 instruction memory
+#define ASM_LABELS_MAX          32
+#define ASM_SDK_MAX             4096    // % c-sdk text per program
+#define ASM_TOKENS_MAX          16
+
+typedef struct
+{
+    char    Name [ ASM_NAME_MAX ];
+    uint8_t Address;
+    bool    Public;
+} Asm_Label_t;
+
+typedef struct
+{
+    char        Name   [ ASM_NAME_MAX ];
+    char        Source [ ASM_INSTRUCTIONS_MAX ] [ ASM_LINE_MAX ];   // Instruction text , encoded once the labels are known
+    uint        Line   [ ASM_INSTRUCTIONS_MAX ];
+    uint16_t    Code   [ ASM_INSTRUCTIONS_MAX ];
+    Asm_Label_t Labels [ ASM_LABELS_MAX ];
+    char        SDK    [ ASM_SDK_MAX ];
+    uint8_t     Length;
+    uint8_t     LabelCount;
+    int         Origin;
+    int         Wrap;           // Last instruction before .wrap , -1 for the end
+    int         WrapTarget;
+    uint8_t     SideCount;      // Side-set pins , not counting the enable bit
+    bool        SideOpt;
+    bool        SidePindirs;
+    bool        SideSet;        // .side_set given
+} Asm_Program_t;
+
+static Asm_Program_t Asm_Programs [ ASM_PROGRAMS_MAX ];
+static uint          Asm_Count = 0;
+static const char   *Asm_File  = NULL;
+static uint          Asm_Line  = 0;
+
+static void     Asm_Encode   ( Asm_Program_t *program , uint index );
+static void     Asm_Error    ( const char *format , ... );
+static int      Asm_Find     ( const char *word , const char * const *names , uint count );
+static uint32_t Asm_Number   ( const Asm_Program_t *program , const char *text , bool label );
+static void     Asm_Parse    ( FILE *input );
+static uint     Asm_Tokens   ( char *text , char **tokens );
+static void     Asm_Write    ( FILE *output );
+
+int main ( int argc , char **argv )
+{
+    FILE *Input         = NULL;
+    FILE *Output        = NULL;
+    int   Counter_Arg   = 0;
+    uint  Counter_Code  = 0;
+    uint  Counter_Prog  = 0;
+    const char *Files [ 2 ] = { NULL , NULL };
+    uint  Count         = 0;
+
+    for ( Counter_Arg = 1 ; Counter_Arg < argc ; Counter_Arg++ )
+    {
+        if ( ( 0 == strcmp ( argv [ Counter_Arg ] , "-o" ) ) && ( ( Counter_Arg + 1 ) < argc ) )
+        {
+            if ( 0 != strcmp ( argv [ ++Counter_Arg ] , "c-sdk" ) )
+            {
+                fprintf ( stderr , "pio_asm: only c-sdk output is supported\n" );
+                exit ( EXIT_FAILURE );
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+        else if ( Count < 2 )
+        {
+            Files [ Count++ ] = argv [ Counter_Arg ];
+        }
+        else
+        {
+            Count++;
+        }
+    }
+
+    if ( 2 != Count )
+    {
+        fprintf ( stderr , "usage: pio_asm [ -o c-sdk ] input.pio output.h\n" );
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Asm_File = Files [ 0 ];
+    Input    = fopen ( Files [ 0 ] , "r" );
+
+    if ( NULL == Input )
+    {
+        perror ( Files [ 0 ] );
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Asm_Parse ( Input );
+    fclose    ( Input );
+
+    for ( Counter_Prog = 0 ; Counter_Prog < Asm_Count ; Counter_Prog++ )
+    {
+        for ( Counter_Code = 0 ; Counter_Code < Asm_Programs [ Counter_Prog ].Length ; Counter_Code++ )
+        {
+            Asm_Encode ( &Asm_Programs [ Counter_Prog ] , Counter_Code );
+        }
+    }
+
+    Output = fopen ( Files [ 1 ] , "w" );
+
+    if ( NULL == Output )
+    {
+        perror ( Files [ 1 ] );
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Asm_Write ( Output );
+    fclose    ( Output );
+
+    return EXIT_SUCCESS;
+}
+
+// Directives , labels and instruction text by program , % c-sdk blocks kept as they are
+static void Asm_Parse ( FILE *input )
+{
+    Asm_Program_t *Program = NULL;
+    char           Line    [ ASM_LINE_MAX ];
+    char           Text    [ ASM_LINE_MAX ];
+    char          *Tokens  [ ASM_TOKENS_MAX ];
+    char          *Colon   = NULL;
+    char          *Start   = NULL;
+    uint           Count   = 0;
+    bool           Block   = false;    // Inside % ... { %}
+    bool           SDK     = false;    // ... and it is c-sdk
+    bool           Public  = false;
+
+    while ( NULL != fgets ( Line , sizeof ( Line ) , input ) )
+    {
+        Asm_Line++;
+
+        if ( Block )
+        {
+            if ( 0 == strncmp ( Line , "%}" , 2 ) )
+            {
+                Block = false;
+            }
+            else if ( SDK && ( ( strlen ( Program->SDK ) + strlen ( Line ) ) < ASM_SDK_MAX ) )
+            {
+                strcat ( Program->SDK , Line );
+            }
+            else if ( SDK )
+            {
+                Asm_Error ( "%% c-sdk block too long" );
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            continue;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        if ( '%' == Line [ 0 ] )
+        {
+            SDK   = ( NULL != strstr ( Line , "c-sdk" ) );
+            Block = true;
+
+            if ( SDK && ( NULL == Program ) )
+            {
+                Asm_Error ( "%% c-sdk block before any .program" );
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            continue;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        // Comments are ; or //
+        strcpy ( Text , Line );
+        Text [ strcspn ( Text , ";\r\n" ) ] = '\0';
+        Start = strstr ( Text , "//" );
+
+        if ( NULL != Start )
+        {
+            *Start = '\0';
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        // Labels , public or not , ahead of anything else on the line
+        Start = Text;
+
+        while ( isspace ( ( unsigned char ) *Start ) )
+        {
+            Start++;
+        }
+
+        Public = ( 0 == strncmp ( Start , "public " , 7 ) );
+        Colon  = strchr ( Start , ':' );
+
+        if ( ( NULL != Colon ) && ( ( NULL == strstr ( Start , "::" ) ) || ( Colon < strstr ( Start , "::" ) ) ) )
+        {
+            *Colon = '\0';
+            Count  = Asm_Tokens ( Start , Tokens );
+
+            if ( ( NULL == Program ) || ( Count != ( Public ? 2u : 1u ) ) || ( ASM_LABELS_MAX <= Program->LabelCount ) || ( ASM_NAME_MAX <= strlen ( Tokens [ Count - 1 ] ) ) )
+            {
+                Asm_Error ( "bad label" );
+            }
+            else
+            {
+                strcpy ( Program->Labels [ Program->LabelCount ].Name , Tokens [ Count - 1 ] );
+                Program->Labels [ Program->LabelCount ].Address = Program->Length;
+                Program->Labels [ Program->LabelCount ].Public  = Public;
+                Program->LabelCount++;
+            }
+
+            Start = Colon + 1;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        strcpy ( Line , Start );
+        Count = Asm_Tokens ( Start , Tokens );
+
+        if ( 0 == Count )
+        {
+            // Nothing to do
+        }
+        else if ( 0 == strcmp ( Tokens [ 0 ] , ".program" ) )
+        {
+            if ( ( 2 != Count ) || ( ASM_PROGRAMS_MAX <= Asm_Count ) || ( ASM_NAME_MAX <= strlen ( Tokens [ 1 ] ) ) )
+            {
+                Asm_Error ( "bad .program" );
+            }
+            else
+            {
+                Program = &Asm_Programs [ Asm_Count++ ];
+                memset ( Program , 0 , sizeof ( *Program ) );
+                strcpy ( Program->Name , Tokens [ 1 ] );
+                Program->Origin     = -1;
+                Program->Wrap       = -1;
+                Program->WrapTarget = 0;
+            }
+        }
+        else if ( NULL == Program )
+        {
+            Asm_Error ( "'%s' before any .program" , Tokens [ 0 ] );
+        }
+        else if ( 0 == strcmp ( Tokens [ 0 ] , ".side_set" ) )
+        {
+            Program->SideSet     = true;
+            Program->SideCount   = ( 2 <= Count ) ? ( uint8_t ) Asm_Number ( Program , Tokens [ 1 ] , false ) : 0;
+            Program->SideOpt     = ( 3 <= Count ) && ( 0 == strcmp ( Tokens [ 2 ] , "opt" ) );
+            Program->SidePindirs = ( 3 <= Count ) && ( 0 == strcmp ( Tokens [ Count - 1 ] , "pindirs" ) );
+
+            if ( ( 2 > Count ) || ( ( Program->SideCount + ( Program->SideOpt ? 1 : 0 ) ) > 5 ) )
+            {
+                Asm_Error ( "bad .side_set" );
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+        else if ( 0 == strcmp ( Tokens [ 0 ] , ".wrap_target" ) )
+        {
+            Program->WrapTarget = Program->Length;
+        }
+        else if ( 0 == strcmp ( Tokens [ 0 ] , ".wrap" ) )
+        {
+            Program->Wrap = ( int ) Program->Length - 1;
+        }
+        else if ( ( 0 == strcmp ( Tokens [ 0 ] , ".origin" ) ) && ( 2 == Count ) )
+        {
+            Program->Origin = ( int ) Asm_Number ( Program , Tokens [ 1 ] , false );
+        }
+        else if ( '.' == Tokens [ 0 ] [ 0 ] )
+        {
+            Asm_Error ( "directive %s not supported" , Tokens [ 0 ] );
+        }
+        else if ( ASM_INSTRUCTIONS_MAX <= Program->Length )
+        {
+            Asm_Error ( "program %s over %u instructions" , Program->Name , ASM_INSTRUCTIONS_MAX );
+        }
+        else
+        {
+            strcpy ( Program->Source [ Program->Length ] , Line );
+            Program->Source [ Program->Length ] [ strcspn ( Line , ";\r\n" ) ] = '\0';
+            Program->Line [ Program->Length ] = Asm_Line;
+            Program->Length++;
+        }
+    }
+
+    if ( Block )
+    {
+        Asm_Error ( "%% block not closed" );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// One instruction to machine code , see the RP2040 datasheet 3.4
+static void Asm_Encode ( Asm_Program_t *program , uint index )
+{
+    static const char * const Conditions [ ] = { "" , "!x" , "x--" , "!y" , "y--" , "x!=y" , "pin" , "!osre" };
+    static const char * const Sources    [ ] = { "pins" , "x" , "y" , "null" , "" , "status" , "isr" , "osr" };
+    static const char * const Outs       [ ] = { "pins" , "x" , "y" , "null" , "pindirs" , "pc" , "isr" , "exec" };
+    static const char * const Movs       [ ] = { "pins" , "x" , "y" , "" , "exec" , "pc" , "isr" , "osr" };
+    static const char * const Sets       [ ] = { "pins" , "x" , "y" , "" , "pindirs" };
+    static const char * const Waits      [ ] = { "gpio" , "pin" , "irq" };
+    char     Text   [ ASM_LINE_MAX ];
+    char    *Tokens [ ASM_TOKENS_MAX ];
+    char    *Op     = NULL;
+    char    *Source = NULL;
+    uint16_t Code   = 0;
+    uint32_t Delay  = 0;
+    uint32_t Side   = 0;
+    uint32_t Value  = 0;
+    uint     Args   = 0;
+    uint     Count  = 0;
+    uint     Bits   = program->SideCount + ( program->SideOpt ? 1 : 0 );
+    uint     Counter_Token = 0;
+    int      Found  = 0;
+    bool     Sided  = false;
+
+    Asm_Line = program->Line [ index ];
+    strcpy ( Text , program->Source [ index ] );
+    Count = Asm_Tokens ( Text , Tokens );
+
+    // side n and [ n ] come off the end , the rest is the op and its arguments
+    for ( Counter_Token = 1 ; Counter_Token < Count ; Counter_Token++ )
+    {
+        if ( ( 0 == strcmp ( Tokens [ Counter_Token ] , "side" ) ) && ( ( Counter_Token + 1 ) < Count ) )
+        {
+            Side  = Asm_Number ( program , Tokens [ Counter_Token + 1 ] , false );
+            Sided = true;
+            Args  = ( 0 == Args ) ? Counter_Token : Args;
+            Counter_Token++;
+        }
+        else if ( ( 0 == strcmp ( Tokens [ Counter_Token ] , "[" ) ) && ( ( Counter_Token + 2 ) < Count ) && ( 0 == strcmp ( Tokens [ Counter_Token + 2 ] , "]" ) ) )
+        {
+            Delay = Asm_Number ( program , Tokens [ Counter_Token + 1 ] , false );
+            Args  = ( 0 == Args ) ? Counter_Token : Args;
+            Counter_Token += 2;
+        }
+        else if ( 0 != Args )
+        {
+            Asm_Error ( "'%s' after side-set or delay" , Tokens [ Counter_Token ] );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    Args = ( ( 0 == Args ) ? Count : Args ) - 1;
+    Op   = Tokens [ 0 ];
+
+    if ( 0 == strcmp ( Op , "jmp" ) )
+    {
+        Found = ( 2 == Args ) ? Asm_Find ( Tokens [ 1 ] , Conditions , count_of ( Conditions ) ) : 0;
+        Code  = ( uint16_t ) ( 0x0000 | ( ( Found < 0 ? 0 : Found ) << 5 ) | Asm_Number ( program , Tokens [ Args ] , true ) );
+        Found = ( ( 1 == Args ) || ( ( 2 == Args ) && ( Found > 0 ) ) ) ? 1 : -1;
+    }
+    else if ( ( 0 == strcmp ( Op , "wait" ) ) && ( ( 3 == Args ) || ( 4 == Args ) ) )
+    {
+        Value = Asm_Number ( program , Tokens [ 3 ] , false );
+        Found = Asm_Find ( Tokens [ 2 ] , Waits , count_of ( Waits ) );
+        Value = ( ( 4 == Args ) && ( 0 == strcmp ( Tokens [ 4 ] , "rel" ) ) ) ? ( Value | 0x10 ) : Value;
+        Code  = ( uint16_t ) ( 0x2000 | ( ( Asm_Number ( program , Tokens [ 1 ] , false ) & 1 ) << 7 ) | ( ( Found < 0 ? 0 : Found ) << 5 ) | ( Value & 0x1F ) );
+        Found = ( ( 3 == Args ) || ( 0x10 & Value ) ) ? Found : -1;
+    }
+    else if ( ( ( 0 == strcmp ( Op , "in" ) ) || ( 0 == strcmp ( Op , "out" ) ) ) && ( 2 == Args ) )
+    {
+        Value = Asm_Number ( program , Tokens [ 2 ] , false );
+        Found = ( 'i' == Op [ 0 ] ) ? Asm_Find ( Tokens [ 1 ] , Sources , count_of ( Sources ) ) : Asm_Find ( Tokens [ 1 ] , Outs , count_of ( Outs ) );
+        Code  = ( uint16_t ) ( ( ( 'i' == Op [ 0 ] ) ? 0x4000 : 0x6000 ) | ( ( Found < 0 ? 0 : Found ) << 5 ) | ( Value & 0x1F ) );
+        Found = ( ( Value < 1 ) || ( Value > 32 ) ) ? -1 : Found;
+    }
+    else if ( ( 0 == strcmp ( Op , "push" ) ) || ( 0 == strcmp ( Op , "pull" ) ) )
+    {
+        Code  = ( 'l' == Op [ 3 ] ) ? 0x8080 : 0x8000;
+        Code |= 0x0020;     // Blocking unless noblock
+        Found = 1;
+
+        for ( Counter_Token = 1 ; Counter_Token <= Args ; Counter_Token++ )
+        {
+            if ( ( 0 == strcmp ( Tokens [ Counter_Token ] , "iffull" ) ) || ( 0 == strcmp ( Tokens [ Counter_Token ] , "ifempty" ) ) )
+            {
+                Code |= 0x0040;
+            }
+            else if ( 0 == strcmp ( Tokens [ Counter_Token ] , "noblock" ) )
+            {
+                Code &= ( uint16_t ) ~0x0020;
+            }
+            else
+            {
+                Found = ( 0 == strcmp ( Tokens [ Counter_Token ] , "block" ) ) ? Found : -1;
+            }
+        }
+    }
+    else if ( ( 0 == strcmp ( Op , "mov" ) ) && ( 2 <= Args ) && ( 3 >= Args ) )
+    {
+        // Source may carry ! , ~ or :: in front , joined or apart
+        Source = Tokens [ Args ];
+        Value  = ( 3 == Args ) ? ( ( 0 == strcmp ( Tokens [ 2 ] , "::" ) ) ? 2 : ( ( ( 0 == strcmp ( Tokens [ 2 ] , "!" ) ) || ( 0 == strcmp ( Tokens [ 2 ] , "~" ) ) ) ? 1 : 3 ) ) : 0;
+
+        if ( ( 0 == Value ) && ( ( '!' == Source [ 0 ] ) || ( '~' == Source [ 0 ] ) ) )
+        {
+            Value = 1;
+            Source++;
+        }
+        else if ( ( 0 == Value ) && ( 0 == strncmp ( Source , "::" , 2 ) ) )
+        {
+            Value   = 2;
+            Source += 2;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Found = Asm_Find ( Source , Sources , count_of ( Sources ) );
+        Code  = ( uint16_t ) ( 0xA000 | ( ( Value & 3 ) << 3 ) | ( Found < 0 ? 0 : Found ) );
+        Found = ( 3 == Value ) ? -1 : Found;
+        Found = ( Found < 0 ) ? Found : Asm_Find ( Tokens [ 1 ] , Movs , count_of ( Movs ) );
+        Code |= ( uint16_t ) ( ( Found < 0 ? 0 : Found ) << 5 );
+    }
+    else if ( 0 == strcmp ( Op , "irq" ) )
+    {
+        Code  = 0xC000;
+        Found = 1;
+
+        for ( Counter_Token = 1 ; Counter_Token <= Args ; Counter_Token++ )
+        {
+            if ( 0 == strcmp ( Tokens [ Counter_Token ] , "wait" ) )
+            {
+                Code |= 0x0020;
+            }
+            else if ( 0 == strcmp ( Tokens [ Counter_Token ] , "clear" ) )
+            {
+                Code |= 0x0040;
+            }
+            else if ( 0 == strcmp ( Tokens [ Counter_Token ] , "rel" ) )
+            {
+                Code |= 0x0010;
+            }
+            else if ( ( 0 == strcmp ( Tokens [ Counter_Token ] , "set" ) ) || ( 0 == strcmp ( Tokens [ Counter_Token ] , "nowait" ) ) )
+            {
+                // Nothing to do
+            }
+            else
+            {
+                Code |= ( uint16_t ) ( Asm_Number ( program , Tokens [ Counter_Token ] , false ) & 7 );
+            }
+        }
+    }
+    else if ( ( 0 == strcmp ( Op , "set" ) ) && ( 2 == Args ) )
+    {
+        Value = Asm_Number ( program , Tokens [ 2 ] , false );
+        Found = Asm_Find ( Tokens [ 1 ] , Sets , count_of ( Sets ) );
+        Code  = ( uint16_t ) ( 0xE000 | ( ( Found < 0 ? 0 : Found ) << 5 ) | ( Value & 0x1F ) );
+        Found = ( Value > 31 ) ? -1 : Found;
+    }
+    else if ( ( 0 == strcmp ( Op , "nop" ) ) && ( 0 == Args ) )
+    {
+        Code  = 0xA042;     // mov y , y
+        Found = 1;
+    }
+    else
+    {
+        Found = -1;
+    }
+
+    if ( Found < 0 )
+    {
+        Asm_Error ( "cannot assemble '%s'" , program->Source [ index ] );
+    }
+    else if ( Sided && !program->SideSet )
+    {
+        Asm_Error ( "side-set without .side_set" );
+    }
+    else if ( !Sided && program->SideSet && !program->SideOpt && ( 0 != program->SideCount ) )
+    {
+        Asm_Error ( "side-set required" );
+    }
+    else if ( ( Side >= ( 1u << program->SideCount ) ) || ( Delay >= ( 1u << ( 5 - Bits ) ) ) )
+    {
+        Asm_Error ( "side-set or delay out of range" );
+    }
+    else
+    {
+        // Side-set bits , with the enable bit on top if optional , then the delay
+        Side = Sided ? ( ( program->SideOpt ? ( 1u << program->SideCount ) : 0 ) | Side ) : 0;
+        program->Code [ index ] = ( uint16_t ) ( Code | ( ( ( Side << ( 5 - Bits ) ) | Delay ) << 8 ) );
+    }
+}
+
+static void Asm_Error ( const char *format , ... )
+{
+    va_list Args;
+
+    va_start ( Args , format );
+    fprintf  ( stderr , "%s:%u: " , Asm_File , Asm_Line );
+    vfprintf ( stderr , format , Args );
+    fprintf  ( stderr , "\n" );
+    va_end   ( Args );
+
+    exit ( EXIT_FAILURE );
+}
+
+// Index of word in names , -1 if not there
+static int Asm_Find ( const char *word , const char * const *names , uint count )
+{
+    int  Found         = -1;
+    uint Counter_Name  = 0;
+
+    for ( Counter_Name = 0 ; ( Counter_Name < count ) && ( Found < 0 ) ; Counter_Name++ )
+    {
+        Found = ( ( '\0' != names [ Counter_Name ] [ 0 ] ) && ( 0 == strcmp ( word , names [ Counter_Name ] ) ) ) ? ( int ) Counter_Name : -1;
+    }
+
+    return Found;
+}
+
+// Decimal , 0x or 0b , or a label of program if label is set
+static uint32_t Asm_Number ( const Asm_Program_t *program , const char *text , bool label )
+{
+    char    *End           = NULL;
+    uint32_t Value         = 0;
+    uint     Counter_Label = 0;
+    bool     Found         = false;
+
+    if ( 0 == strncmp ( text , "0b" , 2 ) )
+    {
+        Value = ( uint32_t ) strtoul ( text + 2 , &End , 2 );
+    }
+    else
+    {
+        Value = ( uint32_t ) strtoul ( text , &End , 0 );
+    }
+
+    Found = ( End != text ) && ( '\0' == *End );
+
+    for ( Counter_Label = 0 ; label && !Found && ( Counter_Label < program->LabelCount ) ; Counter_Label++ )
+    {
+        if ( 0 == strcmp ( text , program->Labels [ Counter_Label ].Name ) )
+        {
+            Value = program->Labels [ Counter_Label ].Address;
+            Found = true;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    if ( !Found )
+    {
+        Asm_Error ( "'%s' is not a %s" , text , label ? "number or label" : "number" );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Value;
+}
+
+// Split on white space and commas , [ and ] stand alone
+static uint Asm_Tokens ( char *text , char **tokens )
+{
+    static char Spaced [ ASM_LINE_MAX * 3 ];
+    char       *Token = NULL;
+    uint        Count = 0;
+    uint        Out   = 0;
+
+    for ( ; ( '\0' != *text ) && ( Out < ( sizeof ( Spaced ) - 4 ) ) ; text++ )
+    {
+        if ( ( '[' == *text ) || ( ']' == *text ) )
+        {
+            Spaced [ Out++ ] = ' ';
+            Spaced [ Out++ ] = *text;
+            Spaced [ Out++ ] = ' ';
+        }
+        else
+        {
+            Spaced [ Out++ ] = ( ',' == *text ) ? ' ' : *text;
+        }
+    }
+
+    Spaced [ Out ] = '\0';
+
+    for ( Token = strtok ( Spaced , " \t\r\n" ) ; ( NULL != Token ) && ( Count < ASM_TOKENS_MAX ) ; Token = strtok ( NULL , " \t\r\n" ) )
+    {
+        tokens [ Count++ ] = Token;
+    }
+
+    return Count;
+}
+
+// The layout pioasm -o c-sdk writes
+static void Asm_Write ( FILE *output )
+{
+    Asm_Program_t *Program       = NULL;
+    uint           Wrap          = 0;
+    uint           Counter_Code  = 0;
+    uint           Counter_Label = 0;
+    uint           Counter_Prog  = 0;
+    char           Rule          [ ASM_NAME_MAX + 1 ];
+
+    fprintf ( output , "// -------------------------------------------------- //\n" );
+    fprintf ( output , "// This file is autogenerated by pioasm; do not edit! //\n" );
+    fprintf ( output , "// -------------------------------------------------- //\n\n" );
+    fprintf ( output , "#pragma once\n\n" );
+    fprintf ( output , "#if !PICO_NO_HARDWARE\n#include \"hardware/pio.h\"\n#endif\n" );
+
+    for ( Counter_Prog = 0 ; Counter_Prog < Asm_Count ; Counter_Prog++ )
+    {
+        Program = &Asm_Programs [ Counter_Prog ];
+        Wrap    = ( Program->Wrap < 0 ) ? ( uint ) ( Program->Length - 1 ) : ( uint ) Program->Wrap;
+
+        memset ( Rule , '-' , strlen ( Program->Name ) );
+        Rule [ strlen ( Program->Name ) ] = '\0';
+
+        fprintf ( output , "\n// %s //\n// %s //\n// %s //\n\n" , Rule , Program->Name , Rule );
+        fprintf ( output , "#define %s_wrap_target %d\n" , Program->Name , Program->WrapTarget );
+        fprintf ( output , "#define %s_wrap %u\n\n" , Program->Name , Wrap );
+
+        for ( Counter_Label = 0 ; Counter_Label < Program->LabelCount ; Counter_Label++ )
+        {
+            if ( Program->Labels [ Counter_Label ].Public )
+            {
+                fprintf ( output , "#define %s_offset_%s %uu\n" , Program->Name , Program->Labels [ Counter_Label ].Name , Program->Labels [ Counter_Label ].Address );
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+
+        fprintf ( output , "static const uint16_t %s_program_instructions[] = {\n" , Program->Name );
+
+        for ( Counter_Code = 0 ; Counter_Code < Program->Length ; Counter_Code++ )
+        {
+            if ( ( int ) Counter_Code == Program->WrapTarget )
+            {
+                fprintf ( output , "            //     .wrap_target\n" );
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            fprintf ( output , "    0x%04x, // %2u: %s\n" , Program->Code [ Counter_Code ] , Counter_Code , Program->Source [ Counter_Code ] );
+
+            if ( Counter_Code == Wrap )
+            {
+                fprintf ( output , "            //     .wrap\n" );
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+
+        fprintf ( output , "};\n\n#if !PICO_NO_HARDWARE\n" );
+        fprintf ( output , "static const struct pio_program %s_program = {\n" , Program->Name );
+        fprintf ( output , "    .instructions = %s_program_instructions,\n" , Program->Name );
+        fprintf ( output , "    .length = %u,\n" , Program->Length );
+        fprintf ( output , "    .origin = %d,\n};\n\n" , Program->Origin );
+        fprintf ( output , "static inline pio_sm_config %s_program_get_default_config(uint offset) {\n" , Program->Name );
+        fprintf ( output , "    pio_sm_config c = pio_get_default_sm_config();\n" );
+        fprintf ( output , "    sm_config_set_wrap(&c, offset + %s_wrap_target, offset + %s_wrap);\n" , Program->Name , Program->Name );
+
+        if ( Program->SideSet )
+        {
+            fprintf ( output , "    sm_config_set_sideset(&c, %u, %s, %s);\n" , Program->SideCount + ( Program->SideOpt ? 1 : 0 ) ,
+                      Program->SideOpt ? "true" : "false" , Program->SidePindirs ? "true" : "false" );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        fprintf ( output , "    return c;\n}\n" );
+
+        if ( '\0' != Program->SDK [ 0 ] )
+        {
+            fprintf ( output , "\n%s" , Program->SDK );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        fprintf ( output , "#endif\n" );
+    }
+}
+
+/*** end of file ***/
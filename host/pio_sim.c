@@ -0,0 +1,632 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           pio_sim.c                                             *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <pio_sim.h>
+
+#include <hardware/pio.h>
+
+#define SIM_MEMORY          32      // Instruction slots in the block
+#define SIM_IRQS            8
+
+typedef struct
+{
+    pio_sm_config   Config;
+    const uint32_t *Feed;           // Sim_Feed words not yet in the FIFO
+    uint            FeedCount;
+    uint32_t        Fifo [ SIM_FIFO_DEPTH * 2 ];
+    uint            FifoHead;
+    uint            FifoCount;
+    uint32_t        Divider;        // 1/256ths of a state machine clock
+    uint32_t        ISR;
+    uint32_t        OSR;
+    uint32_t        X;
+    uint32_t        Y;
+    uint8_t         Delay;
+    uint8_t         OSRCount;       // Bits shifted out , 32 for empty
+    uint8_t         PC;
+    bool            Claimed;
+    bool            Enabled;
+    bool            IrqWait;        // irq wait has raised its flag
+} Sim_SM_t;
+
+pio_hw_t        pio0_hw;
+
+static Sim_SM_t Sim_SMs    [ PIO_SM_COUNT ];
+static uint16_t Sim_Memory [ SIM_MEMORY ];
+static uint32_t Sim_Used       = 0;     // Instruction slots taken
+static uint32_t Sim_Dirs       = 0;     // Pins driven as outputs
+static uint32_t Sim_Function   = 0;     // Pins handed to the PIO block
+static uint32_t Sim_Levels     = 0;
+static uint8_t  Sim_Irq        = 0;
+static uint8_t  Sim_IrqClear   = 0;     // Flag changes at the end of the cycle
+static uint8_t  Sim_IrqSet     = 0;
+static uint64_t Sim_Cycle      = 0;
+static uint32_t Sim_Quiet      = 0;     // Clocks since any state machine , flag or FIFO moved
+static uint32_t Sim_FaultCount = 0;
+
+static void     Sim_Drive    ( uint base , uint count , uint32_t value , bool dirs );
+static bool     Sim_Execute  ( uint sm , uint16_t instruction , bool exec );
+static void     Sim_Fault    ( uint sm , uint16_t instruction , const char *what );
+static uint     Sim_IrqIndex ( uint sm , uint index );
+static bool     Sim_Pop      ( Sim_SM_t *state , uint32_t *word );
+static uint32_t Sim_Source   ( Sim_SM_t *state , uint source );
+
+uint64_t Sim_Cycles ( void )
+{
+    return Sim_Cycle;
+}
+
+uint32_t Sim_Faults ( void )
+{
+    return Sim_FaultCount;
+}
+
+void Sim_Feed ( uint sm , const uint32_t *words , uint count )
+{
+    Sim_SMs [ sm ].Feed      = words;
+    Sim_SMs [ sm ].FeedCount = count;
+}
+
+uint32_t Sim_Pins ( void )
+{
+    return Sim_Levels;
+}
+
+// One system clock. Every state machine sees the IRQ flags as they were at
+// the start of the clock , as the hardware does. Once nothing has moved for
+// the slowest state machine's whole clock nothing else can.
+bool Sim_Step ( void )
+{
+    Sim_SM_t *State      = NULL;
+    uint8_t   Irq        = Sim_Irq;
+    uint32_t  Slowest    = 0;
+    bool      Moved      = false;
+    uint      Counter_SM = 0;
+    uint      Depth      = 0;
+
+    Sim_IrqClear = 0;
+    Sim_IrqSet   = 0;
+
+    for ( Counter_SM = 0 ; Counter_SM < PIO_SM_COUNT ; Counter_SM++ )
+    {
+        State = &Sim_SMs [ Counter_SM ];
+        Depth = ( PIO_FIFO_JOIN_TX == State->Config.fifo_join ) ? ( SIM_FIFO_DEPTH * 2 ) : SIM_FIFO_DEPTH;
+
+        // DMA paced by the TX FIFO's DREQ
+        while ( ( State->FeedCount > 0 ) && ( State->FifoCount < Depth ) )
+        {
+            State->Fifo [ ( State->FifoHead + State->FifoCount ) % Depth ] = *State->Feed++;
+            State->FifoCount++;
+            State->FeedCount--;
+            Moved = true;
+        }
+
+        if ( State->Enabled )
+        {
+            State->Divider += 256;
+            Slowest         = ( State->Config.clkdiv > Slowest ) ? State->Config.clkdiv : Slowest;
+
+            if ( State->Divider < State->Config.clkdiv )
+            {
+                // Nothing to do
+            }
+            else if ( State->Delay > 0 )
+            {
+                State->Divider -= State->Config.clkdiv;
+                State->Delay--;
+                Moved = true;
+            }
+            else
+            {
+                State->Divider -= State->Config.clkdiv;
+                Moved = Sim_Execute ( Counter_SM , Sim_Memory [ State->PC ] , false ) || Moved;
+            }
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    Sim_Irq   = ( uint8_t ) ( ( Sim_Irq | Sim_IrqSet ) & ~Sim_IrqClear );
+    Sim_Quiet = ( Moved || ( Irq != Sim_Irq ) ) ? 0 : ( Sim_Quiet + 1 );
+    Sim_Cycle++;
+
+    return ( Sim_Quiet * 256 ) <= Slowest;
+}
+
+// Out , set and side-set to the pins the state machines own as outputs ,
+// or to their directions
+static void Sim_Drive ( uint base , uint count , uint32_t value , bool dirs )
+{
+    uint32_t Mask        = 0;
+    uint     Counter_Pin = 0;
+
+    for ( Counter_Pin = 0 ; Counter_Pin < count ; Counter_Pin++ )
+    {
+        Mask = 1u << ( ( base + Counter_Pin ) % 32 );
+
+        if ( dirs )
+        {
+            Sim_Dirs = ( Sim_Dirs & ~( Mask & Sim_Function ) ) | ( ( ( value >> Counter_Pin ) & 1 ) ? ( Mask & Sim_Function ) : 0 );
+        }
+        else
+        {
+            Mask      &= Sim_Function & Sim_Dirs;
+            Sim_Levels = ( Sim_Levels & ~Mask ) | ( ( ( value >> Counter_Pin ) & 1 ) ? Mask : 0 );
+        }
+    }
+}
+
+// One instruction , false if it stalls. Side-set lands whether it stalls or
+// not , the delay only once it completes. Forced instructions from
+// pio_sm_exec leave the program counter alone unless they write it.
+static bool Sim_Execute ( uint sm , uint16_t instruction , bool exec )
+{
+    Sim_SM_t *State       = &Sim_SMs [ sm ];
+    uint32_t  Data        = 0;
+    uint32_t  Word        = 0;
+    uint      Bits        = State->Config.sideset_bits;
+    uint      Count       = 0;
+    uint      Field       = ( instruction >> 8 ) & 0x1F;
+    uint      Index       = instruction & 0x1F;
+    uint      Threshold   = ( 0 == State->Config.pull_threshold ) ? 32 : State->Config.pull_threshold;
+    uint      Counter_Bit = 0;
+    bool      Done        = true;
+    bool      Jumped      = false;
+
+    // Side-set , the enable bit on top when optional
+    if ( ( Bits > 0 ) && ( !State->Config.sideset_opt || ( Field & 0x10 ) ) )
+    {
+        Count = State->Config.sideset_opt ? ( Bits - 1 ) : Bits;
+        Sim_Drive ( State->Config.sideset_base , Count , ( Field >> ( 5 - Bits ) ) & ( ( 1u << Count ) - 1 ) , State->Config.sideset_pindirs );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    switch ( instruction >> 13 )
+    {
+        case 0:     // jmp
+            switch ( ( instruction >> 5 ) & 7 )
+            {
+                case 0:  Jumped = true;                                        break;
+                case 1:  Jumped = ( 0 == State->X );                           break;
+                case 2:  Jumped = ( 0 != State->X ); State->X--;               break;
+                case 3:  Jumped = ( 0 == State->Y );                           break;
+                case 4:  Jumped = ( 0 != State->Y ); State->Y--;               break;
+                case 5:  Jumped = ( State->X != State->Y );                    break;
+                case 7:  Jumped = ( State->OSRCount < Threshold );             break;
+                default: Sim_Fault ( sm , instruction , "jmp pin" );           break;
+            }
+
+            State->PC = Jumped ? ( uint8_t ) Index : State->PC;
+            break;
+
+        case 1:     // wait
+            if ( 2 == ( ( instruction >> 5 ) & 3 ) )
+            {
+                Done          = ( ( ( Sim_Irq >> Sim_IrqIndex ( sm , Index ) ) & 1 ) == ( ( instruction >> 7 ) & 1u ) );
+                Sim_IrqClear |= ( Done && ( instruction & 0x80 ) ) ? ( uint8_t ) ( 1u << Sim_IrqIndex ( sm , Index ) ) : 0;
+            }
+            else if ( 0 == ( ( instruction >> 5 ) & 3 ) )
+            {
+                Done = ( ( ( Sim_Levels >> Index ) & 1 ) == ( ( instruction >> 7 ) & 1u ) );
+            }
+            else
+            {
+                Sim_Fault ( sm , instruction , "wait pin" );
+            }
+            break;
+
+        case 3:     // out , autopull refilling an empty OSR first
+            Count = ( 0 == Index ) ? 32 : Index;
+
+            if ( State->Config.autopull && ( State->OSRCount >= Threshold ) )
+            {
+                Done            = Sim_Pop ( State , &State->OSR );
+                State->OSRCount = Done ? 0 : State->OSRCount;
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            if ( Done )
+            {
+                if ( State->Config.out_shift_right )
+                {
+                    Data        = ( 32 == Count ) ? State->OSR : ( State->OSR & ( ( 1u << Count ) - 1 ) );
+                    State->OSR  = ( 32 == Count ) ? 0 : ( State->OSR >> Count );
+                }
+                else
+                {
+                    Data        = ( 32 == Count ) ? State->OSR : ( State->OSR >> ( 32 - Count ) );
+                    State->OSR  = ( 32 == Count ) ? 0 : ( State->OSR << Count );
+                }
+
+                State->OSRCount = ( uint8_t ) ( ( ( State->OSRCount + Count ) > 32 ) ? 32 : ( State->OSRCount + Count ) );
+
+                switch ( ( instruction >> 5 ) & 7 )
+                {
+                    case 0:  Sim_Drive ( State->Config.out_base , State->Config.out_count , Data , false ); break;
+                    case 1:  State->X = Data;                                  break;
+                    case 2:  State->Y = Data;                                  break;
+                    case 3:                                                    break;
+                    case 4:  Sim_Drive ( State->Config.out_base , State->Config.out_count , Data , true  ); break;
+                    case 5:  State->PC = ( uint8_t ) ( Data & 0x1F ); Jumped = true; break;
+                    default: Sim_Fault ( sm , instruction , "out isr or exec" ); break;
+                }
+            }
+            else
+            {
+                // Nothing to do
+            }
+            break;
+
+        case 4:     // pull , push is not modelled
+            if ( 0 == ( instruction & 0x80 ) )
+            {
+                Sim_Fault ( sm , instruction , "push" );
+            }
+            else if ( ( instruction & 0x40 ) && ( State->OSRCount < Threshold ) )
+            {
+                // Nothing to do
+            }
+            else if ( Sim_Pop ( State , &Word ) )
+            {
+                State->OSR      = Word;
+                State->OSRCount = 0;
+            }
+            else if ( instruction & 0x20 )
+            {
+                Done = false;
+            }
+            else
+            {
+                State->OSR      = State->X;
+                State->OSRCount = 0;
+            }
+            break;
+
+        case 5:     // mov
+            Data = Sim_Source ( State , instruction & 7 );
+
+            if ( 1 == ( ( instruction >> 3 ) & 3 ) )
+            {
+                Data = ~Data;
+            }
+            else if ( 2 == ( ( instruction >> 3 ) & 3 ) )
+            {
+                for ( Counter_Bit = 0 ; Counter_Bit < 32 ; Counter_Bit++ )
+                {
+                    Word |= ( ( Data >> Counter_Bit ) & 1 ) << ( 31 - Counter_Bit );
+                }
+
+                Data = Word;
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            switch ( ( instruction >> 5 ) & 7 )
+            {
+                case 0:  Sim_Drive ( State->Config.out_base , State->Config.out_count , Data , false ); break;
+                case 1:  State->X = Data;                                      break;
+                case 2:  State->Y = Data;                                      break;
+                case 5:  State->PC = ( uint8_t ) ( Data & 0x1F ); Jumped = true; break;
+                case 6:  State->ISR = Data;                                    break;
+                case 7:  State->OSR = Data; State->OSRCount = 0;               break;
+                default: Sim_Fault ( sm , instruction , "mov exec" );          break;
+            }
+            break;
+
+        case 6:     // irq , with wait holding until another state machine clears it
+            if ( instruction & 0x40 )
+            {
+                Sim_IrqClear |= ( uint8_t ) ( 1u << Sim_IrqIndex ( sm , Index ) );
+            }
+            else if ( ( instruction & 0x20 ) && State->IrqWait )
+            {
+                Done           = !( ( Sim_Irq >> Sim_IrqIndex ( sm , Index ) ) & 1 );
+                State->IrqWait = !Done;
+            }
+            else
+            {
+                Sim_IrqSet    |= ( uint8_t ) ( 1u << Sim_IrqIndex ( sm , Index ) );
+                State->IrqWait = ( instruction & 0x20 ) ? true : false;
+                Done           = !State->IrqWait;
+            }
+            break;
+
+        case 7:     // set
+            switch ( ( instruction >> 5 ) & 7 )
+            {
+                case 0:  Sim_Drive ( State->Config.set_base , State->Config.set_count , Index , false ); break;
+                case 1:  State->X = Index;                                     break;
+                case 2:  State->Y = Index;                                     break;
+                case 4:  Sim_Drive ( State->Config.set_base , State->Config.set_count , Index , true  ); break;
+                default: Sim_Fault ( sm , instruction , "set" );               break;
+            }
+            break;
+
+        default:    // in
+            Sim_Fault ( sm , instruction , "in" );
+            break;
+    }
+
+    if ( Done && !exec )
+    {
+        State->Delay = ( uint8_t ) ( Field & ( ( 1u << ( 5 - Bits ) ) - 1 ) );
+        State->PC    = Jumped ? State->PC : ( ( State->PC == State->Config.wrap ) ? State->Config.wrap_target : ( uint8_t ) ( ( State->PC + 1 ) % SIM_MEMORY ) );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Done;
+}
+
+static void Sim_Fault ( uint sm , uint16_t instruction , const char *what )
+{
+    fprintf ( stderr , "pio: sm %u at %u runs %04X , %s is not modelled\n" , sm , Sim_SMs [ sm ].PC , instruction , what );
+    Sim_FaultCount++;
+}
+
+// Flags 0 to 3 offset by the state machine number when rel is set
+static uint Sim_IrqIndex ( uint sm , uint index )
+{
+    return ( index & 0x10 ) ? ( ( index & 4 ) | ( ( index + sm ) & 3 ) ) : ( index & 7 );
+}
+
+static bool Sim_Pop ( Sim_SM_t *state , uint32_t *word )
+{
+    uint Depth = ( PIO_FIFO_JOIN_TX == state->Config.fifo_join ) ? ( SIM_FIFO_DEPTH * 2 ) : SIM_FIFO_DEPTH;
+    bool Done  = ( state->FifoCount > 0 );
+
+    if ( Done )
+    {
+        *word            = state->Fifo [ state->FifoHead ];
+        state->FifoHead  = ( state->FifoHead + 1 ) % Depth;
+        state->FifoCount--;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Done;
+}
+
+static uint32_t Sim_Source ( Sim_SM_t *state , uint source )
+{
+    uint32_t Data = 0;
+
+    switch ( source )
+    {
+        case 0:  Data = Sim_Levels; break;
+        case 1:  Data = state->X;   break;
+        case 2:  Data = state->Y;   break;
+        case 6:  Data = state->ISR; break;
+        case 7:  Data = state->OSR; break;
+        default: Data = 0;          break;  // null , status reads as empty
+    }
+
+    return Data;
+}
+
+// Pico SDK stand-ins
+pio_sm_config pio_get_default_sm_config ( void )
+{
+    pio_sm_config Config = { 0 };
+
+    Config.clkdiv          = 256;
+    Config.wrap            = SIM_MEMORY - 1;
+    Config.out_count       = 32;
+    Config.out_shift_right = true;
+
+    return Config;
+}
+
+// Placed at the highest free slots as the SDK does , jumps relocated
+uint pio_add_program ( PIO pio , const pio_program_t *program )
+{
+    uint32_t Mask          = ( ( 32 == program->length ) ? 0xFFFFFFFFu : ( ( 1u << program->length ) - 1 ) );
+    uint     Offset        = SIM_MEMORY - program->length;
+    uint     Counter_Instr = 0;
+
+    while ( ( Offset > 0 ) && ( Sim_Used & ( Mask << Offset ) ) )
+    {
+        Offset--;
+    }
+
+    Sim_Used |= Mask << Offset;
+
+    for ( Counter_Instr = 0 ; Counter_Instr < program->length ; Counter_Instr++ )
+    {
+        Sim_Memory [ Offset + Counter_Instr ] = program->instructions [ Counter_Instr ] + ( ( 0 == ( program->instructions [ Counter_Instr ] & 0xE000 ) ) ? Offset : 0 );
+    }
+
+    return Offset;
+}
+
+int pio_claim_unused_sm ( PIO pio , bool required )
+{
+    int Counter_SM = 0;
+
+    while ( ( Counter_SM < PIO_SM_COUNT ) && Sim_SMs [ Counter_SM ].Claimed )
+    {
+        Counter_SM++;
+    }
+
+    if ( Counter_SM < PIO_SM_COUNT )
+    {
+        Sim_SMs [ Counter_SM ].Claimed = true;
+    }
+    else
+    {
+        Counter_SM = -1;
+    }
+
+    return Counter_SM;
+}
+
+uint pio_encode_mov ( enum pio_src_dest dest , enum pio_src_dest src )
+{
+    return 0xA000 | ( ( dest & 7u ) << 5 ) | ( src & 7u );
+}
+
+uint pio_encode_out ( enum pio_src_dest dest , uint count )
+{
+    return 0x6000 | ( ( dest & 7u ) << 5 ) | ( count & 0x1F );
+}
+
+uint pio_encode_pull ( bool if_empty , bool block )
+{
+    return 0x8080 | ( if_empty ? 0x40 : 0 ) | ( block ? 0x20 : 0 );
+}
+
+// Clock dividers restart together and the cycle count from zero
+void pio_enable_sm_mask_in_sync ( PIO pio , uint32_t mask )
+{
+    uint Counter_SM = 0;
+
+    for ( Counter_SM = 0 ; Counter_SM < PIO_SM_COUNT ; Counter_SM++ )
+    {
+        Sim_SMs [ Counter_SM ].Enabled = Sim_SMs [ Counter_SM ].Enabled || ( mask & ( 1u << Counter_SM ) );
+        Sim_SMs [ Counter_SM ].Divider = 0;
+    }
+
+    Sim_Cycle = 0;
+    Sim_Quiet = 0;
+}
+
+uint pio_get_dreq ( PIO pio , uint sm , bool tx )
+{
+    return sm;
+}
+
+void pio_gpio_init ( PIO pio , uint pin )
+{
+    Sim_Function |= 1u << pin;
+}
+
+// Runs at once , an instruction that would stall is a fault
+void pio_sm_exec ( PIO pio , uint sm , uint instr )
+{
+    if ( !Sim_Execute ( sm , ( uint16_t ) instr , true ) )
+    {
+        Sim_Fault ( sm , ( uint16_t ) instr , "a stalling exec" );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+void pio_sm_init ( PIO pio , uint sm , uint initial_pc , const pio_sm_config *config )
+{
+    Sim_SM_t *State = &Sim_SMs [ sm ];
+
+    State->Config    = *config;
+    State->Enabled   = false;
+    State->FifoCount = 0;
+    State->FifoHead  = 0;
+    State->ISR       = 0;
+    State->OSRCount  = 32;
+    State->Delay     = 0;
+    State->IrqWait   = false;
+    State->PC        = ( uint8_t ) initial_pc;
+}
+
+void pio_sm_put_blocking ( PIO pio , uint sm , uint32_t data )
+{
+    Sim_SM_t *State = &Sim_SMs [ sm ];
+    uint      Depth = ( PIO_FIFO_JOIN_TX == State->Config.fifo_join ) ? ( SIM_FIFO_DEPTH * 2 ) : SIM_FIFO_DEPTH;
+
+    if ( State->FifoCount < Depth )
+    {
+        State->Fifo [ ( State->FifoHead + State->FifoCount ) % Depth ] = data;
+        State->FifoCount++;
+    }
+    else
+    {
+        Sim_Fault ( sm , 0 , "a put to a full FIFO" );
+    }
+}
+
+void pio_sm_set_pindirs_with_mask ( PIO pio , uint sm , uint32_t dirs , uint32_t mask )
+{
+    Sim_Dirs = ( Sim_Dirs & ~( mask & Sim_Function ) ) | ( dirs & mask & Sim_Function );
+}
+
+void pio_sm_set_pins_with_mask ( PIO pio , uint sm , uint32_t values , uint32_t mask )
+{
+    Sim_Levels = ( Sim_Levels & ~( mask & Sim_Function ) ) | ( values & mask & Sim_Function );
+}
+
+void sm_config_set_clkdiv ( pio_sm_config *c , float div )
+{
+    c->clkdiv = ( uint32_t ) ( div * 256.0f );
+}
+
+void sm_config_set_fifo_join ( pio_sm_config *c , enum pio_fifo_join join )
+{
+    c->fifo_join = ( uint8_t ) join;
+}
+
+void sm_config_set_out_pins ( pio_sm_config *c , uint out_base , uint out_count )
+{
+    c->out_base  = ( uint8_t ) out_base;
+    c->out_count = ( uint8_t ) out_count;
+}
+
+void sm_config_set_out_shift ( pio_sm_config *c , bool shift_right , bool autopull , uint pull_threshold )
+{
+    c->out_shift_right = shift_right;
+    c->autopull        = autopull;
+    c->pull_threshold  = ( uint8_t ) ( pull_threshold & 0x1F );
+}
+
+void sm_config_set_set_pins ( pio_sm_config *c , uint set_base , uint set_count )
+{
+    c->set_base  = ( uint8_t ) set_base;
+    c->set_count = ( uint8_t ) set_count;
+}
+
+void sm_config_set_sideset ( pio_sm_config *c , uint bit_count , bool optional , bool pindirs )
+{
+    c->sideset_bits    = ( uint8_t ) bit_count;
+    c->sideset_opt     = optional;
+    c->sideset_pindirs = pindirs;
+}
+
+void sm_config_set_sideset_pins ( pio_sm_config *c , uint sideset_base )
+{
+    c->sideset_base = ( uint8_t ) sideset_base;
+}
+
+void sm_config_set_wrap ( pio_sm_config *c , uint wrap_target , uint wrap )
+{
+    c->wrap_target = ( uint8_t ) wrap_target;
+    c->wrap        = ( uint8_t ) wrap;
+}
+
+/*** end of file ***/
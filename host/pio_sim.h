@@ -0,0 +1,43 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           pio_sim.h                                             *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __PIO_SIM_H
+#define __PIO_SIM_H
+
+#include <main.h>
+
+// RP2040 PIO block for the host checks. The hardware/pio.h stand-ins load
+// and configure state machines as the Pico SDK would , then Sim_Step runs
+// the instructions pioasm assembled one system clock at a time : clock
+// dividers , side-set ( applied while stalled ) , delays , wrap , autopull ,
+// the shared IRQ flags and the pins each state machine drives. Sim_Feed
+// stands in for a DMA channel paced by the TX FIFO.
+//
+// Not modelled : in , push , mov from status , wait on a mapped pin , the
+// RX FIFO and interrupts to the processors. Any of these counts a fault.
+#define SIM_FIFO_DEPTH      4       // Words , doubled by PIO_FIFO_JOIN_TX
+
+uint64_t Sim_Cycles ( void );       // System clocks since the state machines were enabled
+uint32_t Sim_Faults ( void );
+void     Sim_Feed   ( uint sm , const uint32_t *words , uint count );
+uint32_t Sim_Pins   ( void );       // GPIO levels , pins no state machine drives stay as set
+bool     Sim_Step   ( void );       // False once every state machine waits on nothing that can come
+
+#endif /* __PIO_SIM_H */
+
+/*** end of file ***/
@@ -0,0 +1,336 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           protocol_check.c                                      *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <main.h>
+#include <protocol.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Protocol v2 loopback against protocol.c on its own. A stand-in test bed
+// echoes each request one transaction later , as on the wire , and a
+// scripted set of replies is damaged on the way back : a flipped bit , a
+// dropped byte , a frame cut short , one shifted along the transaction and
+// runs of damaged replies either side of PROTOCOL_V2_ATTEMPTS. Each damaged
+// reply must be counted , the next good one must be taken up and matched
+// to its request , and the link must stay in v2 until a run of
+// PROTOCOL_V2_ATTEMPTS.
+//
+// After the fall back the test bed stays silent , as one still powering
+// up , and then answers in v2 from LOOP_RETURN on. The first v2 probe finds
+// it silent and must fall back after its one transaction , the second is
+// answered and the link must stay in v2. Exits non-zero on any failure.
+#define LOOP_TRANSACTIONS       96
+#define LOOP_PAYLOAD            6       // ECHO payload bytes
+
+// Transactions after the fall back , the test bed answers again between the
+// first and second probe
+#define LOOP_RETURN             ( PROTOCOL_V2_PROBE + 4 )
+#define LOOP_RETURN_PROBE       ( ( 2 * PROTOCOL_V2_PROBE ) + 2 )   // First transaction of the probe that is answered
+#define LOOP_RETURN_TRANSACTIONS ( 3 * PROTOCOL_V2_PROBE )
+
+// Damage to the reply clocked in by a transaction
+#define LOOP_CLEAN              0
+#define LOOP_FLIP               1       // One payload bit inverted
+#define LOOP_DROP               2       // A payload byte lost , the rest of the frame one early
+#define LOOP_TRUNCATE           3       // Cut off after the header , the rest zero
+#define LOOP_SHIFT              4       // Two bytes of line noise ahead of the frame , still good
+#define LOOP_SILENT             5       // Nothing back
+
+typedef struct
+{
+    uint8_t First;      // Transactions First to First + Count - 1
+    uint8_t Count;
+    uint8_t Damage;
+} Loop_Fault_t;
+
+// A burst of PROTOCOL_V2_ATTEMPTS - 1 stays in v2 , the run of
+// PROTOCOL_V2_ATTEMPTS at the end falls back
+static const Loop_Fault_t Loop_Faults [ ] = {
+    { 10 , 1                          , LOOP_FLIP     } ,
+    { 20 , 1                          , LOOP_DROP     } ,
+    { 30 , 1                          , LOOP_TRUNCATE } ,
+    { 40 , 1                          , LOOP_SHIFT    } ,
+    { 50 , PROTOCOL_V2_ATTEMPTS - 1   , LOOP_SILENT   } ,
+    { 70 , 2                          , LOOP_FLIP     } ,
+    { 72 , 1                          , LOOP_DROP     } ,
+    { 80 , PROTOCOL_V2_ATTEMPTS       , LOOP_SILENT   } ,
+};
+
+#define LOOP_FALLBACK           80      // First transaction of the run that falls back
+
+static uint8_t Loop_Damage ( uint8_t transaction );
+static void    Loop_Reply  ( const uint8_t *tx , uint8_t *reply );
+
+int main ( int argc , char **argv )
+{
+    Protocol_Frame_t Frame;
+    uint8_t          Tx      [ PROTOCOL_FRAME_LENGTH ];
+    uint8_t          Rx      [ PROTOCOL_FRAME_LENGTH ];
+    uint8_t          Reply   [ PROTOCOL_FRAME_LENGTH ];    // To the last request , clocked out next
+    uint8_t          Payload [ LOOP_PAYLOAD ];
+    uint32_t         Failed              = 0;
+    uint32_t         Damaged             = 0;
+    uint32_t         CRC_Expected        = 0;
+    uint32_t         Sync_Expected       = 0;
+    uint8_t          Damage              = LOOP_CLEAN;
+    uint8_t          Sent                = 0;   // Sequence number of the request the reply answers
+    uint32_t         Returned            = 0;   // Good replies after the test bed came back
+    uint8_t          Counter_Byte        = 0;
+    uint8_t          Counter_Return      = 0;
+    uint8_t          Counter_Transaction = 0;
+    bool             Answering           = false;
+    bool             Held                = false;   // A v2 reply is due back
+    bool             V2                  = false;
+    bool             Valid               = false;
+
+    memset ( Reply , 0 , sizeof ( Reply ) );
+
+    // Until the fall back , the rest is the original exchange and not this check's
+    for ( Counter_Transaction = 0 ; ( Counter_Transaction < LOOP_TRANSACTIONS ) && !Protocol_Legacy ( 0 ) ; Counter_Transaction++ )
+    {
+        for ( Counter_Byte = 0 ; Counter_Byte < LOOP_PAYLOAD ; Counter_Byte++ )
+        {
+            Payload [ Counter_Byte ] = ( uint8_t ) ( ( Counter_Transaction * 37 ) + ( Counter_Byte * 11 ) );
+        }
+
+        Sent = Protocol_Next ( ) - 1;
+        Protocol_Request ( PROTOCOL_OP_ECHO , Payload , LOOP_PAYLOAD , Tx );
+
+        // The test bed shifts out its reply to the last request while this one comes in
+        Damage = ( 0 != Counter_Transaction ) ? Loop_Damage ( Counter_Transaction ) : LOOP_SILENT;
+        memset ( Rx , 0 , sizeof ( Rx ) );
+
+        if ( LOOP_CLEAN == Damage )
+        {
+            memcpy ( Rx , Reply , sizeof ( Rx ) );
+        }
+        else if ( LOOP_FLIP == Damage )
+        {
+            memcpy ( Rx , Reply , sizeof ( Rx ) );
+            Rx [ PROTOCOL_HEADER_LENGTH + 2 ] ^= 0x10;
+            CRC_Expected++;
+        }
+        else if ( LOOP_DROP == Damage )
+        {
+            memcpy ( Rx , Reply , PROTOCOL_HEADER_LENGTH + 1 );
+            memcpy ( &Rx [ PROTOCOL_HEADER_LENGTH + 1 ] , &Reply [ PROTOCOL_HEADER_LENGTH + 2 ] , sizeof ( Rx ) - PROTOCOL_HEADER_LENGTH - 2 );
+            CRC_Expected++;
+        }
+        else if ( LOOP_TRUNCATE == Damage )
+        {
+            memcpy ( Rx , Reply , PROTOCOL_HEADER_LENGTH );
+            CRC_Expected++;
+        }
+        else if ( LOOP_SHIFT == Damage )
+        {
+            Rx [ 0 ] = 0xFF;
+            Rx [ 1 ] = SYNC_BYTE;
+            memcpy ( &Rx [ 2 ] , Reply , sizeof ( Rx ) - 2 );
+        }
+        else    // LOOP_SILENT
+        {
+            // Nothing to do
+        }
+
+        Valid = Protocol_Receive ( Rx , sizeof ( Rx ) , &Frame );
+
+        if ( ( LOOP_CLEAN == Damage ) || ( LOOP_SHIFT == Damage ) )
+        {
+            if ( !Valid || ( PROTOCOL_OP_ECHO != Frame.Opcode ) || ( Sent != Frame.Sequence ) || ( 0 != memcmp ( Frame.Payload , &Reply [ PROTOCOL_HEADER_LENGTH ] , LOOP_PAYLOAD ) ) )
+            {
+                fprintf ( stderr , "transaction %u : good reply to %u not taken up\n" , Counter_Transaction , Sent );
+                Failed++;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+        else
+        {
+            Damaged += ( 0 != Counter_Transaction ) ? 1 : 0;
+            Sync_Expected++;
+
+            if ( Valid )
+            {
+                fprintf ( stderr , "transaction %u : damaged reply taken as good\n" , Counter_Transaction );
+                Failed++;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+
+        if ( Protocol_Legacy ( 0 ) != ( Counter_Transaction >= ( LOOP_FALLBACK + PROTOCOL_V2_ATTEMPTS - 1 ) ) )
+        {
+            fprintf ( stderr , "transaction %u : %s\n" , Counter_Transaction , Protocol_Legacy ( 0 ) ? "fell back to legacy" : "still v2" );
+            Failed++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Loop_Reply ( Tx , Reply );
+    }
+
+    if ( Counter_Transaction != ( LOOP_FALLBACK + PROTOCOL_V2_ATTEMPTS ) )
+    {
+        fprintf ( stderr , "stopped after %u transactions , fall back expected after %u\n" , Counter_Transaction , LOOP_FALLBACK + PROTOCOL_V2_ATTEMPTS );
+        Failed++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( ( Protocol_Stats.CRC_Errors != CRC_Expected ) || ( Protocol_Stats.Sync_Errors != Sync_Expected ) || ( 0 != Protocol_Stats.Unmatched ) )
+    {
+        fprintf ( stderr , "counted %u CRC errors ( %u expected ) , %u sync errors ( %u expected ) , %u unmatched\n" ,
+                  Protocol_Stats.CRC_Errors , CRC_Expected , Protocol_Stats.Sync_Errors , Sync_Expected , Protocol_Stats.Unmatched );
+        Failed++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    // Silent , then back in v2
+    for ( Counter_Return = 0 ; Counter_Return < LOOP_RETURN_TRANSACTIONS ; Counter_Return++ )
+    {
+        Answering = ( Counter_Return >= LOOP_RETURN );
+        V2        = ( ( Counter_Return >= PROTOCOL_V2_PROBE ) && ( Counter_Return < ( PROTOCOL_V2_PROBE + 2 ) ) ) || ( Counter_Return >= LOOP_RETURN_PROBE );
+
+        if ( Protocol_Legacy ( 0 ) == V2 )
+        {
+            fprintf ( stderr , "return %u : %s\n" , Counter_Return , V2 ? "still legacy" : "still v2" );
+            Failed++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        memset ( Rx , 0 , sizeof ( Rx ) );
+
+        if ( Protocol_Legacy ( 0 ) )    // A v2 test bed does not answer the original exchange
+        {
+            Protocol_Request ( PROTOCOL_OP_STATUS , NULL , 0 , Tx );
+            Held = false;
+
+            if ( Protocol_Receive ( Rx , PROTOCOL_LEGACY_LENGTH , &Frame ) )
+            {
+                fprintf ( stderr , "return %u : silent legacy read taken as good\n" , Counter_Return );
+                Failed++;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+        else
+        {
+            Sent = Protocol_Next ( ) - 1;
+            Protocol_Request ( PROTOCOL_OP_ECHO , Payload , LOOP_PAYLOAD , Tx );
+            memcpy ( Rx , Reply , sizeof ( Rx ) );
+
+            // The first transaction of a probe has nothing due back
+            Valid = Held && Protocol_Receive ( Rx , sizeof ( Rx ) , &Frame );
+
+            if ( Held && ( Valid != Answering ) )
+            {
+                fprintf ( stderr , "return %u : %s\n" , Counter_Return , Valid ? "reply from a silent test bed" : "good reply not taken up" );
+                Failed++;
+            }
+            else if ( Valid && ( ( PROTOCOL_OP_ECHO != Frame.Opcode ) || ( Sent != Frame.Sequence ) ) )
+            {
+                fprintf ( stderr , "return %u : reply does not match request %u\n" , Counter_Return , Sent );
+                Failed++;
+            }
+            else
+            {
+                Returned += Valid ? 1 : 0;
+            }
+
+            Held = true;
+
+            if ( Answering )
+            {
+                Loop_Reply ( Tx , Reply );
+            }
+            else
+            {
+                memset ( Reply , 0 , sizeof ( Reply ) );
+            }
+        }
+    }
+
+    if ( ( 2 != Protocol_Stats.Probes ) || ( Returned != ( LOOP_RETURN_TRANSACTIONS - LOOP_RETURN_PROBE - 1 ) ) )
+    {
+        fprintf ( stderr , "%u v2 probes ( 2 expected ) , %u replies after the return ( %u expected )\n" ,
+                  Protocol_Stats.Probes , Returned , LOOP_RETURN_TRANSACTIONS - LOOP_RETURN_PROBE - 1 );
+        Failed++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    printf ( "protocol   %u transactions , %u damaged , %u frames , %u CRC errors , %u sync errors , %u lost , %u v2 probes , %u failed\n" ,
+             Counter_Transaction + Counter_Return , Damaged , Protocol_Stats.Frames , Protocol_Stats.CRC_Errors , Protocol_Stats.Sync_Errors ,
+             Protocol_Stats.Lost , Protocol_Stats.Probes , Failed );
+
+    return ( 0 == Failed ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static uint8_t Loop_Damage ( uint8_t transaction )
+{
+    uint8_t Damage        = LOOP_CLEAN;
+    uint8_t Counter_Fault = 0;
+
+    for ( Counter_Fault = 0 ; Counter_Fault < ( sizeof ( Loop_Faults ) / sizeof ( Loop_Faults [ 0 ] ) ) ; Counter_Fault++ )
+    {
+        if ( ( transaction >= Loop_Faults [ Counter_Fault ].First ) && ( transaction < ( Loop_Faults [ Counter_Fault ].First + Loop_Faults [ Counter_Fault ].Count ) ) )
+        {
+            Damage = Loop_Faults [ Counter_Fault ].Damage;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Damage;
+}
+
+// The test bed's echo of a request , header and payload as sent with its own CRC
+static void Loop_Reply ( const uint8_t *tx , uint8_t *reply )
+{
+    uint16_t CRC    = 0;
+    uint8_t  Length = tx [ 2 ];
+
+    memset ( reply , 0 , PROTOCOL_FRAME_LENGTH );
+    memcpy ( reply , tx , PROTOCOL_HEADER_LENGTH + Length );
+
+    CRC = Protocol_CRC16 ( &reply [ 1 ] , PROTOCOL_HEADER_LENGTH - 1 + Length );
+    reply [ PROTOCOL_HEADER_LENGTH + Length     ] = ( uint8_t ) ( CRC >> 8 );
+    reply [ PROTOCOL_HEADER_LENGTH + Length + 1 ] = ( uint8_t ) CRC;
+}
+
+/*** end of file ***/
@@ -0,0 +1,282 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           report.c                                              *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <host.h>
+#include <batch.h>
+#include <beds.h>
+#include <bench.h>
+#include <buttons.h>
+#include <check.h>
+#include <hub75.h>
+#include <link.h>
+#include <matrix.h>
+#include <matrix_layout.h>
+#include <protocol.h>
+#include <ready.h>
+#include <readings.h>
+#include <scheduler.h>
+#include <spi_link.h>
+#include <testbed.h>
+#include <text.h>
+
+#include <stdlib.h>
+
+// Core 0 tasks , main.c
+extern Task_t Task_Compose;
+extern Task_t Task_Heartbeat;
+extern Task_t Task_Link;
+extern Task_t Task_Poll;
+extern Task_t Task_Readings;
+extern Task_t Task_Watchdog;
+
+static bool Report_Mute    ( uint8_t bed );
+static void Report_Task    ( const Task_t *task );
+static bool Report_Unknown ( uint slot );
+static void Report_Text    ( void );
+
+// With HOST_BENCH=1 a refresh slower than HUB75_REFRESH_MIN_HZ fails the
+// run , with HOST_LATENCY_US a data ready to panel latency above it does ,
+// and with HOST_MUTE a panel that does not show the muted bed as unknown
+void Host_Report ( void )
+{
+    const char    *Bench   = getenv ( "HOST_BENCH"      );
+    const char    *Latency = getenv ( "HOST_LATENCY_US" );
+    Hub75_Timing_t Timing;
+
+    if ( ( NULL != Bench ) && ( '1' == Bench [ 0 ] ) )     // Machine readable only
+    {
+        Bench_Report ( );
+        Hub75_Timing ( &Timing );
+
+        if ( ( Timing.Shift + Timing.Latch + Timing.Dwell ) > ( Hal_ClockHz ( ) / HUB75_REFRESH_MIN_HZ ) )
+        {
+            fprintf ( stderr , "bench: %u x %u pixels refresh below %u Hz\n" , MATRIX_WIDTH , MATRIX_HEIGHT , HUB75_REFRESH_MIN_HZ );
+            exit ( EXIT_FAILURE );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        Report_Text ( );
+    }
+
+    if ( ( NULL != Latency ) && ( Ready_Stats.LatencyMax > ( uint32_t ) strtoul ( Latency , NULL , 0 ) ) )
+    {
+        fprintf ( stderr , "latency: %u test beds , %u us max above %s us\n" , TESTBED_COUNT , Ready_Stats.LatencyMax , Latency );
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( ( Testbed_Muted ( ) >= 0 ) && !Report_Mute ( ( uint8_t ) Testbed_Muted ( ) ) )
+    {
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Every tile of the muted bed shows unknown on the panel and no tile of the
+// others does , read back from the shown frame
+static bool Report_Mute ( uint8_t bed )
+{
+    uint Unknown      = 0;
+    uint Others       = 0;
+    uint Counter_Slot = 0;
+
+    for ( Counter_Slot = 0 ; Counter_Slot < MATRIX_SLOTS ; Counter_Slot++ )
+    {
+        if ( !Report_Unknown ( Counter_Slot ) )
+        {
+            // Nothing to do
+        }
+        else if ( ( Counter_Slot / SENSOR_COUNT ) == bed )
+        {
+            Unknown++;
+        }
+        else
+        {
+            Others++;
+        }
+    }
+
+    printf ( "mute       bed %u , %u of %u tiles unknown , %u unknown on the other beds\n" , bed , Unknown , SENSOR_COUNT , Others );
+
+    return ( SENSOR_COUNT == Unknown ) && ( 0 == Others );
+}
+
+// True if slot's tile is the unknown chase : blue only , one pixel brighter
+// than the rest , which all match
+static bool Report_Unknown ( uint slot )
+{
+    const Tile_t *Tile           = &MatrixTile [ slot ];
+    uint32_t      First          = Hub75_Host_Pixel ( Tile->Row , Tile->Column     );
+    uint32_t      Second         = Hub75_Host_Pixel ( Tile->Row , Tile->Column + 1 );
+    uint32_t      Dim            = ( First < Second ) ? First : Second;    // Only one pixel is bright
+    uint32_t      Bright         = Dim;
+    uint32_t      Pixel          = 0;
+    uint          Brighter       = 0;
+    bool          Unknown        = ( 0 == ( Dim & 0xFFFF00 ) );
+    uint          Counter_Row    = 0;
+    uint          Counter_Column = 0;
+
+    for ( Counter_Row = 0 ; Counter_Row < TILE_HEIGHT ; Counter_Row++ )
+    {
+        for ( Counter_Column = 0 ; Counter_Column < TILE_WIDTH ; Counter_Column++ )
+        {
+            Pixel = Hub75_Host_Pixel ( Tile->Row + Counter_Row , Tile->Column + Counter_Column );
+
+            if ( Pixel == Dim )
+            {
+                // Nothing to do
+            }
+            else if ( Pixel > Dim )
+            {
+                Bright = Pixel;
+                Brighter++;
+            }
+            else
+            {
+                Unknown = false;
+            }
+        }
+    }
+
+    return Unknown && ( 1 == Brighter ) && ( 0 == ( Bright & 0xFFFF00 ) );
+}
+
+static void Report_Text ( void )
+{
+    uint64_t Now         = Hal_Micros64 ( );
+    uint64_t Frames      = 0;
+    uint64_t Commands    = 0;
+    uint     Counter_Bed = 0;
+    uint     Counter_Bin = 0;
+
+    printf ( "run        %llu ms , %u events , %u sleeps , %u output edges , %u frames\n" ,
+             ( unsigned long long ) ( Now / 1000 ) , Host_Stats.Events , Host_Stats.Sleeps , Host_Stats.Edges , Hub75_Host_Frames ( ) );
+
+    printf ( "scheduler  idle %llu us ( %u%% ) , %u sleeps\n" ,
+             ( unsigned long long ) Scheduler_Stats.Idle , ( uint ) ( ( Scheduler_Stats.Idle * 100 ) / ( Now ? Now : 1 ) ) , Scheduler_Stats.Sleeps );
+    Report_Task ( &Task_Watchdog  );
+    Report_Task ( &Task_Link      );
+    Report_Task ( &Task_Poll      );
+    Report_Task ( &Task_Readings  );
+    Report_Task ( &Task_Compose   );
+    Report_Task ( &Task_Heartbeat );
+
+    for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
+    {
+        if ( 1 == TESTBED_COUNT )
+        {
+            printf ( "link       " );
+        }
+        else
+        {
+            printf ( "link %-5u " , Counter_Bed );
+        }
+
+        printf ( "%s , %u Hz ( step %u , trained %u ) , %u transactions , %u errors , %u retries , %u step downs\n" ,
+                 Protocol_Legacy ( Counter_Bed ) ? "legacy" : "v2" , Link_Stats [ Counter_Bed ].Baud , Link_Stats [ Counter_Bed ].Step ,
+                 Link_Stats [ Counter_Bed ].StepTrained , Link_Stats [ Counter_Bed ].Transactions , Link_Stats [ Counter_Bed ].Errors ,
+                 Link_Stats [ Counter_Bed ].Retries , Link_Stats [ Counter_Bed ].StepDowns );
+    }
+
+    for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
+    {
+        printf ( "bed %-6u %u statuses , age %u us ( max %u ) , %u stale\n" ,
+                 Counter_Bed , Beds_Stats [ Counter_Bed ].Statuses , Beds_Stats [ Counter_Bed ].Age , Beds_Stats [ Counter_Bed ].AgeMax , Beds_Stats [ Counter_Bed ].Stale );
+    }
+    printf ( "protocol   %u frames , %u CRC errors , %u sync errors , %u lost , %u unmatched , %u v2 probes\n" ,
+             Protocol_Stats.Frames , Protocol_Stats.CRC_Errors , Protocol_Stats.Sync_Errors , Protocol_Stats.Lost , Protocol_Stats.Unmatched ,
+             Protocol_Stats.Probes );
+    printf ( "spi        %u completed , %u timeouts , %u us last , %u us max\n" ,
+             SPI_Stats.Completed , SPI_Stats.Timeouts , SPI_Stats.Duration , SPI_Stats.DurationMax );
+    printf ( "batch      %u batches , %u items , %u acknowledged , %u resent , %u lost\n" ,
+             Batch_Stats.Batches , Batch_Stats.Items , Batch_Stats.Acknowledged , Batch_Stats.Resent , Batch_Stats.Lost );
+
+    // Frames are link transactions , commands are buttons acknowledged plus status reads
+    for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
+    {
+        Frames   += Link_Stats [ Counter_Bed ].Transactions;
+        Commands += Beds_Stats [ Counter_Bed ].Statuses;
+    }
+    Commands += Batch_Stats.Acknowledged;
+    printf ( "throughput %llu frames/s , %llu commands/s , %llu.%02llu commands per frame\n" ,
+             ( unsigned long long ) ( ( Frames * 1000000 ) / ( Now ? Now : 1 ) ) , ( unsigned long long ) ( ( Commands * 1000000 ) / ( Now ? Now : 1 ) ) ,
+             ( unsigned long long ) ( Commands / ( Frames ? Frames : 1 ) ) , ( unsigned long long ) ( ( ( Commands * 100 ) / ( Frames ? Frames : 1 ) ) % 100 ) );
+    printf ( "buttons    %u edges , %u events , %u sent , %u dropped , latency %u us ( max %u )\n" ,
+             Buttons_Stats.Edges , Buttons_Stats.Events , Buttons_Stats.Sent , Buttons_Stats.Dropped ,
+             Buttons_Stats.Latency , Buttons_Stats.LatencyMax );
+    printf ( "ready      %u events , %u coalesced , %u shown , %u unchanged , latency %u us ( max %u )\n" ,
+             Ready_Stats.Events , Ready_Stats.Coalesced , Ready_Stats.Shown , Ready_Stats.Unchanged ,
+             Ready_Stats.Latency , Ready_Stats.LatencyMax );
+
+    for ( Counter_Bin = 0 ; Counter_Bin < READY_HISTOGRAM_BINS ; Counter_Bin++ )
+    {
+        if ( 0 != Ready_Stats.Histogram [ Counter_Bin ] )
+        {
+            printf ( "             %7u - %7u us : %u\n" , 1u << Counter_Bin , ( 2u << Counter_Bin ) - 1 , Ready_Stats.Histogram [ Counter_Bin ] );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    printf ( "readings   %u requests , %u replies , %u values ( %u as changes ) , %u mismatched\n" ,
+             Readings_Stats.Requests , Readings_Stats.Replies , Readings_Stats.Entries , Readings_Stats.Deltas , Readings_Stats.Mismatched );
+    printf ( "matrix     %u tiles drawn , %u skipped\n" , Matrix_Stats.Drawn , Matrix_Stats.Skipped );
+    printf ( "text       %u labels , %u characters , %u cached , %u rasterised , %u cycles per character mean ( max %u )\n" ,
+             Text_Stats.Draws , Text_Stats.Characters , Text_Stats.Hits , Text_Stats.Rasterised ,
+             ( uint ) ( Bench_Stages [ BENCH_STAGE_TEXT ].Count ? Bench_Stages [ BENCH_STAGE_TEXT ].Total / Bench_Stages [ BENCH_STAGE_TEXT ].Count : 0 ) ,
+             Bench_Stages [ BENCH_STAGE_TEXT ].Max );
+    printf ( "bench      compose %u cycles mean ( max %u ) , frame %u cycles mean , swap %u cycles max\n" ,
+             ( uint ) ( Bench_Stages [ BENCH_STAGE_COMPOSE ].Count ? Bench_Stages [ BENCH_STAGE_COMPOSE ].Total / Bench_Stages [ BENCH_STAGE_COMPOSE ].Count : 0 ) ,
+             Bench_Stages [ BENCH_STAGE_COMPOSE ].Max ,
+             ( uint ) ( Bench_Stages [ BENCH_STAGE_FRAME ].Count ? Bench_Stages [ BENCH_STAGE_FRAME ].Total / Bench_Stages [ BENCH_STAGE_FRAME ].Count : 0 ) ,
+             Bench_Stages [ BENCH_STAGE_SWAP ].Max );
+
+    if ( 0 != Check_Stats.Clocks )  // HOST_CHECK
+    {
+        printf ( "check      %s , %u lines , %u clocks : %u latch , %u address , %u clock , %u data , %u dwell\n" ,
+                 Check_Passed ( ) ? "passed" : "FAILED" , Check_Stats.Lines , Check_Stats.Clocks ,
+                 Check_Stats.Latch , Check_Stats.Address , Check_Stats.Clock , Check_Stats.Data , Check_Stats.Dwell );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    printf ( "testbed    %u transactions , %u requests , %u results , %u buttons , %u readings , %u corrupted\n" ,
+             Testbed_Stats.Transactions , Testbed_Stats.Requests , Testbed_Stats.Results , Testbed_Stats.Buttons , Testbed_Stats.Readings , Testbed_Stats.Corrupted );
+}
+
+static void Report_Task ( const Task_t *task )
+{
+    printf ( "  %-9s %6u runs , run %u us ( max %u ) , late %u us ( max %u )\n" ,
+             task->Name , task->Runs , task->RunTime , task->RunTimeMax , task->Late , task->LateMax );
+}
+
+/*** end of file ***/
@@ -0,0 +1,419 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           scheduler_check.c                                     *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <main.h>
+#include <scheduler.h>
+
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Scheduler cases against scheduler.c on its own , on a simulated clock
+// that only moves when a task spends time or the core sleeps :
+//   scheduler_check order    Periodic tasks under load , each dispatch has the
+//                            earliest deadline of the tasks due
+//   scheduler_check drift    A periodic task that has to drop periods keeps to
+//                            its period's phase , run for SCHEDULER_DRIFT_S
+//   scheduler_check wake     Wakes from interrupts and from a running task ,
+//                            an overdue task woken keeps its place
+// The scheduler keeps its heap between runs , so each case is a process of
+// its own. Exits non-zero on any failure.
+#define SCHEDULER_CHECK_TASKS   4
+#define SCHEDULER_DRIFT_S       100
+#define SCHEDULER_ORDER_S       10
+#define SCHEDULER_LOG_MAX       8
+
+typedef struct
+{
+    Task_t   Task;
+    uint32_t Period;        // us
+    uint32_t Delay;         // us to the first deadline
+    uint32_t RunTime;       // us spent per run
+    uint32_t Dropped;       // Periods skipped
+    uint64_t Last;          // Deadline of the last run
+    uint64_t Starts [ SCHEDULER_LOG_MAX ];     // First runs
+} Check_Task_t;
+
+typedef struct
+{
+    uint64_t Time;
+    Task_t  *Task;
+} Check_Irq_t;
+
+static Check_Task_t Check_Tasks [ SCHEDULER_CHECK_TASKS ];
+static Check_Irq_t  Check_Irqs  [ SCHEDULER_LOG_MAX ];
+static uint         Check_IrqCount = 0;
+static uint64_t     Check_Now      = 0;
+static uint64_t     Check_Alarm    = UINT64_MAX;
+static uint64_t     Check_End      = 0;
+static uint32_t     Check_Failed   = 0;
+static jmp_buf      Check_Done;
+
+static void Check_Drift  ( void );
+static void Check_Order  ( void );
+static void Check_Run    ( uint count );
+static void Check_Spend  ( uint32_t us );
+static void Check_Step   ( uint index );
+static void Check_Task0  ( void );
+static void Check_Task1  ( void );
+static void Check_Task2  ( void );
+static void Check_Task3  ( void );
+static void Check_Wake   ( void );
+
+static const Task_Function_t Check_Functions [ SCHEDULER_CHECK_TASKS ] = {
+    Check_Task0 , Check_Task1 , Check_Task2 , Check_Task3 ,
+};
+
+int main ( int argc , char **argv )
+{
+    if ( ( 2 == argc ) && ( 0 == strcmp ( argv [ 1 ] , "order" ) ) )
+    {
+        Check_Order ( );
+    }
+    else if ( ( 2 == argc ) && ( 0 == strcmp ( argv [ 1 ] , "drift" ) ) )
+    {
+        Check_Drift ( );
+    }
+    else if ( ( 2 == argc ) && ( 0 == strcmp ( argv [ 1 ] , "wake" ) ) )
+    {
+        Check_Wake ( );
+    }
+    else
+    {
+        fprintf ( stderr , "usage: scheduler_check order | drift | wake\n" );
+        Check_Failed++;
+    }
+
+    return ( 0 == Check_Failed ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+uint32_t Hal_IrqDisable ( void )
+{
+    return 0;
+}
+
+void Hal_IrqRestore ( uint32_t state )
+{
+}
+
+uint64_t Hal_Micros64 ( void )
+{
+    return Check_Now;
+}
+
+// Straight to the alarm or the next simulated interrupt , whichever is
+// first , and out of Scheduler_Run once the case's time is up
+void Hal_Sleep ( void )
+{
+    uint64_t Next        = Check_Alarm;
+    uint     Counter_Irq  = 0;
+
+    for ( Counter_Irq = 0 ; Counter_Irq < Check_IrqCount ; Counter_Irq++ )
+    {
+        Next = ( ( Check_Irqs [ Counter_Irq ].Time > Check_Now ) && ( Check_Irqs [ Counter_Irq ].Time < Next ) ) ? Check_Irqs [ Counter_Irq ].Time : Next;
+    }
+
+    if ( Next >= Check_End )
+    {
+        longjmp ( Check_Done , 1 );
+    }
+    else
+    {
+        Check_Now   = Next;
+        Check_Alarm = ( Check_Alarm <= Check_Now ) ? UINT64_MAX : Check_Alarm;
+    }
+
+    for ( Counter_Irq = 0 ; Counter_Irq < Check_IrqCount ; Counter_Irq++ )
+    {
+        if ( Check_Irqs [ Counter_Irq ].Time == Check_Now )
+        {
+            Scheduler_Wake ( Check_Irqs [ Counter_Irq ].Task );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+}
+
+bool Hal_WakeAt ( uint64_t time )
+{
+    Check_Alarm = time;
+
+    return ( time > Check_Now );
+}
+
+// Task 1 now and then holds the core for more than two of task 0's periods ,
+// so task 0 drops periods. Every run must still be on its period's phase and
+// every period either run or dropped whole.
+static void Check_Drift ( void )
+{
+    Check_Task_t *Steady = &Check_Tasks [ 0 ];
+    uint64_t      Runs   = 0;
+
+    Check_Tasks [ 0 ] = ( Check_Task_t ) { .Period = 7000  , .Delay = 0 , .RunTime = 1000 };
+    Check_Tasks [ 1 ] = ( Check_Task_t ) { .Period = 53000 , .Delay = 0 , .RunTime = 16000 };
+    Check_Tasks [ 2 ] = ( Check_Task_t ) { .Period = 3000  , .Delay = 0 , .RunTime = 300  };
+    Check_End = SCHEDULER_DRIFT_S * 1000000ull;
+
+    Check_Run ( 3 );
+
+    Runs = ( Check_End + Steady->Period - 1 ) / Steady->Period;
+
+    if ( ( ( Steady->Task.Runs + Steady->Dropped ) != Runs ) || ( 0 == Steady->Dropped ) )
+    {
+        fprintf ( stderr , "drift: %u runs and %u dropped of %llu , %u us late at most\n" , Steady->Task.Runs , Steady->Dropped ,
+                  ( unsigned long long ) Runs , Steady->Task.LateMax );
+        Check_Failed++;
+    }
+    else
+    {
+        printf ( "drift      %u runs and %u dropped in %u s , %u us late at most\n" , Steady->Task.Runs , Steady->Dropped , SCHEDULER_DRIFT_S , Steady->Task.LateMax );
+    }
+}
+
+// Utilisation about 0.5 and no task waits longer than the shortest period ,
+// so no period is dropped
+static void Check_Order ( void )
+{
+    static const uint32_t Periods  [ SCHEDULER_CHECK_TASKS ] = { 5000 , 7000 , 11000 , 13000 };
+    static const uint32_t RunTimes [ SCHEDULER_CHECK_TASKS ] = {  400 ,  900 , 1300 ,  2100 };
+
+    uint Counter_Task = 0;
+
+    for ( Counter_Task = 0 ; Counter_Task < SCHEDULER_CHECK_TASKS ; Counter_Task++ )
+    {
+        Check_Tasks [ Counter_Task ].Period  = Periods  [ Counter_Task ];
+        Check_Tasks [ Counter_Task ].RunTime = RunTimes [ Counter_Task ];
+    }
+
+    Check_End = SCHEDULER_ORDER_S * 1000000ull;
+
+    Check_Run ( SCHEDULER_CHECK_TASKS );
+
+    for ( Counter_Task = 0 ; Counter_Task < SCHEDULER_CHECK_TASKS ; Counter_Task++ )
+    {
+        if ( Check_Tasks [ Counter_Task ].Task.Runs != ( ( Check_End + Periods [ Counter_Task ] - 1 ) / Periods [ Counter_Task ] ) )
+        {
+            fprintf ( stderr , "order: task %u ran %u times\n" , Counter_Task , Check_Tasks [ Counter_Task ].Task.Runs );
+            Check_Failed++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    printf ( "order      %u tasks , %u s , %u out of order\n" , SCHEDULER_CHECK_TASKS , SCHEDULER_ORDER_S , Check_Failed );
+}
+
+// Add the first count tasks and run until Check_End
+static void Check_Run ( uint count )
+{
+    uint Counter_Task = 0;
+
+    Scheduler_Init ( NULL );
+
+    for ( Counter_Task = 0 ; Counter_Task < count ; Counter_Task++ )
+    {
+        Scheduler_Add ( &Check_Tasks [ Counter_Task ].Task , Check_Functions [ Counter_Task ] , "Check" ,
+                        Check_Tasks [ Counter_Task ].Period , Check_Tasks [ Counter_Task ].Delay );
+    }
+
+    if ( 0 == setjmp ( Check_Done ) )
+    {
+        Scheduler_Run ( );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// One run of a check task : no task still waiting may be due before it , it
+// keeps to its period's phase , and it spends its run time
+static void Check_Step ( uint index )
+{
+    Check_Task_t *Check        = &Check_Tasks [ index ];
+    Task_t       *Other        = NULL;
+    uint          Counter_Task = 0;
+
+    if ( Check_Now >= Check_End )
+    {
+        longjmp ( Check_Done , 1 );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    for ( Counter_Task = 0 ; Counter_Task < SCHEDULER_CHECK_TASKS ; Counter_Task++ )
+    {
+        Other = &Check_Tasks [ Counter_Task ].Task;
+
+        if ( ( Other != &Check->Task ) && ( NULL != Other->Function ) && ( SCHEDULER_RUNNING != Other->Index ) &&
+             ( Other->Deadline <= Check_Now ) && ( Other->Deadline < Check->Task.Deadline ) )
+        {
+            fprintf ( stderr , "task %u ( due %llu ) ran at %llu before task %u ( due %llu )\n" , index ,
+                      ( unsigned long long ) Check->Task.Deadline , ( unsigned long long ) Check_Now ,
+                      Counter_Task , ( unsigned long long ) Other->Deadline );
+            Check_Failed++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    if ( ( 0 != Check->Period ) && ( ( Check->Task.Deadline - Check->Delay ) % Check->Period ) && ( 0 == Check_IrqCount ) )
+    {
+        fprintf ( stderr , "task %u deadline %llu off its period\n" , index , ( unsigned long long ) Check->Task.Deadline );
+        Check_Failed++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( ( 0 != Check->Period ) && ( 0 != Check->Task.Runs ) && ( 0 == Check_IrqCount ) )
+    {
+        Check->Dropped += ( uint32_t ) ( ( Check->Task.Deadline - Check->Last ) / Check->Period ) - 1;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Check->Last = Check->Task.Deadline;
+
+    if ( Check->Task.Runs < SCHEDULER_LOG_MAX )
+    {
+        Check->Starts [ Check->Task.Runs ] = Check_Now;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Check_Spend ( Check->RunTime );
+}
+
+// Time spent in a task , with any interrupt falling due on the way taken
+static void Check_Spend ( uint32_t us )
+{
+    uint64_t End         = Check_Now + us;
+    uint     Counter_Irq = 0;
+
+    for ( Counter_Irq = 0 ; Counter_Irq < Check_IrqCount ; Counter_Irq++ )     // In time order
+    {
+        if ( ( Check_Irqs [ Counter_Irq ].Time > Check_Now ) && ( Check_Irqs [ Counter_Irq ].Time <= End ) )
+        {
+            Check_Now = Check_Irqs [ Counter_Irq ].Time;
+            Scheduler_Wake ( Check_Irqs [ Counter_Irq ].Task );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    Check_Now = End;
+}
+
+static void Check_Task0 ( void )
+{
+    Check_Step ( 0 );
+}
+
+static void Check_Task1 ( void )
+{
+    Check_Step ( 1 );
+}
+
+static void Check_Task2 ( void )
+{
+    Check_Step ( 2 );
+}
+
+static void Check_Task3 ( void )
+{
+    Check_Step ( 3 );
+}
+
+// Task 0 runs 0 to 20 ms and wakes task 1 , due at 5 ms , part way through ,
+// as an interrupt handler would. Task 1 must still run ahead of task 2 , due
+// at 12 ms , and show the whole 15 ms it was late. Task 3 only runs when
+// woken , by interrupts at 30 ms and 50 ms , and task 1 is woken again at
+// 60 ms , well before its next deadline.
+static void Check_Wake ( void )
+{
+    static const uint64_t Expect [ SCHEDULER_CHECK_TASKS ] [ 2 ] = {
+        {     0 , 100000 } ,
+        { 20000 ,  60000 } ,
+        { 22500 ,  92000 } ,    // After task 1
+        { 30000 ,  50000 } ,
+    };
+
+    uint Counter_Run  = 0;
+    uint Counter_Task = 0;
+
+    Check_Irqs [ 0 ] = ( Check_Irq_t ) { 15000 , &Check_Tasks [ 1 ].Task };     // While task 0 runs
+    Check_Irqs [ 1 ] = ( Check_Irq_t ) { 30000 , &Check_Tasks [ 3 ].Task };
+    Check_Irqs [ 2 ] = ( Check_Irq_t ) { 50000 , &Check_Tasks [ 3 ].Task };
+    Check_Irqs [ 3 ] = ( Check_Irq_t ) { 60000 , &Check_Tasks [ 1 ].Task };
+    Check_IrqCount   = 4;
+    Check_End        = 150000;
+
+    Check_Tasks [ 0 ] = ( Check_Task_t ) { .Period = 100000  , .Delay = 0     , .RunTime = 20000 };
+    Check_Tasks [ 1 ] = ( Check_Task_t ) { .Period = 1000000 , .Delay = 5000  , .RunTime = 2500  };
+    Check_Tasks [ 2 ] = ( Check_Task_t ) { .Period = 80000   , .Delay = 12000 , .RunTime = 6000  };
+    Check_Tasks [ 3 ] = ( Check_Task_t ) { .Period = 0       , .Delay = 0     , .RunTime = 0     };
+
+    Check_Run ( SCHEDULER_CHECK_TASKS );
+
+    for ( Counter_Task = 0 ; Counter_Task < SCHEDULER_CHECK_TASKS ; Counter_Task++ )
+    {
+        for ( Counter_Run = 0 ; Counter_Run < 2 ; Counter_Run++ )
+        {
+            if ( Check_Tasks [ Counter_Task ].Starts [ Counter_Run ] != Expect [ Counter_Task ] [ Counter_Run ] )
+            {
+                fprintf ( stderr , "wake: task %u run %u at %llu , expected %llu\n" , Counter_Task , Counter_Run ,
+                          ( unsigned long long ) Check_Tasks [ Counter_Task ].Starts [ Counter_Run ] ,
+                          ( unsigned long long ) Expect [ Counter_Task ] [ Counter_Run ] );
+                Check_Failed++;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+    }
+
+    if ( 15000 != Check_Tasks [ 1 ].Task.LateMax )
+    {
+        fprintf ( stderr , "wake: task 1 %u us late , expected 15000\n" , Check_Tasks [ 1 ].Task.LateMax );
+        Check_Failed++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    printf ( "wake       %u tasks , %u interrupts , %u failed\n" , SCHEDULER_CHECK_TASKS , Check_IrqCount , Check_Failed );
+}
+
+/*** end of file ***/
@@ -0,0 +1,32 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           clocks.h                                              *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#ifndef __SDK_CLOCKS_H
+#define __SDK_CLOCKS_H
+
+#include <hal.h>
+
+// Host stand-ins for the Pico SDK , only as much as src/hub75.c uses so
+// hub75_check.c can build it. The functions are provided by the check.
+enum clock_index { clk_sys = 5 };
+
+uint32_t clock_get_hz ( enum clock_index clock );
+uint32_t time_us_32   ( void );     // pico/stdlib.h on the target , which HAL_LINUX leaves out
+
+#endif /* __SDK_CLOCKS_H */
+
+/*** end of file ***/
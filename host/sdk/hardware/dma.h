@@ -0,0 +1,60 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           dma.h                                                 *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#ifndef __SDK_DMA_H
+#define __SDK_DMA_H
+
+#include <hal.h>
+
+#define DMA_IRQ_1           12
+#define DMA_CHANNELS        12
+
+typedef struct
+{
+    volatile uint32_t al3_read_addr_trig;
+} dma_channel_hw_t;
+
+typedef struct
+{
+    dma_channel_hw_t ch [ DMA_CHANNELS ];
+} dma_hw_t;
+
+typedef struct
+{
+    uint Chain;
+    bool Read;      // Read address increments
+    bool Write;     // Write address increments
+} dma_channel_config;
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0 , DMA_SIZE_16 = 1 , DMA_SIZE_32 = 2 };
+
+extern dma_hw_t *dma_hw;
+
+void               channel_config_set_chain_to           ( dma_channel_config *config , uint channel );
+void               channel_config_set_dreq               ( dma_channel_config *config , uint dreq );
+void               channel_config_set_read_increment     ( dma_channel_config *config , bool increment );
+void               channel_config_set_transfer_data_size ( dma_channel_config *config , enum dma_channel_transfer_size size );
+void               channel_config_set_write_increment    ( dma_channel_config *config , bool increment );
+void               dma_channel_acknowledge_irq1          ( uint channel );
+void               dma_channel_configure                 ( uint channel , const dma_channel_config *config , volatile void *write , const volatile void *read , uint count , bool trigger );
+dma_channel_config dma_channel_get_default_config        ( uint channel );
+void               dma_channel_set_irq1_enabled          ( uint channel , bool enabled );
+int                dma_claim_unused_channel              ( bool required );
+
+#endif /* __SDK_DMA_H */
+
+/*** end of file ***/
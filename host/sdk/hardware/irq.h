@@ -0,0 +1,30 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           irq.h                                                 *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#ifndef __SDK_IRQ_H
+#define __SDK_IRQ_H
+
+#include <hal.h>
+
+typedef void ( *irq_handler_t ) ( void );
+
+void irq_set_enabled           ( uint irq , bool enabled );
+void irq_set_exclusive_handler ( uint irq , irq_handler_t handler );
+
+#endif /* __SDK_IRQ_H */
+
+/*** end of file ***/
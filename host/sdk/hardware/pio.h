@@ -0,0 +1,107 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           pio.h                                                 *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#ifndef __SDK_PIO_H
+#define __SDK_PIO_H
+
+#include <hal.h>
+
+#define PIO_SM_COUNT        4
+
+typedef struct
+{
+    volatile uint32_t txf [ PIO_SM_COUNT ];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+typedef struct pio_program
+{
+    const uint16_t *instructions;
+    uint8_t         length;
+    int8_t          origin;
+} pio_program_t;
+
+// State machine configuration as pio_sm_init takes it , fields kept plain
+// rather than packed into the SDK's register images
+typedef struct
+{
+    uint32_t clkdiv;            // 1/256ths of a system clock
+    uint8_t  wrap_target;
+    uint8_t  wrap;
+    uint8_t  sideset_bits;      // Counting the enable bit when optional
+    bool     sideset_opt;
+    bool     sideset_pindirs;
+    uint8_t  sideset_base;
+    uint8_t  out_base;
+    uint8_t  out_count;
+    uint8_t  set_base;
+    uint8_t  set_count;
+    bool     out_shift_right;
+    bool     autopull;
+    uint8_t  pull_threshold;    // 32 held as 0 , as the hardware does
+    uint8_t  fifo_join;
+} pio_sm_config;
+
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE = 0 , PIO_FIFO_JOIN_TX = 1 , PIO_FIFO_JOIN_RX = 2 };
+
+// Source and destination operands , the low three bits being the encoding
+enum pio_src_dest
+{
+    pio_pins     = 0x000 ,
+    pio_x        = 0x001 ,
+    pio_y        = 0x002 ,
+    pio_null     = 0x103 ,
+    pio_pindirs  = 0x104 ,
+    pio_exec_mov = 0x204 ,
+    pio_status   = 0x305 ,
+    pio_pc       = 0x405 ,
+    pio_isr      = 0x006 ,
+    pio_osr      = 0x007 ,
+    pio_exec_out = 0x507 ,
+};
+
+extern pio_hw_t pio0_hw;
+
+#define pio0                ( &pio0_hw )
+
+pio_sm_config pio_get_default_sm_config    ( void );
+uint          pio_add_program              ( PIO pio , const pio_program_t *program );
+int           pio_claim_unused_sm          ( PIO pio , bool required );
+uint          pio_encode_mov               ( enum pio_src_dest dest , enum pio_src_dest src );
+uint          pio_encode_out               ( enum pio_src_dest dest , uint count );
+uint          pio_encode_pull              ( bool if_empty , bool block );
+void          pio_enable_sm_mask_in_sync   ( PIO pio , uint32_t mask );
+uint          pio_get_dreq                 ( PIO pio , uint sm , bool tx );
+void          pio_gpio_init                ( PIO pio , uint pin );
+void          pio_sm_exec                  ( PIO pio , uint sm , uint instr );
+void          pio_sm_init                  ( PIO pio , uint sm , uint initial_pc , const pio_sm_config *config );
+void          pio_sm_put_blocking          ( PIO pio , uint sm , uint32_t data );
+void          pio_sm_set_pindirs_with_mask ( PIO pio , uint sm , uint32_t dirs , uint32_t mask );
+void          pio_sm_set_pins_with_mask    ( PIO pio , uint sm , uint32_t values , uint32_t mask );
+void          sm_config_set_clkdiv         ( pio_sm_config *c , float div );
+void          sm_config_set_fifo_join      ( pio_sm_config *c , enum pio_fifo_join join );
+void          sm_config_set_out_pins       ( pio_sm_config *c , uint out_base , uint out_count );
+void          sm_config_set_out_shift      ( pio_sm_config *c , bool shift_right , bool autopull , uint pull_threshold );
+void          sm_config_set_set_pins       ( pio_sm_config *c , uint set_base , uint set_count );
+void          sm_config_set_sideset        ( pio_sm_config *c , uint bit_count , bool optional , bool pindirs );
+void          sm_config_set_sideset_pins   ( pio_sm_config *c , uint sideset_base );
+void          sm_config_set_wrap           ( pio_sm_config *c , uint wrap_target , uint wrap );
+
+#endif /* __SDK_PIO_H */
+
+/*** end of file ***/
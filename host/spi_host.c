@@ -0,0 +1,159 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           spi_host.c                                            *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <host.h>
+#include <protocol.h>
+#include <spi_link.h>
+#include <testbed.h>
+#include <trace.h>
+
+// Transactions complete after their time on the wire at the current clock ,
+// with the test bed stand-in filling the receive buffer
+static volatile SPI_Callback_t SPI_Callback = NULL;
+static uint32_t                SPI_Baud     = SPI_BAUD_RATE * 1000;
+static uint8_t                 SPI_Bed      = 0;
+static uint64_t                SPI_Deadline = 0;
+static int32_t                 SPI_Event    = 0;
+static uint8_t                 SPI_Discard [ PROTOCOL_FRAME_LENGTH ];
+static uint8_t                 SPI_Length   = 0;
+static uint8_t                *SPI_Rx       = NULL;
+static uint64_t                SPI_Start    = 0;
+static volatile uint8_t        SPI_State    = SPI_STATUS_IDLE;
+
+volatile SPI_Stats_t SPI_Stats;
+
+static const uint SPI_CS [ ] = SPI_CS_PINS;
+
+static void SPI_Complete ( void *arg );
+
+void SPI_Init ( void )
+{
+    Testbed_Init ( );
+}
+
+// Current status , expiring the transaction if its timeout has passed
+uint8_t SPI_Poll ( void )
+{
+    uint8_t Status = SPI_STATUS_IDLE;
+
+    Host_Service ( );
+
+    Status = SPI_State;
+
+    if ( ( SPI_STATUS_BUSY == Status ) && ( Hal_Micros64 ( ) > SPI_Deadline ) )
+    {
+        Host_Cancel ( SPI_Event );
+
+        SPI_Stats.Timeouts++;
+        Status = SPI_STATUS_TIMEOUT;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( SPI_STATUS_BUSY != Status )
+    {
+        SPI_State = SPI_STATUS_IDLE;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Status;
+}
+
+// Route the chip select to bed , between transactions only
+bool SPI_Select ( uint8_t bed )
+{
+    bool Selected = false;
+
+    if ( ( SPI_STATUS_BUSY != SPI_State ) && ( bed < TESTBED_COUNT ) )
+    {
+        SPI_Bed  = bed;
+        Selected = true;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Selected;
+}
+
+uint32_t SPI_SetBaud ( uint32_t baud )
+{
+    SPI_Baud = baud;
+
+    return SPI_Baud;
+}
+
+bool SPI_Submit ( const uint8_t *tx , uint8_t *rx , uint8_t length , uint16_t timeout_ms , SPI_Callback_t callback )
+{
+    bool Accepted = false;
+
+    if ( ( SPI_STATUS_BUSY != SPI_State ) && ( 0 != length ) && ( length <= sizeof ( SPI_Discard ) ) )
+    {
+        SPI_Callback = callback;
+        SPI_Length   = length;
+        SPI_Rx       = ( NULL != rx ) ? rx : SPI_Discard;
+        SPI_Start    = Hal_Micros64 ( );
+        SPI_Deadline = SPI_Start + ( ( uint64_t ) timeout_ms * 1000 );
+        SPI_State    = SPI_STATUS_BUSY;
+
+        Testbed_Transfer ( SPI_Bed , tx , SPI_Rx , length , SPI_Baud );
+        Trace_SPI        ( SPI_Start * 1000 , SPI_CS [ SPI_Bed ] , tx , SPI_Rx , length , SPI_Baud );
+
+        // Eight clocks per byte , rounded up to the next microsecond
+        SPI_Event = Host_At ( SPI_Start + ( ( ( uint64_t ) length * 8000000ull ) + SPI_Baud - 1 ) / SPI_Baud , SPI_Complete , NULL );
+
+        Accepted = true;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Accepted;
+}
+
+static void SPI_Complete ( void *arg )
+{
+    if ( SPI_STATUS_BUSY == SPI_State )
+    {
+        SPI_Stats.Duration    = ( uint32_t ) ( Hal_Micros64 ( ) - SPI_Start );
+        SPI_Stats.DurationMax = ( SPI_Stats.Duration > SPI_Stats.DurationMax ) ? SPI_Stats.Duration : SPI_Stats.DurationMax;
+        SPI_Stats.Completed++;
+        SPI_State             = SPI_STATUS_DONE;
+
+        if ( NULL != SPI_Callback )
+        {
+            SPI_Callback ( SPI_Rx , SPI_Length );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+/*** end of file ***/
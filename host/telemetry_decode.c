@@ -0,0 +1,192 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           telemetry_decode.c                                    *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <main.h>
+#include <protocol.h>
+#include <telemetry.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Telemetry stream decoder , one line of text per record :
+//   telemetry_decode [ file ]     e.g. /dev/ttyACM0 , a HOST_TELEMETRY file , or stdin
+// Anything between records , such as printf output sharing the port , is skipped.
+
+static uint32_t Decode_Bad     = 0;     // Records failing the CRC
+static uint32_t Decode_Skipped = 0;     // Bytes outside a record
+
+static void     Decode_Print  ( const uint8_t *record );
+static uint     Decode_Resync ( uint8_t *record , uint fill );
+static uint32_t Decode_Get16  ( const uint8_t *data );
+
+int main ( int argc , char **argv )
+{
+    struct termios Terminal;
+    uint8_t        Record [ TELEMETRY_HEADER_LENGTH + TELEMETRY_PAYLOAD_MAX + 2 ];
+    FILE          *Input  = stdin;
+    uint16_t       CRC    = 0;
+    uint           Fill   = 0;
+    int            Byte   = 0;
+
+    if ( 1 < argc )
+    {
+        Input = fopen ( argv [ 1 ] , "rb" );
+
+        if ( NULL == Input )
+        {
+            perror ( argv [ 1 ] );
+            exit ( EXIT_FAILURE );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    // A serial port has to pass every byte through untouched
+    if ( isatty ( fileno ( Input ) ) && ( 0 == tcgetattr ( fileno ( Input ) , &Terminal ) ) )
+    {
+        cfmakeraw ( &Terminal );
+        tcsetattr ( fileno ( Input ) , TCSANOW , &Terminal );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    setvbuf ( stdout , NULL , _IOLBF , 0 );
+
+    while ( EOF != ( Byte = fgetc ( Input ) ) )
+    {
+        Record [ Fill++ ] = ( uint8_t ) Byte;
+
+        if ( ( 1 == Fill ) && ( TELEMETRY_SYNC != Byte ) )
+        {
+            Decode_Skipped++;
+            Fill = 0;
+        }
+        else if ( ( 3 == Fill ) && ( Record [ 2 ] > TELEMETRY_PAYLOAD_MAX ) )
+        {
+            Fill = Decode_Resync ( Record , Fill );
+        }
+        else if ( ( 3 <= Fill ) && ( ( TELEMETRY_HEADER_LENGTH + Record [ 2 ] + 2u ) == Fill ) )
+        {
+            CRC = Protocol_CRC16 ( &Record [ 1 ] , TELEMETRY_HEADER_LENGTH - 1 + Record [ 2 ] );
+
+            if ( CRC == Decode_Get16 ( &Record [ TELEMETRY_HEADER_LENGTH + Record [ 2 ] ] ) )
+            {
+                Decode_Print ( Record );
+                Fill = 0;
+            }
+            else
+            {
+                Decode_Bad++;
+                Fill = Decode_Resync ( Record , Fill );
+            }
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    fprintf ( stderr , "telemetry_decode: %u bad records , %u bytes skipped\n" , Decode_Bad , Decode_Skipped );
+
+    return EXIT_SUCCESS;
+}
+
+static void Decode_Print ( const uint8_t *record )
+{
+    const uint8_t *Payload     = &record [ TELEMETRY_HEADER_LENGTH ];
+    uint32_t       Time        = ( Decode_Get16 ( &record [ 3 ] ) << 16 ) | Decode_Get16 ( &record [ 5 ] );
+    uint8_t        Length      = record [ 2 ];
+    uint           Counter_Bed = 0;
+
+    printf ( "%10u " , Time );
+
+    if ( ( TELEMETRY_HEALTH == record [ 1 ] ) && ( 22 <= Length ) )
+    {
+        printf ( "health refresh=%u.%02uHz wdt_margin=%ums spi=%u spi_mean=%uus spi_max=%uus crc=%u sync=%u timeouts=%u dropped=%u lost=%u clock=%ukHz\n" ,
+                 Decode_Get16 ( &Payload [  0 ] ) / 100 , Decode_Get16 ( &Payload [  0 ] ) % 100 ,
+                 Decode_Get16 ( &Payload [  2 ] ) , Decode_Get16 ( &Payload [  4 ] ) , Decode_Get16 ( &Payload [  6 ] ) ,
+                 Decode_Get16 ( &Payload [  8 ] ) , Decode_Get16 ( &Payload [ 10 ] ) , Decode_Get16 ( &Payload [ 12 ] ) ,
+                 Decode_Get16 ( &Payload [ 14 ] ) , Decode_Get16 ( &Payload [ 16 ] ) , Decode_Get16 ( &Payload [ 18 ] ) ,
+                 Decode_Get16 ( &Payload [ 20 ] ) );
+    }
+    else if ( ( TELEMETRY_SPI == record [ 1 ] ) && ( 2 <= Length ) )
+    {
+        printf ( "spi latency=%uus transactions=%u\n" , Decode_Get16 ( Payload ) , ( 4 <= Length ) ? Decode_Get16 ( &Payload [ 2 ] ) : 1 );
+    }
+    else if ( ( TELEMETRY_LINK_ERROR == record [ 1 ] ) && ( 6 <= Length ) )
+    {
+        printf ( "link_error kind=%s step=%u clock=%uHz bed=%u\n" , ( TELEMETRY_ERROR_TIMEOUT == Payload [ 0 ] ) ? "timeout" : "reply" ,
+                 Payload [ 1 ] , ( Decode_Get16 ( &Payload [ 2 ] ) << 16 ) | Decode_Get16 ( &Payload [ 4 ] ) , ( 7 <= Length ) ? Payload [ 6 ] : 0 );
+    }
+    else if ( TELEMETRY_BEDS == record [ 1 ] )
+    {
+        printf ( "beds" );
+
+        for ( Counter_Bed = 0 ; ( Counter_Bed * 4 + 4 ) <= Length ; Counter_Bed++ )
+        {
+            printf ( " %u:age=%ums,max=%ums" , Counter_Bed , Decode_Get16 ( &Payload [ Counter_Bed * 4 ] ) , Decode_Get16 ( &Payload [ Counter_Bed * 4 + 2 ] ) );
+        }
+
+        printf ( "\n" );
+    }
+    else if ( ( TELEMETRY_BOOT == record [ 1 ] ) && ( 8 <= Length ) )
+    {
+        printf ( "boot first_frame=%uus first_status=%uus\n" , ( Decode_Get16 ( &Payload [ 0 ] ) << 16 ) | Decode_Get16 ( &Payload [ 2 ] ) ,
+                 ( Decode_Get16 ( &Payload [ 4 ] ) << 16 ) | Decode_Get16 ( &Payload [ 6 ] ) );
+    }
+    else if ( ( TELEMETRY_BUTTON_DROP == record [ 1 ] ) && ( 2 <= Length ) )
+    {
+        printf ( "button_drop buttons=0x%x type=%u drops=%u\n" , Payload [ 0 ] , Payload [ 1 ] , ( 3 <= Length ) ? Payload [ 2 ] : 1 );
+    }
+    else
+    {
+        printf ( "type=0x%02x length=%u\n" , record [ 1 ] , Length );
+    }
+}
+
+// Not a record after all , carry on from the next sync byte after its start
+static uint Decode_Resync ( uint8_t *record , uint fill )
+{
+    uint Counter_Byte = 1;
+
+    while ( ( Counter_Byte < fill ) && ( TELEMETRY_SYNC != record [ Counter_Byte ] ) )
+    {
+        Counter_Byte++;
+    }
+
+    Decode_Skipped += Counter_Byte;
+    memmove ( record , &record [ Counter_Byte ] , fill - Counter_Byte );
+
+    return fill - Counter_Byte;
+}
+
+static uint32_t Decode_Get16 ( const uint8_t *data )
+{
+    return ( ( uint32_t ) data [ 0 ] << 8 ) | data [ 1 ];
+}
+
+/*** end of file ***/
@@ -0,0 +1,693 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           testbed.c                                             *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <host.h>
+#include <batch.h>
+#include <protocol.h>
+#include <readings.h>
+#include <testbed.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Script , one entry per line , times in ms from start up :
+//   S <ms> <pass> <pos> [ <bed> ]
+//                          Publish a status ( pass as hex of any length , bit n = sensor n ) and pulse
+//                          DATA_READY_PIN , from test bed 0 unless bed is given
+//   P <ms> <pin> <level>   Drive an input pin , e.g. a button
+//   B <ms> <level>         Send a panel brightness ( 0 to 255 ) with every status from then on
+//   # ...                  Comment
+// Without HOST_SCRIPT each test bed runs the SENSOR_COUNT sensors in turn , one every
+// TESTBED_STEP_MS , staggered across the beds , and Testbed_Buttons is played alongside.
+// All beds share DATA_READY_PIN , wired-OR on the jig. With HOST_MUTE=<bed> that bed
+// stops publishing and answering TESTBED_MUTE_MS in , as if its cable were pulled.
+// With HOST_BUTTONS=<ms> all four switches are pressed and released together
+// every ms from TESTBED_BUTTONS_MS on , alongside the rest.
+#define TESTBED_SCRIPT_MAX      256
+
+typedef struct
+{
+    uint64_t Time;
+    uint32_t Value;
+    uint8_t  Pass [ SENSOR_BYTES ];
+    uint8_t  Pin;       // Or sensor position , or brightness
+    uint8_t  Bed;
+    char     Type;
+} Testbed_Entry_t;
+
+typedef struct
+{
+    uint16_t Value [ SENSOR_COUNT ];
+    uint8_t  Generation;
+} Testbed_Sent_t;
+
+typedef struct
+{
+    uint8_t        Reply [ PROTOCOL_FRAME_LENGTH ];     // Shifted out with the next transaction
+    uint8_t        Pass [ SENSOR_BYTES ];
+    uint8_t        Pos;
+    uint32_t       Random;                              // Pass or fail
+    uint32_t       Noise;                               // Readings
+    uint16_t       Reading [ SENSOR_COUNT ];
+    uint16_t       Span    [ SENSOR_COUNT ];
+    Testbed_Sent_t Sent    [ TESTBED_HISTORY ];         // Values as of each generation sent , oldest overwritten
+    uint8_t        Generation;
+    uint8_t        First;                               // Sensor the next readings reply starts from
+} Testbed_Bed_t;
+
+// SW1 pressed with contact bounce , held past BUTTON_LONG_MS , then a tap on SW2
+static const char *Testbed_Buttons [ ] = {
+    "P 1500 26 1" , "P 1501 26 0" , "P 1502 26 1" , "P 1503 26 0" , "P 1504 26 1" ,
+    "P 2800 26 0" , "P 2801 26 1" , "P 2802 26 0" ,
+    "P 3500 27 1" , "P 3560 27 0" ,
+};
+
+static Testbed_Entry_t Testbed_Script [ TESTBED_SCRIPT_MAX ];
+static uint            Testbed_Count    = 0;
+static uint            Testbed_Next     = 0;
+static bool            Testbed_Legacy   = false;
+static uint32_t        Testbed_BaudMax  = TESTBED_BAUD_MAX;
+static Testbed_Bed_t   Testbed_Beds [ TESTBED_COUNT ];
+static int             Testbed_Level    = -1;   // Brightness sent with each status , -1 for none
+static int             Testbed_Mute     = -1;   // Bed that goes silent , -1 for none
+static uint32_t        Testbed_Toggle   = 0;    // HOST_BUTTONS period ( us ) , 0 for none
+static bool            Testbed_Held     = false;
+
+Testbed_Stats_t Testbed_Stats;
+
+static void    Testbed_Frame    ( Testbed_Bed_t *bed , uint8_t sequence , uint8_t opcode , const uint8_t *payload , uint8_t length );
+static bool    Testbed_Hex      ( const char *text , uint8_t *pass );
+static bool    Testbed_Parse    ( const char *line );
+static void    Testbed_Play     ( void *arg );
+static void    Testbed_Publish  ( Testbed_Bed_t *bed , const uint8_t *pass , uint8_t pos );
+static void    Testbed_PulseEnd ( void *arg );
+static uint8_t Testbed_Readings ( Testbed_Bed_t *bed , uint8_t held , uint8_t *payload );
+static void    Testbed_Sample   ( void *arg );
+static bool    Testbed_Silent   ( uint8_t bed );
+static void    Testbed_Storm    ( void *arg );
+static uint8_t Testbed_Status   ( const Testbed_Bed_t *bed , uint8_t opcode , uint8_t *payload );
+static void    Testbed_Step     ( void *arg );
+static uint8_t Testbed_Xorshift ( uint32_t *state );
+
+void Testbed_Init ( void )
+{
+    const char *Legacy = getenv ( "HOST_LEGACY"  );
+    const char *Limit  = getenv ( "HOST_SPI_MAX" );
+    const char *Script = getenv ( "HOST_SCRIPT"  );
+    const char *Mute   = getenv ( "HOST_MUTE"    );
+    const char *Storm  = getenv ( "HOST_BUTTONS" );
+    char        Line [ 128 ];
+    FILE       *File   = NULL;
+    uint        Counter_Bed    = 0;
+    uint        Counter_Line   = 0;
+    uint        Counter_Sensor = 0;
+
+    Testbed_Legacy  = ( NULL != Legacy ) && ( '1' == Legacy [ 0 ] );
+    Testbed_BaudMax = ( NULL != Limit  ) ? ( uint32_t ) strtoul ( Limit , NULL , 0 ) : TESTBED_BAUD_MAX;
+    Testbed_Mute    = ( NULL != Mute   ) ? ( int ) strtol ( Mute , NULL , 0 ) : -1;
+    Testbed_Toggle  = ( NULL != Storm  ) ? ( uint32_t ) strtoul ( Storm , NULL , 0 ) * 1000 : 0;
+
+    if ( Testbed_Mute >= TESTBED_COUNT )
+    {
+        fprintf ( stderr , "testbed: HOST_MUTE %d , only %u test beds\n" , Testbed_Mute , TESTBED_COUNT );
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
+    {
+        memset ( &Testbed_Beds [ Counter_Bed ] , 0 , sizeof ( Testbed_Beds [ Counter_Bed ] ) );
+        Testbed_Beds [ Counter_Bed ].Random = 0x2545F491 + Counter_Bed;
+        Testbed_Beds [ Counter_Bed ].Noise  = 0x9E3779B9 + Counter_Bed;
+
+        for ( Counter_Sensor = 0 ; Counter_Sensor < SENSOR_COUNT ; Counter_Sensor++ )
+        {
+            Testbed_Beds [ Counter_Bed ].Reading [ Counter_Sensor ] = TESTBED_BASELINE;
+            Testbed_Beds [ Counter_Bed ].Span    [ Counter_Sensor ] = TESTBED_SPAN_MIN + ( ( Counter_Sensor * 397 + Counter_Bed * 151 ) % TESTBED_SPAN_RANGE );
+        }
+
+        Host_At ( Hal_Micros64 ( ) + ( TESTBED_SAMPLE_MS * 1000 ) , Testbed_Sample , &Testbed_Beds [ Counter_Bed ] );
+    }
+
+    if ( NULL != Script )
+    {
+        File = fopen ( Script , "r" );
+
+        if ( NULL == File )
+        {
+            fprintf ( stderr , "testbed: cannot open %s\n" , Script );
+            exit ( EXIT_FAILURE );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        while ( NULL != fgets ( Line , sizeof ( Line ) , File ) )
+        {
+            if ( !Testbed_Parse ( Line ) )
+            {
+                fprintf ( stderr , "testbed: %s line %u not understood\n" , Script , Counter_Line + 1 );
+                exit ( EXIT_FAILURE );
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            Counter_Line++;
+        }
+
+        fclose ( File );
+    }
+    else
+    {
+        for ( Counter_Line = 0 ; Counter_Line < count_of ( Testbed_Buttons ) ; Counter_Line++ )
+        {
+            Testbed_Parse ( Testbed_Buttons [ Counter_Line ] );
+        }
+
+        for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
+        {
+            Host_At ( Hal_Micros64 ( ) + ( ( TESTBED_STEP_MS + ( Counter_Bed * TESTBED_STEP_MS ) / TESTBED_COUNT ) * 1000 ) ,
+                      Testbed_Step , &Testbed_Beds [ Counter_Bed ] );
+        }
+    }
+
+    if ( 0 != Testbed_Count )
+    {
+        Host_At ( Testbed_Script [ 0 ].Time , Testbed_Play , NULL );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( 0 != Testbed_Toggle )
+    {
+        Host_At ( TESTBED_BUTTONS_MS * 1000ull , Testbed_Storm , NULL );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Full duplex : rx gets whatever test bed bed had queued while tx is decoded
+// HOST_MUTE bed , -1 for none
+int Testbed_Muted ( void )
+{
+    return Testbed_Mute;
+}
+
+void Testbed_Transfer ( uint8_t bed , const uint8_t *tx , uint8_t *rx , uint8_t length , uint32_t baud )
+{
+    Testbed_Bed_t *Bed     = &Testbed_Beds [ ( bed < TESTBED_COUNT ) ? bed : 0 ];
+    uint8_t        Payload [ PROTOCOL_PAYLOAD_MAX ];
+    uint8_t        Count   = 0;
+    uint8_t        Length  = tx [ 2 ];
+    uint16_t       CRC     = 0;
+
+    Testbed_Stats.Transactions++;
+    memset ( rx , 0 , length );
+
+    if ( Testbed_Silent ( bed ) )  // Nothing comes back , rx reads as zeros
+    {
+        // Nothing to do
+    }
+    else if ( Testbed_Legacy )
+    {
+        if ( ( PROTOCOL_LEGACY_LENGTH == length ) && ( SYNC_BYTE == tx [ 0 ] ) && ( DAC_CHECK_IS_READY == tx [ 1 ] ) )
+        {
+            rx [ 4 ] = SYNC_BYTE;
+            rx [ 5 ] = DAC_CHECK_IS_READY;
+            Testbed_Status ( Bed , PROTOCOL_OP_STATUS , Payload );
+            memcpy ( &rx [ 6 ] , Payload , PROTOCOL_LEGACY_LENGTH - 6 );
+        }
+        else if ( ( 2 == length ) && ( SYNC_BYTE == tx [ 0 ] ) )
+        {
+            Testbed_Stats.Buttons++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        memcpy ( rx , Bed->Reply , ( length < sizeof ( Bed->Reply ) ) ? length : sizeof ( Bed->Reply ) );
+        memset ( Bed->Reply , 0 , sizeof ( Bed->Reply ) );
+
+        if ( ( PROTOCOL_FRAME_LENGTH == length ) && ( SYNC_BYTE == tx [ 0 ] ) && ( PROTOCOL_VERSION == tx [ 1 ] ) && ( Length <= PROTOCOL_PAYLOAD_MAX ) )
+        {
+            CRC = Protocol_CRC16 ( &tx [ 1 ] , PROTOCOL_HEADER_LENGTH - 1 + Length );
+
+            if ( ( ( uint8_t ) ( CRC >> 8 ) == tx [ PROTOCOL_HEADER_LENGTH + Length ] ) && ( ( uint8_t ) CRC == tx [ PROTOCOL_HEADER_LENGTH + Length + 1 ] ) )
+            {
+                Testbed_Stats.Requests++;
+
+                switch ( tx [ 4 ] )
+                {
+                    case PROTOCOL_OP_BATCH:
+                        Count         = tx [ PROTOCOL_HEADER_LENGTH ] & BATCH_COUNT_MASK;
+                        Payload [ 0 ] = Count;
+                        Testbed_Stats.Buttons += Count;
+
+                        if ( BATCH_STATUS & tx [ PROTOCOL_HEADER_LENGTH ] )
+                        {
+                            Testbed_Frame  ( Bed , tx [ 3 ] , PROTOCOL_OP_BATCH , Payload ,
+                                             1 + Testbed_Status ( Bed , ( BATCH_STATUS_N & tx [ PROTOCOL_HEADER_LENGTH ] ) ? PROTOCOL_OP_STATUS_N : PROTOCOL_OP_STATUS , &Payload [ 1 ] ) );
+                        }
+                        else
+                        {
+                            Testbed_Frame  ( Bed , tx [ 3 ] , PROTOCOL_OP_BATCH , Payload , 1 );
+                        }
+                    break;
+
+                    case PROTOCOL_OP_BUTTON:
+                        Testbed_Stats.Buttons++;
+                        Testbed_Frame ( Bed , tx [ 3 ] , PROTOCOL_OP_BUTTON , NULL , 0 );
+                    break;
+
+                    case PROTOCOL_OP_ECHO:
+                        Testbed_Frame ( Bed , tx [ 3 ] , PROTOCOL_OP_ECHO , &tx [ PROTOCOL_HEADER_LENGTH ] , Length );
+                    break;
+
+                    case PROTOCOL_OP_READINGS:
+                        Testbed_Frame  ( Bed , tx [ 3 ] , PROTOCOL_OP_READINGS , Payload ,
+                                         Testbed_Readings ( Bed , ( 0 != Length ) ? tx [ PROTOCOL_HEADER_LENGTH ] : 0 , Payload ) );
+                    break;
+
+                    case PROTOCOL_OP_STATUS:
+                    case PROTOCOL_OP_STATUS_N:
+                        Testbed_Frame  ( Bed , tx [ 3 ] , tx [ 4 ] , Payload , Testbed_Status ( Bed , tx [ 4 ] , Payload ) );
+                    break;
+
+                    default:
+                    break;
+                }
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    // Past its limit the link drops a bit somewhere in every transaction
+    if ( baud > Testbed_BaudMax )
+    {
+        rx [ Testbed_Stats.Transactions % length ] ^= 0x10;
+        Testbed_Stats.Corrupted++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+static void Testbed_Frame ( Testbed_Bed_t *bed , uint8_t sequence , uint8_t opcode , const uint8_t *payload , uint8_t length )
+{
+    uint16_t CRC = 0;
+
+    bed->Reply [ 0 ] = SYNC_BYTE;
+    bed->Reply [ 1 ] = PROTOCOL_VERSION;
+    bed->Reply [ 2 ] = length;
+    bed->Reply [ 3 ] = sequence;
+    bed->Reply [ 4 ] = opcode;
+
+    if ( 0 != length )
+    {
+        memcpy ( &bed->Reply [ PROTOCOL_HEADER_LENGTH ] , payload , length );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    CRC = Protocol_CRC16 ( &bed->Reply [ 1 ] , PROTOCOL_HEADER_LENGTH - 1 + length );
+    bed->Reply [ PROTOCOL_HEADER_LENGTH + length     ] = ( uint8_t ) ( CRC >> 8 );
+    bed->Reply [ PROTOCOL_HEADER_LENGTH + length + 1 ] = ( uint8_t ) CRC;
+}
+
+// Hex digits , least significant last , into a pass bitmap. Sensors past
+// SENSOR_COUNT have to be zero.
+static bool Testbed_Hex ( const char *text , uint8_t *pass )
+{
+    size_t Length       = strlen ( text );
+    uint   Digit        = 0;
+    uint   Sensor       = 0;
+    uint   Counter_Bit  = 0;
+    uint   Counter_Char = 0;
+    bool   Valid        = ( 0 != Length );
+
+    memset ( pass , 0 , SENSOR_BYTES );
+
+    for ( Counter_Char = 0 ; Valid && ( Counter_Char < Length ) ; Counter_Char++ )
+    {
+        Valid = ( 1 == sscanf ( &text [ Length - 1 - Counter_Char ] , "%1x" , &Digit ) );
+
+        for ( Counter_Bit = 0 ; Valid && ( Counter_Bit < 4 ) ; Counter_Bit++ )
+        {
+            Sensor = ( Counter_Char * 4 ) + Counter_Bit;
+
+            if ( ( ( Digit >> Counter_Bit ) & 1 ) && ( Sensor < SENSOR_COUNT ) )
+            {
+                pass [ Sensor / 8 ] |= ( uint8_t ) ( 1u << ( Sensor % 8 ) );
+            }
+            else if ( ( Digit >> Counter_Bit ) & 1 )    // Beyond the jig
+            {
+                Valid = false;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+    }
+
+    return Valid;
+}
+
+static bool Testbed_Parse ( const char *line )
+{
+    Testbed_Entry_t   *Entry = &Testbed_Script [ Testbed_Count ];
+    unsigned long long Time  = 0;
+    unsigned           Bed   = 0;
+    unsigned           Pin   = 0;
+    unsigned           Value = 0;
+    char               Hex   [ 65 ];
+    bool               Valid = true;
+
+    if ( ( '#' == line [ 0 ] ) || ( '\n' == line [ 0 ] ) || ( '\0' == line [ 0 ] ) )
+    {
+        // Nothing to do
+    }
+    else if ( ( Testbed_Count < TESTBED_SCRIPT_MAX ) && ( 'S' == line [ 0 ] ) && ( 3 <= sscanf ( &line [ 1 ] , "%llu %64s %u %u" , &Time , Hex , &Pin , &Bed ) ) &&
+              ( Bed < TESTBED_COUNT ) && Testbed_Hex ( Hex , Entry->Pass ) )
+    {
+        Entry->Type  = 'S';
+        Entry->Time  = Time * 1000;
+        Entry->Value = 0;
+        Entry->Pin   = ( uint8_t ) Pin;
+        Entry->Bed   = ( uint8_t ) Bed;
+        Testbed_Count++;
+    }
+    else if ( ( Testbed_Count < TESTBED_SCRIPT_MAX ) && ( 'B' == line [ 0 ] ) && ( 2 == sscanf ( &line [ 1 ] , "%llu %u" , &Time , &Pin ) ) && ( Pin < 256 ) )
+    {
+        Entry->Type  = 'B';
+        Entry->Time  = Time * 1000;
+        Entry->Value = 0;
+        Entry->Pin   = ( uint8_t ) Pin;
+        Testbed_Count++;
+    }
+    else if ( ( Testbed_Count < TESTBED_SCRIPT_MAX ) && ( 'P' == line [ 0 ] ) && ( 3 == sscanf ( &line [ 1 ] , "%llu %u %u" , &Time , &Pin , &Value ) ) && ( Pin < 32 ) )
+    {
+        Entry->Type  = 'P';
+        Entry->Time  = Time * 1000;
+        Entry->Value = Value;
+        Entry->Pin   = ( uint8_t ) Pin;
+        Testbed_Count++;
+    }
+    else
+    {
+        Valid = false;
+    }
+
+    return Valid;
+}
+
+// Apply every script entry that has fallen due , entries are in time order
+static void Testbed_Play ( void *arg )
+{
+    Testbed_Entry_t *Entry = NULL;
+
+    while ( ( Testbed_Next < Testbed_Count ) && ( Testbed_Script [ Testbed_Next ].Time <= Hal_Micros64 ( ) ) )
+    {
+        Entry = &Testbed_Script [ Testbed_Next++ ];
+
+        if ( 'S' == Entry->Type )
+        {
+            Testbed_Publish ( &Testbed_Beds [ Entry->Bed ] , Entry->Pass , Entry->Pin );
+        }
+        else if ( 'B' == Entry->Type )
+        {
+            Testbed_Level = Entry->Pin;
+        }
+        else
+        {
+            Host_SetInput ( Entry->Pin , 0 != Entry->Value );
+        }
+    }
+
+    if ( Testbed_Next < Testbed_Count )
+    {
+        Host_At ( Testbed_Script [ Testbed_Next ].Time , Testbed_Play , NULL );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+static void Testbed_Publish ( Testbed_Bed_t *bed , const uint8_t *pass , uint8_t pos )
+{
+    memmove ( bed->Pass , pass , sizeof ( bed->Pass ) );
+    bed->Pos = pos;
+    Testbed_Stats.Results++;
+
+    Host_SetInput ( DATA_READY_PIN , true );
+    Host_At ( Hal_Micros64 ( ) + TESTBED_PULSE_US , Testbed_PulseEnd , NULL );
+}
+
+static void Testbed_PulseEnd ( void *arg )
+{
+    Host_SetInput ( DATA_READY_PIN , false );
+}
+
+// Readings reply , the changes since generation held. A generation no
+// longer kept is answered with whole values for every sensor. Returns the
+// length.
+static uint8_t Testbed_Readings ( Testbed_Bed_t *bed , uint8_t held , uint8_t *payload )
+{
+    Testbed_Sent_t *Sent           = &bed->Sent [ bed->Generation % TESTBED_HISTORY ];
+    uint16_t        Known          [ SENSOR_COUNT ];
+    int32_t         Change         = 0;
+    uint8_t         Length         = 2;
+    uint8_t         Sensor         = 0;
+    uint8_t         Counter_Sensor = 0;
+    uint8_t         Counter_Sent   = 0;
+    bool            Found          = false;
+    bool            More           = false;
+
+    for ( Counter_Sent = 0 ; ( Counter_Sent < TESTBED_HISTORY ) && !Found ; Counter_Sent++ )
+    {
+        Found = ( 0 != held ) && ( held == bed->Sent [ Counter_Sent ].Generation );
+
+        if ( Found )
+        {
+            memcpy ( Known , bed->Sent [ Counter_Sent ].Value , sizeof ( Known ) );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    if ( !Found )
+    {
+        memset ( Known , 0xFF , sizeof ( Known ) );     // READINGS_NONE
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    // The new generation goes in the slot after the last one sent
+    bed->Generation = ( bed->Generation % READINGS_GENERATION ) + 1;
+    Sent            = &bed->Sent [ bed->Generation % TESTBED_HISTORY ];
+
+    for ( Counter_Sensor = 0 ; Counter_Sensor < SENSOR_COUNT ; Counter_Sensor++ )
+    {
+        Sensor = ( bed->First + Counter_Sensor ) % SENSOR_COUNT;
+        Change = ( int32_t ) bed->Reading [ Sensor ] - Known [ Sensor ];
+
+        if ( More || ( ( READINGS_NONE != Known [ Sensor ] ) && ( Change < TESTBED_DEADBAND ) && ( Change > -TESTBED_DEADBAND ) ) )
+        {
+            // Unchanged , or no room left
+        }
+        else if ( ( READINGS_NONE != Known [ Sensor ] ) && ( Change >= INT8_MIN ) && ( Change <= INT8_MAX ) && ( ( Length + 2 ) <= PROTOCOL_PAYLOAD_MAX ) )
+        {
+            payload [ Length++ ] = Sensor;
+            payload [ Length++ ] = ( uint8_t ) ( int8_t ) Change;
+            Known [ Sensor ]     = bed->Reading [ Sensor ];
+            Testbed_Stats.Readings++;
+        }
+        else if ( ( Length + 3 ) <= PROTOCOL_PAYLOAD_MAX )
+        {
+            payload [ Length++ ] = Sensor | READINGS_LONG;
+            payload [ Length++ ] = ( uint8_t ) ( bed->Reading [ Sensor ] >> 8 );
+            payload [ Length++ ] = ( uint8_t )   bed->Reading [ Sensor ];
+            Known [ Sensor ]     = bed->Reading [ Sensor ];
+            Testbed_Stats.Readings++;
+        }
+        else    // The rest go in the next reply , starting here
+        {
+            bed->First = Sensor;
+            More       = true;
+        }
+    }
+
+    memcpy ( Sent->Value , Known , sizeof ( Sent->Value ) );
+    Sent->Generation = bed->Generation;
+
+    payload [ 0 ] = bed->Generation | ( More ? READINGS_MORE : 0 );
+    payload [ 1 ] = held;
+
+    return Length;
+}
+
+// PROTOCOL_OP_STATUS : DAC state , sensor pass ( first 24 sensors , MSB
+// first ) , sensor position , flags , and the brightness once the script has
+// set one. PROTOCOL_OP_STATUS_N : DAC state , sensor position , flags ,
+// brightness , sensor count and the whole bitmap. Returns the length.
+static uint8_t Testbed_Status ( const Testbed_Bed_t *bed , uint8_t opcode , uint8_t *payload )
+{
+    uint8_t Length = 0;
+
+    if ( PROTOCOL_OP_STATUS_N == opcode )
+    {
+        payload [ 0 ] = DAC_CHECK_RUNNING;
+        payload [ 1 ] = bed->Pos;
+        payload [ 2 ] = ( 0 <= Testbed_Level ) ? PROTOCOL_FLAG_BRIGHTNESS : 0;
+        payload [ 3 ] = ( uint8_t ) Testbed_Level;
+        payload [ 4 ] = SENSOR_COUNT;
+        memcpy ( &payload [ PROTOCOL_STATUS_N_BASE ] , bed->Pass , SENSOR_BYTES );
+
+        Length = PROTOCOL_STATUS_N_BASE + SENSOR_BYTES;
+    }
+    else
+    {
+        payload [ 0 ] = DAC_CHECK_RUNNING;
+        payload [ 1 ] = bed->Pass [ 2 ];
+        payload [ 2 ] = bed->Pass [ 1 ];
+        payload [ 3 ] = bed->Pass [ 0 ];
+        payload [ 4 ] = bed->Pos;
+        payload [ 5 ] = ( 0 <= Testbed_Level ) ? PROTOCOL_FLAG_BRIGHTNESS : 0;
+        payload [ 6 ] = ( uint8_t ) Testbed_Level;
+
+        Length = ( 0 <= Testbed_Level ) ? 7 : 6;
+    }
+
+    return Length;
+}
+
+// Move every reading on one sample. arg is the test bed.
+static void Testbed_Sample ( void *arg )
+{
+    Testbed_Bed_t *Bed            = ( Testbed_Bed_t * ) arg;
+    int32_t        Target         = 0;
+    int32_t        Reading        = 0;
+    uint8_t        Counter_Sensor = 0;
+
+    for ( Counter_Sensor = 0 ; Counter_Sensor < SENSOR_COUNT ; Counter_Sensor++ )
+    {
+        Target  = ( Counter_Sensor == Bed->Pos ) ? Bed->Span [ Counter_Sensor ] : TESTBED_BASELINE;
+        Reading = Bed->Reading [ Counter_Sensor ];
+        Reading = Reading + ( ( Target - Reading ) / TESTBED_TAU_SAMPLES ) + ( int32_t ) ( Testbed_Xorshift ( &Bed->Noise ) % 7 ) - 3;
+        Reading = ( Reading < 0 ) ? 0 : ( ( Reading > READINGS_FULL_SCALE ) ? READINGS_FULL_SCALE : Reading );
+
+        Bed->Reading [ Counter_Sensor ] = ( uint16_t ) Reading;
+    }
+
+    Host_At ( Hal_Micros64 ( ) + ( TESTBED_SAMPLE_MS * 1000 ) , Testbed_Sample , Bed );
+}
+
+// Built in run , roughly one sensor in eight fails. arg is the test bed.
+static void Testbed_Step ( void *arg )
+{
+    Testbed_Bed_t *Bed = ( Testbed_Bed_t * ) arg;
+    uint8_t        Pass [ SENSOR_BYTES ];
+    uint8_t        Pos  = Bed->Pos;
+
+    memcpy ( Pass , Bed->Pass , sizeof ( Pass ) );
+
+    if ( Pos < SENSOR_COUNT )
+    {
+        Pass [ Pos / 8 ] |= ( 0 != ( Testbed_Xorshift ( &Bed->Random ) & 7 ) ) ? ( 1u << ( Pos % 8 ) ) : 0;
+        Pos++;
+    }
+    else    // Next jig load
+    {
+        memset ( Pass , 0 , sizeof ( Pass ) );
+        Pos  = 0;
+    }
+
+    if ( !Testbed_Silent ( ( uint8_t ) ( Bed - Testbed_Beds ) ) )
+    {
+        Testbed_Publish ( Bed , Pass , Pos );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Host_At ( Hal_Micros64 ( ) + ( TESTBED_STEP_MS * 1000 ) , Testbed_Step , Bed );
+}
+
+// True once bed is the HOST_MUTE bed and TESTBED_MUTE_MS has passed
+static bool Testbed_Silent ( uint8_t bed )
+{
+    return ( ( int ) bed == Testbed_Mute ) && ( Hal_Micros64 ( ) >= ( TESTBED_MUTE_MS * 1000ull ) );
+}
+
+// HOST_BUTTONS , every switch changes state at once so their events settle
+// together and queue behind one another.
+static void Testbed_Storm ( void *arg )
+{
+    static const uint Pins           [ 4 ] = { SW1 , SW2 , SW3 , SW4 };
+
+    uint              Counter_Switch = 0;
+
+    Testbed_Held = !Testbed_Held;
+
+    for ( Counter_Switch = 0 ; Counter_Switch < 4 ; Counter_Switch++ )
+    {
+        Host_SetInput ( Pins [ Counter_Switch ] , Testbed_Held );
+    }
+
+    Host_At ( Hal_Micros64 ( ) + Testbed_Toggle , Testbed_Storm , NULL );
+}
+
+// Next value of a xorshift generator , the low byte
+static uint8_t Testbed_Xorshift ( uint32_t *state )
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state <<  5;
+
+    return ( uint8_t ) *state;
+}
+
+/*** end of file ***/
@@ -0,0 +1,61 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           testbed.h                                             *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __TESTBED_H
+#define __TESTBED_H
+
+#include <main.h>
+#include <protocol.h>
+
+// Stand-in for the TESTBED_COUNT test beds on the far end of the SPI link
+#define TESTBED_BAUD_MAX        4000000 // Replies above this clock are corrupted
+#define TESTBED_BUTTONS_MS      1000    // HOST_BUTTONS switches start toggling here
+#define TESTBED_MUTE_MS         2000    // HOST_MUTE bed goes silent from here
+#define TESTBED_PULSE_US        50      // DATA_READY_PIN high time
+#define TESTBED_STEP_MS         300     // Built in run , time per sensor
+
+// Readings , one sample of every sensor each TESTBED_SAMPLE_MS. The sensor
+// under test rises to its span with a first order response , the others
+// settle back to the baseline , all with a little noise.
+#define TESTBED_BASELINE        200     // Counts , out of READINGS_FULL_SCALE
+#define TESTBED_DEADBAND        8       // Changes smaller than this are not sent
+#define TESTBED_HISTORY         ( PROTOCOL_WINDOW + 1 )    // Generations kept
+#define TESTBED_SAMPLE_MS       50
+#define TESTBED_SPAN_MIN        2600
+#define TESTBED_SPAN_RANGE      1000
+#define TESTBED_TAU_SAMPLES     4       // Time constant , in samples
+
+typedef struct
+{
+    uint32_t Buttons;       // Button events received
+    uint32_t Corrupted;     // Replies damaged for running above the clock limit
+    uint32_t Readings;      // Reading entries sent
+    uint32_t Requests;      // Valid v2 requests
+    uint32_t Results;       // Sensor results published
+    uint32_t Transactions;
+} Testbed_Stats_t;
+
+extern Testbed_Stats_t Testbed_Stats;
+
+void Testbed_Init     ( void );
+int  Testbed_Muted    ( void );
+void Testbed_Transfer ( uint8_t bed , const uint8_t *tx , uint8_t *rx , uint8_t length , uint32_t baud );
+
+#endif /* __TESTBED_H */
+
+/*** end of file ***/
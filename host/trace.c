@@ -0,0 +1,290 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           trace.c                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <trace.h>
+#include <check.h>
+
+#include <stdlib.h>
+
+typedef struct
+{
+    uint64_t Time;
+    uint32_t Order;     // Arrival , keeps changes at the same time in order
+    uint8_t  Signal;
+    uint8_t  Value;
+} Trace_Change_t;
+
+typedef struct
+{
+    uint        Signal;
+    const char *Name;
+} Trace_Name_t;
+
+static const Trace_Name_t Trace_Names [ ] = {
+    { BIT_A_PIN      , "BIT_A"      } , { BIT_B_PIN      , "BIT_B"      } , { BIT_C_PIN    , "BIT_C"    } , { BIT_D_PIN    , "BIT_D"    } ,
+    { LED_R1_PIN     , "R1"         } , { LED_G1_PIN     , "G1"         } , { LED_B1_PIN   , "B1"       } ,
+    { LED_R2_PIN     , "R2"         } , { LED_G2_PIN     , "G2"         } , { LED_B2_PIN   , "B2"       } ,
+    { MATRIX_CLK_PIN , "MATRIX_CLK" } , { MATRIX_LAT_PIN , "MATRIX_LAT" } , { MATRIX_OE_PIN , "MATRIX_OE" } ,
+    { SPI_CS_PIN     , "SPI_CS"     } , { SPI_SCK_PIN    , "SPI_SCK"    } , { SPI_MOSI_PIN , "SPI_MOSI" } , { SPI_MISO_PIN , "SPI_MISO" } ,
+    { SPI_CS1_PIN    , "SPI_CS1"    } , { SPI_CS2_PIN    , "SPI_CS2"    } , { SPI_CS3_PIN  , "SPI_CS3"  } ,
+    { TRACE_SPI_TX   , "SPI_TX"     } , { TRACE_SPI_RX   , "SPI_RX"     } ,
+    { DATA_READY_PIN , "DATA_READY" } , { LED_PICO_PIN   , "LED_PICO"   } ,
+    { SW1            , "SW1"        } , { SW2            , "SW2"        } , { SW3          , "SW3"      } , { SW4          , "SW4"      } ,
+};
+
+static Trace_Change_t *Trace_Changes  = NULL;
+static uint32_t        Trace_Count    = 0;
+static uint32_t        Trace_Size     = 0;
+static uint64_t        Trace_End      = 0;
+static uint64_t        Trace_Start    = 0;
+static bool            Trace_Check    = false;
+static FILE           *Trace_File     = NULL;
+static uint8_t         Trace_Initial [ TRACE_SIGNALS ];    // Value at the window start
+static uint64_t        Trace_Latest  [ TRACE_SIGNALS ];    // Time of the latest change before the window
+static uint8_t         Trace_Value   [ TRACE_SIGNALS ];    // Last value recorded
+
+static int  Trace_Compare ( const void *a , const void *b );
+static void Trace_Record  ( uint64_t time , uint signal , uint8_t value );
+static void Trace_Write   ( uint signal , uint8_t value );
+
+bool Trace_Active ( void )
+{
+    return Trace_Check || ( NULL != Trace_File );
+}
+
+// Sort the window and write it out , changes only
+void Trace_Close ( void )
+{
+    uint Counter_Change = 0;
+    uint Counter_Name   = 0;
+
+    if ( NULL != Trace_File )
+    {
+        qsort ( Trace_Changes , Trace_Count , sizeof ( Trace_Changes [ 0 ] ) , Trace_Compare );
+
+        fprintf ( Trace_File , "$version jig_host $end\n$timescale 1ns $end\n$scope module jig $end\n" );
+
+        for ( Counter_Name = 0 ; Counter_Name < count_of ( Trace_Names ) ; Counter_Name++ )
+        {
+            fprintf ( Trace_File , "$var wire %u %c %s $end\n" , ( Trace_Names [ Counter_Name ].Signal >= TRACE_SPI_TX ) ? 8u : 1u ,
+                      '!' + Trace_Names [ Counter_Name ].Signal , Trace_Names [ Counter_Name ].Name );
+        }
+
+        fprintf ( Trace_File , "$upscope $end\n$enddefinitions $end\n#%llu\n$dumpvars\n" , ( unsigned long long ) Trace_Start );
+
+        for ( Counter_Name = 0 ; Counter_Name < count_of ( Trace_Names ) ; Counter_Name++ )
+        {
+            Trace_Value [ Trace_Names [ Counter_Name ].Signal ] = Trace_Initial [ Trace_Names [ Counter_Name ].Signal ];
+        }
+
+        for ( Counter_Name = 0 ; Counter_Name < count_of ( Trace_Names ) ; Counter_Name++ )
+        {
+            Trace_Write ( Trace_Names [ Counter_Name ].Signal , Trace_Initial [ Trace_Names [ Counter_Name ].Signal ] );
+        }
+
+        fprintf ( Trace_File , "$end\n" );
+
+        for ( Counter_Change = 0 ; Counter_Change < Trace_Count ; Counter_Change++ )
+        {
+            if ( Trace_Changes [ Counter_Change ].Value != Trace_Value [ Trace_Changes [ Counter_Change ].Signal ] )
+            {
+                Trace_Value [ Trace_Changes [ Counter_Change ].Signal ] = Trace_Changes [ Counter_Change ].Value;
+
+                if ( ( 0 == Counter_Change ) || ( Trace_Changes [ Counter_Change ].Time != Trace_Changes [ Counter_Change - 1 ].Time ) )
+                {
+                    fprintf ( Trace_File , "#%llu\n" , ( unsigned long long ) Trace_Changes [ Counter_Change ].Time );
+                }
+                else
+                {
+                    // Nothing to do
+                }
+
+                Trace_Write ( Trace_Changes [ Counter_Change ].Signal , Trace_Changes [ Counter_Change ].Value );
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+
+        fprintf ( Trace_File , "#%llu\n" , ( unsigned long long ) Trace_End );
+        fclose  ( Trace_File );
+        Trace_File = NULL;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+void Trace_Init ( void )
+{
+    const char *Check  = getenv ( "HOST_CHECK"        );
+    const char *File   = getenv ( "HOST_VCD"          );
+    const char *Length = getenv ( "HOST_VCD_MS"       );
+    const char *Start  = getenv ( "HOST_VCD_START_MS" );
+
+    Trace_Check = ( NULL != Check ) && ( '1' == Check [ 0 ] );
+    Trace_File  = ( NULL != File  ) ? fopen ( File , "w" ) : NULL;
+    Trace_Start = ( ( NULL != Start  ) ? strtoull ( Start  , NULL , 0 ) : TRACE_START_MS  ) * 1000000ull;
+    Trace_End   = ( ( NULL != Length ) ? strtoull ( Length , NULL , 0 ) : TRACE_LENGTH_MS ) * 1000000ull + Trace_Start;
+
+    if ( ( NULL != File ) && ( NULL == Trace_File ) )
+    {
+        perror ( File );
+        exit ( EXIT_FAILURE );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+void Trace_Pin ( uint64_t time , uint pin , bool level )
+{
+    if ( Trace_Check )
+    {
+        Check_Pin ( time , pin , level );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Trace_Record ( time , pin , level );
+}
+
+// Mode 0 , most significant bit first , the byte wide signals change at each
+// byte. cs is the chip select pin of the test bed addressed.
+void Trace_SPI ( uint64_t time , uint cs , const uint8_t *tx , const uint8_t *rx , uint8_t length , uint32_t baud )
+{
+    uint64_t Bit          = 1000000000ull / baud;
+    uint     Counter_Bit  = 0;
+    uint     Counter_Byte = 0;
+
+    if ( NULL != Trace_File )
+    {
+        Trace_Pin ( time , cs , false );
+
+        for ( Counter_Byte = 0 ; Counter_Byte < length ; Counter_Byte++ )
+        {
+            Trace_Record ( time , TRACE_SPI_TX , tx [ Counter_Byte ] );
+            Trace_Record ( time , TRACE_SPI_RX , rx [ Counter_Byte ] );
+
+            for ( Counter_Bit = 0 ; Counter_Bit < 8 ; Counter_Bit++ )
+            {
+                Trace_Pin ( time               , SPI_SCK_PIN  , false );
+                Trace_Pin ( time               , SPI_MISO_PIN , ( tx [ Counter_Byte ] >> ( 7 - Counter_Bit ) ) & 1 );
+                Trace_Pin ( time               , SPI_MOSI_PIN , ( rx [ Counter_Byte ] >> ( 7 - Counter_Bit ) ) & 1 );
+                Trace_Pin ( time + ( Bit / 2 ) , SPI_SCK_PIN  , true  );
+                time += Bit;
+            }
+        }
+
+        Trace_Pin ( time , SPI_SCK_PIN , false );
+        Trace_Pin ( time , cs          , true  );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+static int Trace_Compare ( const void *a , const void *b )
+{
+    const Trace_Change_t *A      = a;
+    const Trace_Change_t *B      = b;
+    int                   Result = 0;
+
+    if ( A->Time != B->Time )
+    {
+        Result = ( A->Time < B->Time ) ? -1 : 1;
+    }
+    else
+    {
+        Result = ( A->Order < B->Order ) ? -1 : 1;
+    }
+
+    return Result;
+}
+
+// Keep the change if it falls in the window , or the value at its start
+static void Trace_Record ( uint64_t time , uint signal , uint8_t value )
+{
+    if ( NULL == Trace_File )
+    {
+        // Nothing to do
+    }
+    else if ( time < Trace_Start )
+    {
+        if ( time >= Trace_Latest [ signal ] )
+        {
+            Trace_Initial [ signal ] = value;
+            Trace_Latest  [ signal ] = time;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else if ( time < Trace_End )
+    {
+        if ( Trace_Count == Trace_Size )
+        {
+            Trace_Size    = ( 0 != Trace_Size ) ? ( Trace_Size * 2 ) : 65536;
+            Trace_Changes = realloc ( Trace_Changes , Trace_Size * sizeof ( Trace_Changes [ 0 ] ) );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Trace_Changes [ Trace_Count ].Time   = time;
+        Trace_Changes [ Trace_Count ].Order  = Trace_Count;
+        Trace_Changes [ Trace_Count ].Signal = ( uint8_t ) signal;
+        Trace_Changes [ Trace_Count ].Value  = value;
+        Trace_Count++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Identifiers are one character , '!' onwards by signal number
+static void Trace_Write ( uint signal , uint8_t value )
+{
+    uint Counter_Bit = 0;
+
+    if ( signal >= TRACE_SPI_TX )
+    {
+        fputc ( 'b' , Trace_File );
+
+        for ( Counter_Bit = 0 ; Counter_Bit < 8 ; Counter_Bit++ )
+        {
+            fputc ( '0' + ( ( value >> ( 7 - Counter_Bit ) ) & 1 ) , Trace_File );
+        }
+
+        fprintf ( Trace_File , " %c\n" , '!' + signal );
+    }
+    else
+    {
+        fprintf ( Trace_File , "%u%c\n" , value , '!' + signal );
+    }
+}
+
+/*** end of file ***/
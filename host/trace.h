@@ -0,0 +1,50 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           trace.h                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __TRACE_H
+#define __TRACE_H
+
+#include <main.h>
+
+// Signal timeline of the host build in ns of virtual time : every pin
+// change from Hal_GpioPut and Host_SetInput , the HUB75 lines as the PIO
+// programs would drive them ( hub75_host.c ) and the SPI link bit by bit.
+// Changes go to the timing checks and , inside the HOST_VCD window , to a
+// VCD file for GTKWave. Changes may arrive up to a frame ahead of the
+// clock , the VCD is sorted when it is written.
+//
+// Environment :
+//   HOST_VCD           File to write
+//   HOST_VCD_START_MS  Window start , default TRACE_START_MS
+//   HOST_VCD_MS        Window length , default TRACE_LENGTH_MS
+//   HOST_CHECK         1 to run the timing checks over the whole run
+#define TRACE_LENGTH_MS     20
+#define TRACE_START_MS      1000
+#define TRACE_SPI_TX        32      // Byte wide signals after the pins
+#define TRACE_SPI_RX        33
+#define TRACE_SIGNALS       34
+
+bool Trace_Active ( void );     // Pin level detail wanted , VCD or checks
+void Trace_Close  ( void );
+void Trace_Init   ( void );
+void Trace_Pin    ( uint64_t time , uint pin , bool level );
+void Trace_SPI    ( uint64_t time , uint cs , const uint8_t *tx , const uint8_t *rx , uint8_t length , uint32_t baud );
+
+#endif /* __TRACE_H */
+
+/*** end of file ***/
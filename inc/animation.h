@@ -0,0 +1,42 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           animation.h                                           *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __ANIMATION_H
+#define __ANIMATION_H
+
+#include <main.h>
+
+// Tile effects , every one starting from the plain colour at keyframe 0
+#define ANIMATION_NONE              0   // Plain colour
+#define ANIMATION_BLINK             1   // Colour and off , half the cycle each
+#define ANIMATION_PULSE             2   // Fades down to ANIMATION_PULSE_MIN and back
+#define ANIMATION_CHASE             3   // One pixel in full colour runs round the border of a dimmed tile
+
+#define ANIMATION_CHASE_DIM         4   // Chase background , colour divided by this
+#define ANIMATION_FRAMES_PER_KEY    4   // Refresh frames per keyframe , about 30 ms
+#define ANIMATION_KEYFRAMES         16  // Keyframes per cycle
+#define ANIMATION_PULSE_MIN         48  // Darkest pulse level , out of 255
+#define ANIMATION_SLOTS             MATRIX_SLOTS
+
+uint32_t Animation_Bar   ( uint8_t slot , uint8_t lit );
+uint32_t Animation_Start ( uint8_t slot , uint row , uint column , uint8_t effect , uint32_t colour );
+uint32_t Animation_Step  ( void );
+
+#endif /* __ANIMATION_H */
+
+/*** end of file ***/
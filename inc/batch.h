@@ -0,0 +1,65 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           batch.h                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __BATCH_H
+#define __BATCH_H
+
+#include <main.h>
+#include <protocol.h>
+
+// Queued button events and a status read share one PROTOCOL_OP_BATCH frame :
+//   Request [ 0 ]     BATCH_STATUS | BATCH_STATUS_N | button count
+//           [ 1 ] ... Mask , BUTTON_EVENT type per button
+//   Reply   [ 0 ]     Buttons acted on , in order from the first
+//           [ 1 ] ... Status reply payload , if requested , PROTOCOL_OP_STATUS_N
+//                     layout with BATCH_STATUS_N
+// Buttons the test bed did not acknowledge go at the front of the next batch.
+// Buttons only go to BATCH_BUTTON_BED , other test beds are only read.
+//
+// Building with BATCH_SINGLE=1 sends one command per frame , a button or
+// a status read , as the exchange did before batching. It is only there for
+// comparison , see batch_bench in host/CMakeLists.txt.
+#ifndef BATCH_SINGLE
+#define BATCH_SINGLE        0
+#endif
+
+#define BATCH_BUTTON_BED    0
+#define BATCH_ITEMS_MAX     ( ( PROTOCOL_PAYLOAD_MAX - 1 ) / 2 )
+#define BATCH_COUNT_MASK    0x0F
+#define BATCH_STATUS        0x80
+#define BATCH_STATUS_N      0x40
+#define BATCH_STATUS_JIG    ( ( PROTOCOL_OP_STATUS_N == PROTOCOL_OP_STATUS_JIG ) ? ( BATCH_STATUS | BATCH_STATUS_N ) : BATCH_STATUS )
+
+typedef struct
+{
+    uint32_t Acknowledged;  // Buttons acted on by the test bed
+    uint32_t Batches;       // Transactions sent
+    uint32_t Items;         // Buttons sent , including resends
+    uint32_t Lost;          // Buttons in a batch that was never answered
+    uint32_t Resent;        // Buttons sent again after a partial acknowledgement
+} Batch_Stats_t;
+
+extern volatile Batch_Stats_t Batch_Stats;
+
+uint8_t Batch_Build  ( bool *status , uint8_t *tx );
+bool    Batch_Reply  ( const Protocol_Frame_t *frame , Protocol_Status_t *status );
+void    Batch_Select ( uint8_t bed );
+
+#endif /* __BATCH_H */
+
+/*** end of file ***/
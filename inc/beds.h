@@ -0,0 +1,45 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           beds.h                                                *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __BEDS_H
+#define __BEDS_H
+
+#include <main.h>
+
+// Freshness of each test bed's status. Beds are polled in turn , so a bed
+// that stops answering must not leave its last result on the panel looking
+// current. Once its status is BEDS_STALE_MS old its tiles show unknown.
+#define BEDS_STALE_MS       5000
+
+typedef struct
+{
+    uint32_t Age;           // Since the last status , updated by Beds_Stale ( us )
+    uint32_t AgeMax;        // Longest gap between statuses ( us )
+    uint32_t Statuses;      // Status replies decoded
+    uint32_t Stale;         // Times the bed went stale
+} Beds_Stats_t;
+
+extern volatile Beds_Stats_t Beds_Stats [ TESTBED_COUNT ];
+
+void Beds_Init     ( void );
+void Beds_Received ( uint8_t bed );
+bool Beds_Stale    ( uint8_t bed );
+
+#endif /* __BEDS_H */
+
+/*** end of file ***/
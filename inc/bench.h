@@ -0,0 +1,56 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           bench.h                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include <main.h>
+
+// Refresh engine benchmark , all times in clk_sys cycles from Hal_Cycles.
+// Stages that run on a CPU are measured , the PIO stages come from
+// Hub75_Timing. Bench_Report prints both as one JSON line so a run can be
+// kept as a baseline and compared after each refresh engine change.
+// Building with BENCH defined prints it every BENCH_REPORT_MS on target ,
+// the host build prints it at the end of a run with HOST_BENCH=1.
+#define BENCH_STAGE_COMPOSE     0   // Core 0 , Matrix_Compose and Hub75_Present
+#define BENCH_STAGE_FRAME       1   // Core 1 , frame boundary to frame boundary
+#define BENCH_STAGE_SWAP        2   // Core 1 , frame interrupt including the buffer swap
+#define BENCH_STAGE_TEXT        3   // Core 0 , status labels , per character drawn
+#define BENCH_STAGES            4
+#define BENCH_REPORT_MS         1000
+
+// Each stage has a single writer , so no locking between the cores
+typedef struct
+{
+    uint32_t Count;
+    uint32_t Last;
+    uint32_t Max;
+    uint32_t Min;
+    uint64_t Total;
+} Bench_Stage_t;
+
+extern volatile Bench_Stage_t Bench_Stages [ BENCH_STAGES ];
+
+void Bench_Add    ( uint stage , uint32_t cycles );
+void Bench_Report ( void );
+void Bench_Reset  ( void );
+void Bench_Stop   ( uint stage , uint32_t start );  // start from Hal_Cycles
+
+#endif /* __BENCH_H */
+
+/*** end of file ***/
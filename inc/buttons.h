@@ -0,0 +1,63 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           buttons.h                                             *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __BUTTONS_H
+#define __BUTTONS_H
+
+#include <main.h>
+
+// SW1 to SW4 are sampled BUTTON_DEBOUNCE_MS after their last edge , so a
+// bouncing contact produces a single event. Events are queued in order
+// and the oldest is kept if the queue fills.
+#define BUTTON_COUNT            4
+#define BUTTON_DEBOUNCE_MS      20
+#define BUTTON_LONG_MS          1000    // Held this long from the first edge
+#define BUTTON_QUEUE_LENGTH     16      // Power of two
+
+// Event types
+#define BUTTON_EVENT_PRESS      0
+#define BUTTON_EVENT_RELEASE    1
+#define BUTTON_EVENT_LONG       2
+#define BUTTON_EVENT_CHORD      3       // Press while other switches are held , Mask holds them all
+
+typedef struct
+{
+    uint32_t Time;  // Hal_Micros of the first edge , for LONG when the hold was recognised
+    uint8_t  Mask;  // SW1 bit 0 to SW4 bit 3 , as the original button command
+    uint8_t  Type;
+} Button_Event_t;
+
+typedef struct
+{
+    uint32_t Dropped;       // Events lost to a full queue
+    uint32_t Edges;         // Raw edges , including bounce
+    uint32_t Events;        // Events queued
+    uint32_t Latency;       // Most recent Button_Event_t.Time to command ( us )
+    uint32_t LatencyMax;    // Longest Button_Event_t.Time to command ( us )
+    uint32_t Sent;          // Events sent to the test bed
+} Buttons_Stats_t;
+
+extern volatile Buttons_Stats_t Buttons_Stats;
+
+bool Buttons_Get  ( Button_Event_t *event );
+void Buttons_Init ( void );
+void Buttons_Sent ( const Button_Event_t *event );
+
+#endif /* __BUTTONS_H */
+
+/*** end of file ***/
@@ -0,0 +1,110 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           font.h                                                *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __FONT_H
+#define __FONT_H
+
+#include <stdint.h>
+
+// Fixed 3 x 5 font , FONT_FIRST to FONT_LAST , held in flash in the
+// framebuffer's layout : per glyph and pixel row one word with 0xFF in the
+// byte lane of each lit column , lane c for column c. Glyphs are written
+// below as three 5 bit column bitmaps , column c in bits 5c to 5c + 4 with
+// the top row in the lowest bit , and FONT_LANES spreads each into its row
+// words as the table is compiled. Glyphs sit FONT_PITCH columns apart , one
+// framebuffer word each. Lower case is drawn as upper case and anything
+// else outside the range as '?'.
+#define FONT_FIRST          ' '
+#define FONT_GLYPHS         ( FONT_LAST - FONT_FIRST + 1 )
+#define FONT_HEIGHT         5
+#define FONT_LAST           'Z'
+#define FONT_PITCH          4   // Columns per character , the glyph and a gap
+#define FONT_WIDTH          3
+
+#define FONT_LANE( glyph , column , row )   ( ( ( ( glyph ) >> ( ( ( column ) * FONT_HEIGHT ) + ( row ) ) ) & 1 ) ? ( 0xFFu << ( ( column ) * 8 ) ) : 0 )
+#define FONT_ROW( glyph , row )             ( FONT_LANE ( glyph , 0 , row ) | FONT_LANE ( glyph , 1 , row ) | FONT_LANE ( glyph , 2 , row ) )
+#define FONT_LANES( glyph )                 { FONT_ROW ( glyph , 0 ) , FONT_ROW ( glyph , 1 ) , FONT_ROW ( glyph , 2 ) , FONT_ROW ( glyph , 3 ) , FONT_ROW ( glyph , 4 ) }
+
+_Static_assert ( ( FONT_WIDTH == 3 ) && ( FONT_HEIGHT == 5 ) , "FONT_LANES spreads three columns of five rows" );
+
+// Columns right to left , top row rightmost
+static const uint32_t Font_Lanes [ FONT_GLYPHS ] [ FONT_HEIGHT ] = {
+    FONT_LANES ( 0x0000 ) ,     // ' '   00000 00000 00000
+    FONT_LANES ( 0x02E0 ) ,     // '!'   00000 10111 00000
+    FONT_LANES ( 0x0C03 ) ,     // '"'   00011 00000 00011
+    FONT_LANES ( 0x7D5F ) ,     // '#'   11111 01010 11111
+    FONT_LANES ( 0x27F2 ) ,     // '$'   01001 11111 10010
+    FONT_LANES ( 0x4889 ) ,     // '%'   10010 00100 01001
+    FONT_LANES ( 0x6AAA ) ,     // '&'   11010 10101 01010
+    FONT_LANES ( 0x0060 ) ,     // '\''  00000 00011 00000
+    FONT_LANES ( 0x45C0 ) ,     // '('   10001 01110 00000
+    FONT_LANES ( 0x01D1 ) ,     // ')'   00000 01110 10001
+    FONT_LANES ( 0x288A ) ,     // '*'   01010 00100 01010
+    FONT_LANES ( 0x11C4 ) ,     // '+'   00100 01110 00100
+    FONT_LANES ( 0x0110 ) ,     // ','   00000 01000 10000
+    FONT_LANES ( 0x1084 ) ,     // '-'   00100 00100 00100
+    FONT_LANES ( 0x0200 ) ,     // '.'   00000 10000 00000
+    FONT_LANES ( 0x0C98 ) ,     // '/'   00011 00100 11000
+    FONT_LANES ( 0x7E3F ) ,     // '0'   11111 10001 11111
+    FONT_LANES ( 0x43F2 ) ,     // '1'   10000 11111 10010
+    FONT_LANES ( 0x5EBD ) ,     // '2'   10111 10101 11101
+    FONT_LANES ( 0x7EB5 ) ,     // '3'   11111 10101 10101
+    FONT_LANES ( 0x7C87 ) ,     // '4'   11111 00100 00111
+    FONT_LANES ( 0x76B7 ) ,     // '5'   11101 10101 10111
+    FONT_LANES ( 0x76BF ) ,     // '6'   11101 10101 11111
+    FONT_LANES ( 0x7C21 ) ,     // '7'   11111 00001 00001
+    FONT_LANES ( 0x7EBF ) ,     // '8'   11111 10101 11111
+    FONT_LANES ( 0x7EB7 ) ,     // '9'   11111 10101 10111
+    FONT_LANES ( 0x0140 ) ,     // ':'   00000 01010 00000
+    FONT_LANES ( 0x0150 ) ,     // ';'   00000 01010 10000
+    FONT_LANES ( 0x4544 ) ,     // '<'   10001 01010 00100
+    FONT_LANES ( 0x294A ) ,     // '='   01010 01010 01010
+    FONT_LANES ( 0x1151 ) ,     // '>'   00100 01010 10001
+    FONT_LANES ( 0x0AA1 ) ,     // '?'   00010 10101 00001
+    FONT_LANES ( 0x5AAE ) ,     // '@'   10110 10101 01110
+    FONT_LANES ( 0x78BE ) ,     // 'A'   11110 00101 11110
+    FONT_LANES ( 0x2ABF ) ,     // 'B'   01010 10101 11111
+    FONT_LANES ( 0x462E ) ,     // 'C'   10001 10001 01110
+    FONT_LANES ( 0x3A3F ) ,     // 'D'   01110 10001 11111
+    FONT_LANES ( 0x46BF ) ,     // 'E'   10001 10101 11111
+    FONT_LANES ( 0x04BF ) ,     // 'F'   00001 00101 11111
+    FONT_LANES ( 0x762E ) ,     // 'G'   11101 10001 01110
+    FONT_LANES ( 0x7C9F ) ,     // 'H'   11111 00100 11111
+    FONT_LANES ( 0x47F1 ) ,     // 'I'   10001 11111 10001
+    FONT_LANES ( 0x3E08 ) ,     // 'J'   01111 10000 01000
+    FONT_LANES ( 0x6C9F ) ,     // 'K'   11011 00100 11111
+    FONT_LANES ( 0x421F ) ,     // 'L'   10000 10000 11111
+    FONT_LANES ( 0x7CDF ) ,     // 'M'   11111 00110 11111
+    FONT_LANES ( 0x783F ) ,     // 'N'   11110 00001 11111
+    FONT_LANES ( 0x3A2E ) ,     // 'O'   01110 10001 01110
+    FONT_LANES ( 0x08BF ) ,     // 'P'   00010 00101 11111
+    FONT_LANES ( 0x5B2E ) ,     // 'Q'   10110 11001 01110
+    FONT_LANES ( 0x68BF ) ,     // 'R'   11010 00101 11111
+    FONT_LANES ( 0x26B2 ) ,     // 'S'   01001 10101 10010
+    FONT_LANES ( 0x07E1 ) ,     // 'T'   00001 11111 00001
+    FONT_LANES ( 0x7E1F ) ,     // 'U'   11111 10000 11111
+    FONT_LANES ( 0x3E0F ) ,     // 'V'   01111 10000 01111
+    FONT_LANES ( 0x7D9F ) ,     // 'W'   11111 01100 11111
+    FONT_LANES ( 0x6C9B ) ,     // 'X'   11011 00100 11011
+    FONT_LANES ( 0x0F83 ) ,     // 'Y'   00011 11100 00011
+    FONT_LANES ( 0x4EB9 ) ,     // 'Z'   10011 10101 11001
+};
+
+#endif /* __FONT_H */
+
+/*** end of file ***/
@@ -0,0 +1,90 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           hal.h                                                 *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __HAL_H
+#define __HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Everything outside the display and SPI drivers reaches the hardware
+// through these calls. hal_rp2040.c maps them onto the Pico SDK and
+// host/hal_linux.c runs them against a virtual clock on a PC , selected
+// by building with HAL_LINUX defined. hub75.h and spi_link.h are the
+// display and SPI halves of the HAL , each with its own host backend.
+#ifdef HAL_LINUX
+typedef unsigned int uint;
+
+#define count_of(a)         ( sizeof ( a ) / sizeof ( ( a ) [ 0 ] ) )
+#else
+#include <pico/stdlib.h>
+#endif
+
+// Hal_Cycles counts clk_sys cycles in 24 bits , wrapping every 134 ms at 125 MHz
+#define HAL_CYCLES_MASK     0x00FFFFFFu
+
+// GPIO interrupt edges , the RP2040 GPIO_IRQ_EDGE_ values
+#define HAL_EDGE_FALL       0x04u
+#define HAL_EDGE_RISE       0x08u
+
+typedef void    ( *Hal_Handler_t       ) ( void );
+typedef int64_t ( *Hal_TimerCallback_t ) ( int32_t id , void *user_data );   // > 0 runs again that many us later
+
+// Start up
+void     Hal_Init         ( void );
+
+// Time
+uint32_t Hal_ClockHz      ( void );
+uint32_t Hal_Cycles       ( void );         // Per core , see Hal_CyclesStart
+void     Hal_CyclesStart  ( void );         // Done for core 0 by Hal_Init
+void     Hal_DelayUs      ( uint32_t us );
+uint32_t Hal_Micros       ( void );
+uint64_t Hal_Micros64     ( void );
+
+// GPIO
+uint32_t Hal_GpioEvents   ( uint pin );     // Pending edges , acknowledged
+bool     Hal_GpioGet      ( uint pin );
+void     Hal_GpioInput    ( uint pin , bool pull_down );
+void     Hal_GpioIrq      ( uint32_t pins , uint32_t edges , Hal_Handler_t handler );
+void     Hal_GpioOutput   ( uint pin );
+void     Hal_GpioPut      ( uint pin , bool level );
+
+// Host port , USB serial on target
+bool     Hal_HostConnected ( void );
+void     Hal_HostWrite    ( const uint8_t *data , uint32_t length );   // Raw bytes , no line ending translation
+
+// Interrupts
+void     Hal_Barrier      ( void );
+uint32_t Hal_IrqDisable   ( void );
+void     Hal_IrqRestore   ( uint32_t state );
+
+// One shot timers
+void     Hal_TimerCancel  ( int32_t id );
+int32_t  Hal_TimerStart   ( uint32_t delay_us , Hal_TimerCallback_t callback , void *user_data );
+
+// Sleep , Hal_Sleep is called with interrupts disabled and returns once one is pending
+void     Hal_Sleep        ( void );
+bool     Hal_WakeAt       ( uint64_t time );    // False if time has already passed
+
+// Watchdog
+void     Hal_WatchdogFeed ( void );
+
+#endif /* __HAL_H */
+
+/*** end of file ***/
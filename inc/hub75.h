@@ -0,0 +1,85 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           hub75.h                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __HUB75_H
+#define __HUB75_H
+
+#include <main.h>
+#include <jitter.h>
+
+#define HUB75_PIO               pio0
+#define HUB75_ADDRESS_BASE_PIN  BIT_B_PIN   // Row address , GPIO 24 to 29
+#define HUB75_RGB_BASE_PIN      LED_G1_PIN  // Colour      , GPIO  7 to 12
+#define HUB75_CLK_DIV           4.0f        // hub75_data cycle = 32 ns at 125 MHz
+#ifndef HUB75_COLOUR_DEPTH
+#define HUB75_COLOUR_DEPTH      4           // Bits per channel , 1 to 8 ( binary code modulation )
+#endif
+#define HUB75_SCAN_LINES        ( MATRIX_HEIGHT / 2 )   // Rows n and n + 16 share a line
+#define HUB75_WORDS_PER_LINE    ( MATRIX_WIDTH / 4 )
+#define HUB75_DWELL_US          450         // Scan line on time across all planes at full brightness
+#define HUB75_BRIGHTNESS        255         // Start up brightness , 0 to 255 , gamma corrected like the colours
+#define HUB75_REFRESH_MIN_HZ    100         // Flicker free floor for any number of chained panels
+
+// PIO cycles per scan line and plane outside the dwell , from hub75.pio
+#define HUB75_SHIFT_CYCLES      ( MATRIX_WIDTH * 3 )    // hub75_data : out , out , jmp per column
+#define HUB75_LATCH_CYCLES      5                       // hub75_data : wait , set LAT , mov x , set LAT , irq
+#define HUB75_ROW_CYCLES        6                       // hub75_row  : out , out , out , irq , wait , jmp
+#define HUB75_DWELL_UNIT        8                       // hub75_row  : cycles per on / off loop
+#define HUB75_DWELL_FIELD       ( 1u << 13 )            // hub75_row  : on / off counts per line word
+
+#define HUB75_ADDRESS_MASK      ( ( 1u << BIT_A_PIN ) | ( 1u << BIT_B_PIN ) | ( 1u << BIT_C_PIN ) | ( 1u << BIT_D_PIN ) )
+#define HUB75_CLK_MASK          ( 1u << MATRIX_CLK_PIN )
+#define HUB75_LAT_MASK          ( 1u << MATRIX_LAT_PIN )
+#define HUB75_OE_MASK           ( 1u << MATRIX_OE_PIN  )
+#define HUB75_RGB_MASK          ( 0b111111u << HUB75_RGB_BASE_PIN )
+
+// Buffer swap , driven by core 1 at frame boundaries
+#define HUB75_SWAP_IDLE         0   // Back buffer owned by core 0
+#define HUB75_SWAP_REQUESTED    1   // Hub75_Present called
+#define HUB75_SWAP_LATCHED      2   // New front buffer loaded into the control channel
+#define HUB75_SWAP_SHOWN        3   // New front buffer being scanned
+
+// One frame of the refresh in clk_sys cycles , worked out from the
+// programmed PIO timing as none of it runs on a CPU
+typedef struct
+{
+    uint32_t Dwell;     // Output on
+    uint32_t Latch;     // Hand over between the state machines and latch , output off
+    uint32_t Shift;     // Colour data , output off
+} Hub75_Timing_t;
+
+extern volatile uint32_t Hub75_FrameCount;
+extern volatile Jitter_t Hub75_Jitter;
+extern volatile uint32_t Hub75_ShownTime;
+
+// Hub75_Blit / Hub75_FillRect / Hub75_GetPixel / Hub75_SetPixel work on the back buffer
+// and may only be called while Hub75_IsReady returns true. Colours are
+// gamma corrected as they are written.
+void     Hub75_Blit          ( uint row , uint column , const uint32_t *lanes , uint words , uint32_t colour );
+void     Hub75_FillRect      ( uint row , uint column , uint width , uint height , uint32_t colour );
+void     Hub75_Init          ( void );
+uint32_t Hub75_GetPixel      ( uint row , uint column );
+bool     Hub75_IsReady       ( void );
+void     Hub75_Present       ( uint32_t dirty_rows );
+void     Hub75_SetBrightness ( uint8_t level );
+void     Hub75_SetPixel      ( uint row , uint column , uint32_t colour );
+void     Hub75_Timing        ( Hub75_Timing_t *timing );
+
+#endif /* __HUB75_H */
+
+/*** end of file ***/
@@ -0,0 +1,40 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           jitter.h                                              *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __JITTER_H
+#define __JITTER_H
+
+#include <stdint.h>
+
+// Period statistics for a repeating event , all times in microseconds
+typedef struct
+{
+    uint32_t Count;     // Events sampled
+    uint32_t Last;      // Timestamp of the previous event
+    uint32_t Max;       // Longest period
+    uint32_t Min;       // Shortest period
+    uint32_t Period;    // Most recent period
+} Jitter_t;
+
+void     Jitter_Reset  ( volatile Jitter_t *jitter );
+void     Jitter_Sample ( volatile Jitter_t *jitter , uint32_t now );
+uint32_t Jitter_Spread ( const volatile Jitter_t *jitter );
+
+#endif /* __JITTER_H */
+
+/*** end of file ***/
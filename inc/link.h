@@ -0,0 +1,52 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           link.h                                                *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __LINK_H
+#define __LINK_H
+
+#include <main.h>
+#include <protocol.h>
+
+#define LINK_MARGIN             1   // Clock steps kept below the fastest rate that trained cleanly
+#define LINK_MONITOR_ERRORS     4   // Errors within LINK_MONITOR_WINDOW that force a step down
+#define LINK_MONITOR_WINDOW     32  // Transactions
+#define LINK_RETRIES            2   // Immediate repeats of a failed request
+#define LINK_TRAIN_EXCHANGES    8   // Echo replies required per clock step
+
+typedef struct
+{
+    uint32_t Baud;          // Negotiated clock ( Hz )
+    uint32_t Errors;        // Failed transactions since training
+    uint32_t Retries;       // Transactions repeated after an error
+    uint32_t StepDowns;     // Clock reductions at run time
+    uint32_t Transactions;  // Transactions since training
+    uint8_t  Step;          // Index into the clock table
+    uint8_t  StepTrained;   // Fastest clean step found by training
+} Link_Stats_t;
+
+extern volatile Link_Stats_t Link_Stats [ TESTBED_COUNT ];
+
+void Link_Apply    ( void );
+bool Link_Exchange ( uint8_t opcode , const uint8_t *payload , uint8_t length , uint8_t *rx , Protocol_Frame_t *frame );
+void Link_Select   ( uint8_t bed );
+void Link_Train    ( void );
+bool Link_Update   ( bool ok );
+
+#endif /* __LINK_H */
+
+/*** end of file ***/
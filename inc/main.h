@@ -24,13 +24,26 @@
 #include <stdio.h>
 #include <stdbool.h>
 
-#include <hardware/pio_instructions.h>
-#include <pico/stdlib.h>
+#include <hal.h>
 
-#define NOP                 pio_encode_nop ( )
 #define SENSOR_FAIL         0
 #define SENSOR_PASS         1
 #define SENSOR_CHECKING     2
+#define SENSOR_COUNT        JIG_WAYS
+#define SENSOR_BYTES        ( ( SENSOR_COUNT + 7 ) / 8 )    // Pass bitmap , sensor n in bit ( n % 8 ) of byte ( n / 8 )
+
+// Jig size , set from the build ( cmake -DJIG_WAYS=48 ). 24 ways fit one
+// 32 x 32 panel , larger jigs chain PANEL_WIDTH panels left to right.
+#ifndef JIG_WAYS
+#define JIG_WAYS            24
+#endif
+
+// Test beds polled in turn , one chip select each ( cmake -DTESTBED_COUNT=2 ).
+// Each shows its JIG_WAYS tiles on the matrix , bed 0 first.
+#ifndef TESTBED_COUNT
+#define TESTBED_COUNT       1
+#endif
+#define TESTBED_MAX         4   // SPI0 chip select pins
 
 #define WATCHDOG_MILLISECONDS   8000    // Maximum 8 300 ms
 
@@ -39,6 +52,7 @@
 #define BIT_B_PIN       24
 #define BIT_C_PIN       29
 #define BIT_D_PIN       28
+#define DATA_READY_PIN  14
 #define LED_B1_PIN       9
 #define LED_B2_PIN      12
 #define LED_G1_PIN       7
@@ -50,6 +64,9 @@
 #define MATRIX_LAT_PIN   6
 #define MATRIX_OE_PIN    0
 #define SPI_CS_PIN       1
+#define SPI_CS1_PIN      5
+#define SPI_CS2_PIN     17
+#define SPI_CS3_PIN     21
 #define SPI_MISO_PIN    20
 #define SPI_MOSI_PIN    19
 #define SPI_SCK_PIN     18
@@ -58,53 +75,61 @@
 #define SW3              3
 #define SW4              2
 
-#define BIT_A_HIGH          gpio_put ( BIT_A_PIN      , 1 )
-#define BIT_A_LOW           gpio_put ( BIT_A_PIN      , 0 )
-#define BIT_B_HIGH          gpio_put ( BIT_B_PIN      , 1 )
-#define BIT_B_LOW           gpio_put ( BIT_B_PIN      , 0 )
-#define BIT_C_HIGH          gpio_put ( BIT_C_PIN      , 1 )
-#define BIT_C_LOW           gpio_put ( BIT_C_PIN      , 0 )
-#define BIT_D_HIGH          gpio_put ( BIT_D_PIN      , 1 )
-#define BIT_D_LOW           gpio_put ( BIT_D_PIN      , 0 )
-#define LED_B1_HIGH         gpio_put ( LED_B1_PIN     , 1 )
-#define LED_B1_LOW          gpio_put ( LED_B1_PIN     , 0 )
-#define LED_B2_HIGH         gpio_put ( LED_B2_PIN     , 1 )
-#define LED_B2_LOW          gpio_put ( LED_B2_PIN     , 0 )
-#define LED_G1_HIGH         gpio_put ( LED_G1_PIN     , 1 )
-#define LED_G1_LOW          gpio_put ( LED_G1_PIN     , 0 )
-#define LED_G2_HIGH         gpio_put ( LED_G2_PIN     , 1 )
-#define LED_G2_LOW          gpio_put ( LED_G2_PIN     , 0 )
-#define LED_PICO_OFF        gpio_put ( LED_PICO_PIN   , 0 )
-#define LED_PICO_ON         gpio_put ( LED_PICO_PIN   , 1 )
-#define LED_R1_HIGH         gpio_put ( LED_R1_PIN     , 1 )
-#define LED_R1_LOW          gpio_put ( LED_R1_PIN     , 0 )
-#define LED_R2_HIGH         gpio_put ( LED_R2_PIN     , 1 )
-#define LED_R2_LOW          gpio_put ( LED_R2_PIN     , 0 )
-#define MATRIX_CLK_HIGH     gpio_put ( MATRIX_CLK_PIN , 1 )
-#define MATRIX_CLK_LOW      gpio_put ( MATRIX_CLK_PIN , 0 )
-#define MATRIX_LAT_HIGH     gpio_put ( MATRIX_LAT_PIN , 1 )
-#define MATRIX_LAT_LOW      gpio_put ( MATRIX_LAT_PIN , 0 )
-#define MATRIX_OUTPUT_OFF   gpio_put ( MATRIX_OE_PIN  , 1 )
-#define MATRIX_OUTPUT_ON    gpio_put ( MATRIX_OE_PIN  , 0 )
+#define BIT_A_HIGH          Hal_GpioPut ( BIT_A_PIN      , 1 )
+#define BIT_A_LOW           Hal_GpioPut ( BIT_A_PIN      , 0 )
+#define BIT_B_HIGH          Hal_GpioPut ( BIT_B_PIN      , 1 )
+#define BIT_B_LOW           Hal_GpioPut ( BIT_B_PIN      , 0 )
+#define BIT_C_HIGH          Hal_GpioPut ( BIT_C_PIN      , 1 )
+#define BIT_C_LOW           Hal_GpioPut ( BIT_C_PIN      , 0 )
+#define BIT_D_HIGH          Hal_GpioPut ( BIT_D_PIN      , 1 )
+#define BIT_D_LOW           Hal_GpioPut ( BIT_D_PIN      , 0 )
+#define LED_B1_HIGH         Hal_GpioPut ( LED_B1_PIN     , 1 )
+#define LED_B1_LOW          Hal_GpioPut ( LED_B1_PIN     , 0 )
+#define LED_B2_HIGH         Hal_GpioPut ( LED_B2_PIN     , 1 )
+#define LED_B2_LOW          Hal_GpioPut ( LED_B2_PIN     , 0 )
+#define LED_G1_HIGH         Hal_GpioPut ( LED_G1_PIN     , 1 )
+#define LED_G1_LOW          Hal_GpioPut ( LED_G1_PIN     , 0 )
+#define LED_G2_HIGH         Hal_GpioPut ( LED_G2_PIN     , 1 )
+#define LED_G2_LOW          Hal_GpioPut ( LED_G2_PIN     , 0 )
+#define LED_PICO_OFF        Hal_GpioPut ( LED_PICO_PIN   , 0 )
+#define LED_PICO_ON         Hal_GpioPut ( LED_PICO_PIN   , 1 )
+#define LED_R1_HIGH         Hal_GpioPut ( LED_R1_PIN     , 1 )
+#define LED_R1_LOW          Hal_GpioPut ( LED_R1_PIN     , 0 )
+#define LED_R2_HIGH         Hal_GpioPut ( LED_R2_PIN     , 1 )
+#define LED_R2_LOW          Hal_GpioPut ( LED_R2_PIN     , 0 )
+#define MATRIX_CLK_HIGH     Hal_GpioPut ( MATRIX_CLK_PIN , 1 )
+#define MATRIX_CLK_LOW      Hal_GpioPut ( MATRIX_CLK_PIN , 0 )
+#define MATRIX_LAT_HIGH     Hal_GpioPut ( MATRIX_LAT_PIN , 1 )
+#define MATRIX_LAT_LOW      Hal_GpioPut ( MATRIX_LAT_PIN , 0 )
+#define MATRIX_OUTPUT_OFF   Hal_GpioPut ( MATRIX_OE_PIN  , 1 )
+#define MATRIX_OUTPUT_ON    Hal_GpioPut ( MATRIX_OE_PIN  , 0 )
 
 #define BIT_A_MASK          0b0000000000000001
 #define BIT_B_MASK          0b0000000000000010
 #define BIT_C_MASK          0b0000000000000100
 #define BIT_D_MASK          0b0000000000001000
-#define LED_BLUE_TOP        0b0000000000010000
-#define LED_BLUE_BOTTOM     0b0000000010000000
-#define LED_GREEN_TOP       0b0000000000100000
-#define LED_GREEN_BOTTOM    0b0000000100000000
-#define LED_RED_TOP         0b0000000001000000
-#define LED_RED_BOTTOM      0b0000001000000000
-#define LED_YELLOW_TOP      0b0000000001100000
-#define LED_YELLOW_BOTTOM   0b0000001100000000
+
+// Colours ( 0xRRGGBB ) , shown with HUB75_COLOUR_DEPTH bits per channel
+#define COLOUR_AMBER        0xFFA000
+#define COLOUR_BLACK        0x000000
+#define COLOUR_BLUE         0x0000FF
+#define COLOUR_GREEN        0x00FF00
+#define COLOUR_IDLE         0x000040    // Dimmed blue
+#define COLOUR_RED          0xFF0000
+#define COLOUR_YELLOW       0xFFFF00
+
+// LED Matrix , MATRIX_PANELS chained on one HUB75 output
+#define MATRIX_HEIGHT       32
+#define MATRIX_PANELS       ( ( MATRIX_SLOTS <= 24 ) ? 1 : ( ( MATRIX_SLOTS + 47 ) / 48 ) )
+#define MATRIX_SLOTS        ( SENSOR_COUNT * TESTBED_COUNT )   // Tiles , bed b sensor n at b * SENSOR_COUNT + n
+#define MATRIX_WIDTH        ( PANEL_WIDTH * MATRIX_PANELS )
+#define PANEL_WIDTH         ( ( MATRIX_SLOTS <= 24 ) ? 32 : 64 )
 
 // SPI
 #define SPI_BAUD_RATE       100 // kHz
 #define SPI_BUFFER_LENGTH   10
-#define SPI_CS_HIGH         gpio_put ( SPI_CS_PIN , 1 )
-#define SPI_CS_LOW          gpio_put ( SPI_CS_PIN , 0 )
+#define SPI_CS_HIGH         Hal_GpioPut ( SPI_CS_PIN , 1 )
+#define SPI_CS_LOW          Hal_GpioPut ( SPI_CS_PIN , 0 )
 #define SPI_MASTER          spi0
 
 #endif /* __MAIN_H */
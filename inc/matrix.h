@@ -0,0 +1,52 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           matrix.h                                              *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __MATRIX_H
+#define __MATRIX_H
+
+#include <main.h>
+
+// Rendered tile state
+#define MATRIX_TILE_FAIL    0   // Completed , failed
+#define MATRIX_TILE_PASS    1   // Completed , passed
+#define MATRIX_TILE_TESTING 2   // Sensor at pos
+#define MATRIX_TILE_WAITING 3   // Not reached yet
+#define MATRIX_TILE_UNKNOWN 4   // Position outside the jig , a test bed fault
+#define MATRIX_TILE_NONE    0xFF
+
+#define MATRIX_POS_UNKNOWN  0xFF    // Test bed silent or stale , every tile unknown
+
+typedef struct
+{
+    uint32_t Drawn;             // Tiles recomposed since start up
+    uint32_t DrawnPerSecond;
+    uint32_t Skipped;           // Tiles left as they were since start up
+    uint32_t SkippedPerSecond;
+} MatrixStats_t;
+
+extern volatile MatrixStats_t Matrix_Stats;
+
+uint32_t Matrix_Bars      ( const uint16_t *value , uint8_t *changed , uint16_t full_scale );
+uint32_t Matrix_Compose   ( const uint8_t *pass , const uint8_t *pos );
+uint32_t Matrix_Label     ( uint8_t bed , const char *text , uint32_t colour );
+bool     Matrix_SetBuffer ( uint8_t slot , uint8_t state , uint8_t pos );
+void     Matrix_Splash    ( void );
+
+#endif /* __MATRIX_H */
+
+/*** end of file ***/
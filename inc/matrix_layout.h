@@ -0,0 +1,89 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           matrix_layout.h                                       *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __MATRIX_LAYOUT_H
+#define __MATRIX_LAYOUT_H
+
+#include <main.h>
+#include <text.h>
+
+// Sensor tile grid. The grid keeps four rows and widens with the slot count
+// across the chained panels , so MatrixTile lists the slots in blocks of 24.
+// Each test bed has a band of TILE_BED_COLUMNS grid columns , the beds side
+// by side , and sensor k of a bed is drawn at grid row ( k / TILE_BED_COLUMNS ) ,
+// column ( k % TILE_BED_COLUMNS ) of its band. With one bed the band is the grid.
+#define TILE_BED_COLUMNS    ( SENSOR_COUNT / TILE_GRID_ROWS )
+#define TILE_GRID_COLUMNS   ( MATRIX_SLOTS / TILE_GRID_ROWS )
+#define TILE_GRID_ROWS      4
+#define TILE_HEIGHT         4
+#define TILE_WIDTH          3
+#define TILE_COLUMN_OFFSET  2   // Pixel column of the first tile
+#define TILE_COLUMN_PITCH   5
+#define TILE_ROW_OFFSET     2   // Pixel row of the first tile
+#define TILE_ROW_PITCH      7
+
+// Status label of each test bed , a line of text under the tile grid. Bed b's
+// label starts under the first column of its band , on the framebuffer word
+// at or before it , and is no wider than the band.
+#define LABEL_CHARS         ( ( ( LABEL_WIDTH / FONT_PITCH ) < TEXT_LENGTH ) ? ( LABEL_WIDTH / FONT_PITCH ) : TEXT_LENGTH )
+#define LABEL_COLUMN( bed ) ( ( TILE_COLUMN_OFFSET + ( bed ) * LABEL_WIDTH ) & ~( FONT_PITCH - 1 ) )
+#define LABEL_ROW           ( TILE_ROW_OFFSET + ( TILE_GRID_ROWS - 1 ) * TILE_ROW_PITCH + TILE_HEIGHT )
+#define LABEL_WIDTH         ( TILE_BED_COLUMNS * TILE_COLUMN_PITCH )    // Pixel columns per band
+
+#define TILE( n )   { TILE_ROW_OFFSET    + ( ( ( n ) % SENSOR_COUNT ) / TILE_BED_COLUMNS ) * TILE_ROW_PITCH ,      \
+                      TILE_COLUMN_OFFSET + ( ( ( n ) / SENSOR_COUNT ) * TILE_BED_COLUMNS + ( ( n ) % SENSOR_COUNT ) % TILE_BED_COLUMNS ) * TILE_COLUMN_PITCH }
+#define TILES_6( n )    TILE ( ( n )     ) , TILE ( ( n ) + 1 ) , TILE ( ( n ) + 2 ) ,      \
+                        TILE ( ( n ) + 3 ) , TILE ( ( n ) + 4 ) , TILE ( ( n ) + 5 )
+#define TILES_24( n )   TILES_6 ( ( n ) ) , TILES_6 ( ( n ) + 6 ) , TILES_6 ( ( n ) + 12 ) , TILES_6 ( ( n ) + 18 )
+
+_Static_assert ( ( 0 == ( SENSOR_COUNT % 24 ) ) && ( SENSOR_COUNT <= 96 ) , "JIG_WAYS must be 24 , 48 , 72 or 96" );
+_Static_assert ( ( TESTBED_COUNT >= 1 ) && ( TESTBED_COUNT <= TESTBED_MAX ) , "TESTBED_COUNT must be 1 to 4" );
+_Static_assert ( MATRIX_SLOTS <= 96 , "JIG_WAYS x TESTBED_COUNT must fit two chained 64 x 32 panels" );
+_Static_assert ( MATRIX_HEIGHT <= 32 , "Dirty rows are one bit per row in a uint32_t" );
+_Static_assert ( TILE_GRID_COLUMNS * TILE_GRID_ROWS == MATRIX_SLOTS , "Tile grid does not match MATRIX_SLOTS" );
+_Static_assert ( TILE_ROW_OFFSET + ( TILE_GRID_ROWS - 1 ) * TILE_ROW_PITCH + TILE_HEIGHT <= MATRIX_HEIGHT , "Tile grid too tall" );
+_Static_assert ( TILE_COLUMN_OFFSET + ( TILE_GRID_COLUMNS - 1 ) * TILE_COLUMN_PITCH + TILE_WIDTH <= MATRIX_WIDTH , "Tile grid too wide" );
+_Static_assert ( LABEL_ROW + FONT_HEIGHT <= MATRIX_HEIGHT , "No room for the labels under the tile grid" );
+_Static_assert ( LABEL_COLUMN ( TESTBED_COUNT - 1 ) + LABEL_CHARS * FONT_PITCH <= MATRIX_WIDTH , "Last test bed's label too wide" );
+
+typedef struct
+{
+    uint8_t Row;        // Top pixel row
+    uint8_t Column;     // Left pixel column
+} Tile_t;
+
+// Slot n is sensor ( n % SENSOR_COUNT ) of bed ( n / SENSOR_COUNT ) , placed in
+// that bed's band by TILE. The blocks of 24 only follow the slot count , they
+// are not grid rows.
+
+static const Tile_t MatrixTile [ MATRIX_SLOTS ] = {
+    TILES_24 (  0 ) ,
+#if JIG_WAYS * TESTBED_COUNT > 24
+    TILES_24 ( 24 ) ,
+#endif
+#if JIG_WAYS * TESTBED_COUNT > 48
+    TILES_24 ( 48 ) ,
+#endif
+#if JIG_WAYS * TESTBED_COUNT > 72
+    TILES_24 ( 72 ) ,
+#endif
+};
+
+#endif /* __MATRIX_LAYOUT_H */
+
+/*** end of file ***/
@@ -0,0 +1,122 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           protocol.h                                            *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __PROTOCOL_H
+#define __PROTOCOL_H
+
+#include <main.h>
+
+// Test bed protocol v2 frame :
+//   [ 0 ] SYNC_BYTE
+//   [ 1 ] PROTOCOL_VERSION
+//   [ 2 ] Payload length
+//   [ 3 ] Sequence number , a reply carries the sequence number of its request
+//   [ 4 ] Opcode
+//   [ 5 ] Payload
+//   [ n ] CRC-16 / CCITT ( 0x1021 , 0xFFFF ) over bytes 1 to n - 1 , MSB first
+//
+// Every transaction is PROTOCOL_FRAME_LENGTH bytes each way. The master
+// sends a request while the test bed returns the reply to any earlier
+// request , so up to PROTOCOL_WINDOW requests can be in flight. An idle
+// frame ( all zero ) carries no request and only clocks out the reply to the
+// last one. A test bed that never answers in v2 is driven with the original
+// 11 byte exchange. Every PROTOCOL_V2_PROBE legacy status reads it is given
+// one v2 transaction again , so a v2 test bed that powered up late or was
+// reset comes back to v2 once it answers.
+//
+// Several test beds keep separate state , Protocol_Select picks the one
+// that Protocol_Request , Protocol_Receive and Protocol_Next work on.
+//
+// Jigs over 24 ways read their status with PROTOCOL_OP_STATUS_N and the
+// frame grows to carry a batch reply holding the whole pass bitmap.
+#define PROTOCOL_VERSION        0xA2
+#define PROTOCOL_HEADER_LENGTH  5
+#define PROTOCOL_CRC_LENGTH     2
+#define PROTOCOL_STATUS_N_BASE  5   // PROTOCOL_OP_STATUS_N bytes ahead of the bitmap
+#define PROTOCOL_FRAME_LENGTH   ( ( SENSOR_COUNT <= 24 ) ? 16 : ( ( PROTOCOL_HEADER_LENGTH + 1 + PROTOCOL_STATUS_N_BASE + SENSOR_BYTES + PROTOCOL_CRC_LENGTH + 3 ) & ~3 ) )
+#define PROTOCOL_PAYLOAD_MAX    ( PROTOCOL_FRAME_LENGTH - PROTOCOL_HEADER_LENGTH - PROTOCOL_CRC_LENGTH )
+#define PROTOCOL_LEGACY_LENGTH  11
+#define PROTOCOL_V2_ATTEMPTS    8   // Transactions without a v2 reply before falling back
+#define PROTOCOL_V2_PROBE       10  // Legacy status reads between v2 probes
+#define PROTOCOL_WINDOW         4   // Requests in flight
+
+#define PROTOCOL_MODE_V2        0
+#define PROTOCOL_MODE_LEGACY    1
+
+// Opcodes
+#define PROTOCOL_OP_BUTTON      0x01    // Payload : button bits , BUTTON_EVENT type ( v2 only )
+#define PROTOCOL_OP_ECHO        0x02    // Payload returned unchanged , used for link training
+#define PROTOCOL_OP_STATUS      0x10    // Reply   : DAC state , sensor pass ( 24 bits , MSB first ) , sensor position , [ flags ] , [ brightness ]
+#define PROTOCOL_OP_STATUS_N    0x11    // Reply   : DAC state , sensor position , flags , brightness , sensor count , pass bitmap ( SENSOR_BYTES layout )
+#define PROTOCOL_OP_READINGS    0x12    // Payload : see readings.h
+#define PROTOCOL_OP_BATCH       0x20    // Payload : see batch.h
+
+// Status read by this jig
+#define PROTOCOL_OP_STATUS_JIG  ( ( SENSOR_COUNT <= 24 ) ? PROTOCOL_OP_STATUS : PROTOCOL_OP_STATUS_N )
+
+// Status flags , optional sixth byte of a PROTOCOL_OP_STATUS reply , third of PROTOCOL_OP_STATUS_N
+#define PROTOCOL_FLAG_READY      0x01   // Another result is waiting to be read
+#define PROTOCOL_FLAG_BRIGHTNESS 0x02   // Brightness byte sets the panel brightness , 0 to 255
+
+extern const uint8_t DAC_CHECK_IS_READY;
+extern const uint8_t DAC_CHECK_RUNNING;
+extern const uint8_t DAC_CHECK_NOT_RUNNING;
+extern const uint8_t SYNC_BYTE;
+
+typedef struct
+{
+    uint8_t Opcode;
+    uint8_t Sequence;
+    uint8_t Length;
+    uint8_t Payload [ PROTOCOL_PAYLOAD_MAX ];
+} Protocol_Frame_t;
+
+typedef struct
+{
+    uint8_t  SensorPass [ SENSOR_BYTES ];   // Sensors beyond those the test bed reported read as failed
+    uint8_t  Brightness;    // With PROTOCOL_FLAG_BRIGHTNESS
+    uint8_t  DAC_CheckState;
+    uint8_t  Flags;
+    uint8_t  SensorPos;
+} Protocol_Status_t;
+
+typedef struct
+{
+    uint32_t CRC_Errors;    // Frames with a bad checksum
+    uint32_t Frames;        // Valid replies
+    uint32_t Lost;          // Requests dropped from the window without a reply
+    uint32_t Probes;        // Returns to v2 from legacy to see if the test bed answers
+    uint32_t Sync_Errors;   // Transactions without a recognisable reply
+    uint32_t Unmatched;     // Valid replies to a sequence number not in flight
+} Protocol_Stats_t;
+
+extern volatile Protocol_Stats_t Protocol_Stats;
+
+uint16_t Protocol_CRC16       ( const uint8_t *data , uint8_t length );
+uint8_t  Protocol_Idle        ( uint8_t *tx );
+bool     Protocol_Legacy      ( uint8_t bed );
+bool     Protocol_LegacyReply ( void );
+uint8_t  Protocol_Next        ( void );
+bool     Protocol_Receive     ( const uint8_t *rx , uint8_t length , Protocol_Frame_t *frame );
+uint8_t  Protocol_Request     ( uint8_t opcode , const uint8_t *payload , uint8_t length , uint8_t *tx );
+void     Protocol_Select      ( uint8_t bed );
+bool     Protocol_Status      ( const Protocol_Frame_t *frame , Protocol_Status_t *status );
+
+#endif /* __PROTOCOL_H */
+
+/*** end of file ***/
@@ -0,0 +1,69 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           readings.h                                            *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __READINGS_H
+#define __READINGS_H
+
+#include <main.h>
+#include <protocol.h>
+
+// Live sensor readings ( 12 bit , 0 to READINGS_FULL_SCALE ) , read with
+// PROTOCOL_OP_READINGS and sent as changes only. The request carries the
+// generation the master holds , the reply the changes from that generation :
+//   Request : [ 0 ] Generation held , 0 for none
+//   Reply   : [ 0 ] New generation ( 1 to READINGS_GENERATION ) , READINGS_MORE if changes were left out
+//             [ 1 ] Base generation , the one the changes apply to
+//             [ 2 ] ... Entries , in any order :
+//                   sensor ( < 0x80 ) , change ( signed byte )
+//                   sensor | READINGS_LONG , value bits 11 to 8 , value bits 7 to 0
+// A reply whose base is not the generation held is thrown away , the next
+// request tells the test bed where the master is and it answers from there ,
+// with whole values if it no longer knows that generation. Several replies
+// can be in flight , so the test bed keeps the last PROTOCOL_WINDOW
+// generations it sent.
+#define READINGS_ATTEMPTS       8       // Requests without a reply before a test bed is taken not to support readings
+#define READINGS_BYTES          ( ( MATRIX_SLOTS + 7 ) / 8 )
+#define READINGS_FULL_SCALE     4095
+#define READINGS_GENERATION     0x7F    // Generation mask
+#define READINGS_LONG           0x80    // Entry holds the whole value
+#define READINGS_MORE           0x80    // More changes waiting , read again
+#define READINGS_NONE           0xFFFF  // Slot not read yet
+
+_Static_assert ( SENSOR_COUNT < READINGS_LONG , "Readings entries carry the sensor in 7 bits" );
+
+typedef struct
+{
+    uint32_t Deltas;        // Entries sent as a change
+    uint32_t Entries;       // Slot values updated
+    uint32_t Mismatched;    // Replies to a generation no longer held
+    uint32_t Replies;       // Replies applied
+    uint32_t Requests;
+} Readings_Stats_t;
+
+extern volatile Readings_Stats_t Readings_Stats;
+extern          uint8_t          Readings_Changed [ READINGS_BYTES ];   // Slot n in bit ( n % 8 ) of byte ( n / 8 ) , cleared by Matrix_Bars
+extern          uint16_t         Readings_Value   [ MATRIX_SLOTS ];
+
+uint8_t Readings_Build  ( uint8_t *tx );
+bool    Readings_Reply  ( const Protocol_Frame_t *frame );
+void    Readings_Reset  ( void );
+void    Readings_Select ( uint8_t bed );
+
+#endif /* __READINGS_H */
+
+/*** end of file ***/
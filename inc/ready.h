@@ -0,0 +1,60 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           ready.h                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __READY_H
+#define __READY_H
+
+#include <main.h>
+
+// The test bed raises DATA_READY_PIN ( or PROTOCOL_FLAG_READY in a status
+// reply ) when a result is waiting. The status poll then becomes a liveness
+// check , sent every SPI_RX_PERIOD_LIVENESS once the test bed has signalled.
+#define READY_HISTOGRAM_BINS    20  // Bin n counts latencies of 2^n to 2^( n + 1 ) - 1 us
+
+// Event progress , result ready to first displayed frame
+#define READY_STATE_IDLE        0
+#define READY_STATE_SIGNALLED   1   // Edge or flag seen , read not yet sent
+#define READY_STATE_READING     2   // Status read sent
+#define READY_STATE_RECEIVED    3   // Status reply decoded
+#define READY_STATE_COMPOSED    4   // Changed tiles presented , waiting for the frame
+
+typedef struct
+{
+    uint32_t Coalesced;         // Signals while an earlier event was still in progress
+    uint32_t Events;            // Signals seen
+    uint32_t Latency;           // Most recent ( us )
+    uint32_t LatencyMax;        // Longest ( us )
+    uint32_t Shown;             // Events measured through to the panel
+    uint32_t Unchanged;         // Events whose reply did not change the display
+    uint32_t Histogram [ READY_HISTOGRAM_BINS ];
+} Ready_Stats_t;
+
+extern volatile Ready_Stats_t Ready_Stats;
+
+bool Ready_Active   ( void );
+void Ready_Composed ( uint32_t dirty_rows );
+void Ready_Init     ( void );
+void Ready_Received ( void );
+void Ready_Shown    ( uint32_t shown );
+void Ready_Signal   ( void );
+bool Ready_Take     ( void );
+bool Ready_Waiting  ( void );
+
+#endif /* __READY_H */
+
+/*** end of file ***/
@@ -0,0 +1,66 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           scheduler.h                                           *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __SCHEDULER_H
+#define __SCHEDULER_H
+
+#include <main.h>
+
+// Cooperative , deadline ordered tasks on core 0. The earliest deadline is
+// kept at the top of a binary min-heap and one hardware alarm ( Hal_WakeAt )
+// wakes the core for it , so it sleeps whenever nothing is due.
+#define SCHEDULER_TASKS         7       // Added by main.c
+#define SCHEDULER_TASKS_MAX     ( SCHEDULER_TASKS + 1 )     // And Task_Bench when built with BENCH
+#define SCHEDULER_RUNNING       0xFF    // Task_t.Index while the task runs
+
+typedef void ( *Task_Function_t ) ( void );
+
+typedef struct
+{
+    Task_Function_t Function;
+    const char     *Name;
+    uint64_t        Deadline;       // Hal_Micros64 of the next run , UINT64_MAX if only woken
+    uint32_t        Period;         // us , 0 runs only when woken
+    uint8_t         Index;          // Heap position
+    volatile bool   Woken;          // Woken while running , run again straight away
+
+    uint32_t        Late;           // Most recent start after the deadline ( us )
+    uint32_t        LateMax;
+    uint32_t        RunTime;        // Most recent ( us )
+    uint32_t        RunTimeMax;
+    uint32_t        Runs;
+} Task_t;
+
+typedef struct
+{
+    uint64_t Idle;      // Time asleep ( us )
+    uint32_t Sleeps;
+} Scheduler_Stats_t;
+
+extern volatile Scheduler_Stats_t Scheduler_Stats;
+
+void Scheduler_Add       ( Task_t *task , Task_Function_t function , const char *name , uint32_t period_us , uint32_t delay_us );
+void Scheduler_Event     ( void );
+void Scheduler_Init      ( Task_t *event_task );
+void Scheduler_Run       ( void );
+void Scheduler_SetPeriod ( Task_t *task , uint32_t period_us );
+void Scheduler_Wake      ( Task_t *task );
+
+#endif /* __SCHEDULER_H */
+
+/*** end of file ***/
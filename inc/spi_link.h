@@ -0,0 +1,58 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           spi_link.h                                            *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __SPI_LINK_H
+#define __SPI_LINK_H
+
+#include <main.h>
+
+// SPI half of the HAL , spi_link.c drives the RP2040 peripheral from DMA and
+// host/spi_host.c serves transactions from the test bed stand-in
+
+#define SPI_DMA_IRQ         DMA_IRQ_0
+#define SPI_CS_PINS         { SPI_CS_PIN , SPI_CS1_PIN , SPI_CS2_PIN , SPI_CS3_PIN }  // Test bed n on pin n , all SPI0 CSn
+#define SPI_TIMEOUT         10  // Default transaction timeout ( ms )
+
+// Transaction status
+#define SPI_STATUS_IDLE     0
+#define SPI_STATUS_BUSY     1
+#define SPI_STATUS_DONE     2   // Reported once by SPI_Poll , then idle
+#define SPI_STATUS_TIMEOUT  3   // Reported once by SPI_Poll , then idle
+
+// Called from the DMA interrupt when the last byte has been received
+typedef void ( *SPI_Callback_t ) ( const uint8_t *rx , uint8_t length );
+
+typedef struct
+{
+    uint32_t Completed;
+    uint32_t Duration;      // Last transaction , submit to completion ( us )
+    uint32_t DurationMax;
+    uint32_t Timeouts;
+} SPI_Stats_t;
+
+extern volatile SPI_Stats_t SPI_Stats;
+
+void     SPI_Init    ( void );
+uint8_t  SPI_Poll    ( void );
+bool     SPI_Select  ( uint8_t bed );
+uint32_t SPI_SetBaud ( uint32_t baud );
+bool     SPI_Submit  ( const uint8_t *tx , uint8_t *rx , uint8_t length , uint16_t timeout_ms , SPI_Callback_t callback );
+
+#endif /* __SPI_LINK_H */
+
+/*** end of file ***/
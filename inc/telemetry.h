@@ -0,0 +1,83 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           telemetry.h                                           *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include <main.h>
+
+// Health records for a host on the USB serial port. Tasks on core 0 push
+// records into a single producer , single consumer byte ring that
+// Telemetry_Drain empties from a task , and nothing masks interrupts.
+// Interrupt handlers only count , the drain turns their counts into at most
+// one record of each kind per run , so the ring fills at the same rate
+// however busy the link is. The drain only sends while a host has the port
+// open and throws records away otherwise , so a jig on its own never fills
+// the ring. host/telemetry_decode.c turns the stream back into text.
+//
+// Record , all fields MSB first :
+//   [ 0 ] TELEMETRY_SYNC
+//   [ 1 ] Type
+//   [ 2 ] Payload length
+//   [ 3 ] Time , Hal_Micros ( 4 bytes )
+//   [ 7 ] Payload
+//   [ n ] CRC-16 over bytes 1 to n - 1 , as Protocol_CRC16
+#define TELEMETRY_SYNC          0xA7
+#define TELEMETRY_HEADER_LENGTH 7
+#define TELEMETRY_PAYLOAD_MAX   24
+#define TELEMETRY_RING_LENGTH   512     // Bytes , power of two
+#define TELEMETRY_DRAIN_MAX     256     // Bytes sent per Telemetry_Drain
+#define TELEMETRY_HEALTH_MS     1000
+
+// Record types
+#define TELEMETRY_HEALTH        0x01    // Once per TELEMETRY_HEALTH_MS , see Telemetry_Drain
+#define TELEMETRY_SPI           0x02    // Worst transaction latency ( us , 2 ) , transactions ( 2 ) , since the last drain
+#define TELEMETRY_LINK_ERROR    0x03    // Kind , clock step , clock ( Hz , 4 ) , test bed
+#define TELEMETRY_BUTTON_DROP   0x04    // Button bits , BUTTON_EVENT type , of the latest drop , drops since the last drain
+#define TELEMETRY_BOOT          0x05    // First frame , first valid status ( us from boot , 4 each , 0 until seen ) , with each health record
+#define TELEMETRY_BEDS          0x06    // Per test bed : status age , longest age ( ms , 2 each ) , with each health record
+
+// Telemetry_Boot events
+#define TELEMETRY_BOOT_FRAME    0       // Start up frame on the panel
+#define TELEMETRY_BOOT_STATUS   1       // First valid status from the test bed
+
+// TELEMETRY_LINK_ERROR kinds
+#define TELEMETRY_ERROR_REPLY   1       // No valid reply , bad CRC or sync
+#define TELEMETRY_ERROR_TIMEOUT 2
+
+typedef struct
+{
+    uint32_t Overruns;      // Records lost to a full ring
+    uint32_t Records;       // Records pushed
+    uint32_t Sent;          // Bytes sent to the host
+} Telemetry_Stats_t;
+
+extern volatile Telemetry_Stats_t Telemetry_Stats;
+
+void Telemetry_Boot       ( uint8_t event , uint32_t time );
+void Telemetry_ButtonDrop ( uint8_t mask , uint8_t type );
+void Telemetry_Drain      ( void );
+void Telemetry_Fed        ( void );
+void Telemetry_Init       ( void );
+void Telemetry_LinkError  ( uint8_t bed , uint8_t kind );
+bool Telemetry_Push       ( uint8_t type , const uint8_t *payload , uint8_t length );
+void Telemetry_SPI        ( uint32_t latency );
+
+#endif /* __TELEMETRY_H */
+
+/*** end of file ***/
@@ -0,0 +1,49 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           text.h                                                *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+// Define to prevent recursive inclusion
+#ifndef __TEXT_H
+#define __TEXT_H
+
+#include <main.h>
+#include <font.h>
+
+// Status text in the font.h glyphs , which are already framebuffer words.
+// A string is gathered once from them into its row words and kept in a
+// small least recently used cache keyed on the string and where it is
+// drawn , so drawing an unchanged label again is only a masked word copy
+// per row and plane with no per pixel work.
+#define TEXT_CACHE_ENTRIES  8
+#define TEXT_LENGTH         16  // Characters per string , longer ones are cut short
+
+_Static_assert ( FONT_PITCH == 4 , "A character is one framebuffer word" );
+
+typedef struct
+{
+    uint32_t Characters;    // Drawn
+    uint32_t Draws;
+    uint32_t Hits;          // Strings found in the cache
+    uint32_t Rasterised;    // Strings gathered into the cache
+} Text_Stats_t;
+
+extern volatile Text_Stats_t Text_Stats;
+
+uint32_t Text_Draw ( uint row , uint column , const char *text , uint8_t chars , uint32_t colour );
+
+#endif /* __TEXT_H */
+
+/*** end of file ***/
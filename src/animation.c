@@ -0,0 +1,237 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           animation.c                                           *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <animation.h>
+#include <hub75.h>
+#include <matrix_layout.h>
+
+// Tile animation on the refresh timebase. Animation_Start works out a
+// tile's keyframes once , Animation_Step then redraws only the tiles whose
+// keyframe has changed since Hub75_FrameCount last moved on , so an
+// animated tile costs a tile's worth of bit-plane writes a few times a
+// second and nothing is recomposed.
+//
+// Blink and pulse keyframes are colours. Chase keyframes are indexes into
+// the tile border , walked clockwise from the top left pixel.
+//
+// A tile can carry a bar graph , Lit rows from the bottom in the keyframe
+// colour and the rest dimmed as the chase background. A whole tile is a
+// full bar. Chase tiles ignore the bar.
+#define ANIMATION_BORDER    ( 2 * ( TILE_WIDTH + TILE_HEIGHT ) - 4 )
+
+_Static_assert ( ( 3 == TILE_WIDTH ) && ( 4 == TILE_HEIGHT ) , "Chase border in Animation_Draw is laid out for 3 x 4 tiles" );
+
+typedef struct
+{
+    uint32_t Colour;
+    uint32_t Key [ ANIMATION_KEYFRAMES ];
+    uint8_t  Column;
+    uint8_t  Drawn;     // Keyframe on the panel
+    uint8_t  Effect;
+    uint8_t  Lit;       // Bar graph rows , TILE_HEIGHT for the whole tile
+    uint8_t  Row;
+} Animation_Tile_t;
+
+static Animation_Tile_t Animation_Tiles [ ANIMATION_SLOTS ] = { [ 0 ... ANIMATION_SLOTS - 1 ] = { .Lit = TILE_HEIGHT } };
+
+static uint32_t Animation_Draw  ( Animation_Tile_t *tile , uint8_t key , bool whole );
+static uint32_t Animation_Scale ( uint32_t colour , uint32_t level );
+
+// Set a tile's bar graph , lit rows from the bottom , and redraw it if that
+// changed. Returns the pixel rows written.
+uint32_t Animation_Bar ( uint8_t slot , uint8_t lit )
+{
+    Animation_Tile_t *Tile  = NULL;
+    uint32_t          Dirty = 0;
+
+    lit = ( lit > TILE_HEIGHT ) ? TILE_HEIGHT : lit;
+
+    if ( ( slot < ANIMATION_SLOTS ) && ( lit != Animation_Tiles [ slot ].Lit ) )
+    {
+        Tile      = &Animation_Tiles [ slot ];
+        Tile->Lit = lit;
+
+        if ( ANIMATION_CHASE != Tile->Effect )
+        {
+            Dirty = Animation_Draw ( Tile , Tile->Drawn , true );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Dirty;
+}
+
+// Set a tile's effect and draw its current keyframe , returns the pixel rows written
+uint32_t Animation_Start ( uint8_t slot , uint row , uint column , uint8_t effect , uint32_t colour )
+{
+    Animation_Tile_t *Tile        = NULL;
+    uint32_t          Dirty       = 0;
+    uint32_t          Level       = 0;
+    uint8_t           Counter_Key = 0;
+    uint8_t           Step        = 0;
+
+    if ( slot < ANIMATION_SLOTS )
+    {
+        Tile         = &Animation_Tiles [ slot ];
+        Tile->Colour = colour;
+        Tile->Column = ( uint8_t ) column;
+        Tile->Effect = effect;
+        Tile->Row    = ( uint8_t ) row;
+
+        for ( Counter_Key = 0 ; Counter_Key < ANIMATION_KEYFRAMES ; Counter_Key++ )
+        {
+            Step = ( Counter_Key <= ( ANIMATION_KEYFRAMES / 2 ) ) ? Counter_Key : ( ANIMATION_KEYFRAMES - Counter_Key );
+
+            switch ( effect )
+            {
+                case ANIMATION_BLINK:
+                    Tile->Key [ Counter_Key ] = ( Counter_Key < ( ANIMATION_KEYFRAMES / 2 ) ) ? colour : COLOUR_BLACK;
+                break;
+
+                case ANIMATION_PULSE:
+                    Level                     = 255 - ( ( Step * ( 255 - ANIMATION_PULSE_MIN ) ) / ( ANIMATION_KEYFRAMES / 2 ) );
+                    Tile->Key [ Counter_Key ] = Animation_Scale ( colour , Level );
+                break;
+
+                case ANIMATION_CHASE:
+                    Tile->Key [ Counter_Key ] = ( Counter_Key * ANIMATION_BORDER ) / ANIMATION_KEYFRAMES;
+                break;
+
+                default:
+                    Tile->Key [ Counter_Key ] = colour;
+                break;
+            }
+        }
+
+        Dirty = Animation_Draw ( Tile , ( Hub75_FrameCount / ANIMATION_FRAMES_PER_KEY ) % ANIMATION_KEYFRAMES , true );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Dirty;
+}
+
+// Bring every animated tile to the current keyframe , returns the pixel rows written
+uint32_t Animation_Step ( void )
+{
+    uint32_t Dirty        = 0;
+    uint8_t  Key          = ( Hub75_FrameCount / ANIMATION_FRAMES_PER_KEY ) % ANIMATION_KEYFRAMES;
+    uint8_t  Counter_Slot = 0;
+
+    for ( Counter_Slot = 0 ; Counter_Slot < ANIMATION_SLOTS ; Counter_Slot++ )
+    {
+        if ( ( ANIMATION_NONE != Animation_Tiles [ Counter_Slot ].Effect ) && ( Key != Animation_Tiles [ Counter_Slot ].Drawn ) )
+        {
+            Dirty |= Animation_Draw ( &Animation_Tiles [ Counter_Slot ] , Key , false );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Dirty;
+}
+
+// Draw keyframe key , the whole tile or only what differs from the one drawn last
+static uint32_t Animation_Draw ( Animation_Tile_t *tile , uint8_t key , bool whole )
+{
+    static const uint8_t BORDER_ROW    [ ANIMATION_BORDER ] = { 0 , 0 , 0 , 1 , 2 , 3 , 3 , 3 , 2 , 1 };
+    static const uint8_t BORDER_COLUMN [ ANIMATION_BORDER ] = { 0 , 1 , 2 , 2 , 2 , 2 , 1 , 0 , 0 , 0 };
+
+    uint32_t Dirty = 0;
+    uint32_t Old   = tile->Key [ tile->Drawn ];
+    uint32_t New   = tile->Key [ key ];
+
+    if ( ANIMATION_CHASE == tile->Effect )
+    {
+        // Only the two border pixels change from one keyframe to the next
+        if ( whole )
+        {
+            Hub75_FillRect ( tile->Row , tile->Column , TILE_WIDTH , TILE_HEIGHT , Animation_Scale ( tile->Colour , 255 / ANIMATION_CHASE_DIM ) );
+            Dirty = ( ( 1u << TILE_HEIGHT ) - 1 ) << tile->Row;
+        }
+        else if ( Old != New )
+        {
+            Hub75_SetPixel ( tile->Row + BORDER_ROW [ Old ] , tile->Column + BORDER_COLUMN [ Old ] , Animation_Scale ( tile->Colour , 255 / ANIMATION_CHASE_DIM ) );
+            Dirty = 1u << ( tile->Row + BORDER_ROW [ Old ] );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        if ( whole || ( Old != New ) )
+        {
+            Hub75_SetPixel ( tile->Row + BORDER_ROW [ New ] , tile->Column + BORDER_COLUMN [ New ] , tile->Colour );
+            Dirty |= 1u << ( tile->Row + BORDER_ROW [ New ] );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else if ( whole || ( Old != New ) )
+    {
+        if ( tile->Lit < TILE_HEIGHT )
+        {
+            Hub75_FillRect ( tile->Row , tile->Column , TILE_WIDTH , TILE_HEIGHT - tile->Lit , Animation_Scale ( New , 255 / ANIMATION_CHASE_DIM ) );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        if ( 0 != tile->Lit )
+        {
+            Hub75_FillRect ( tile->Row + TILE_HEIGHT - tile->Lit , tile->Column , TILE_WIDTH , tile->Lit , New );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Dirty = ( ( 1u << TILE_HEIGHT ) - 1 ) << tile->Row;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    tile->Drawn = key;
+
+    return Dirty;
+}
+
+// Colour with each channel scaled by level / 255
+static uint32_t Animation_Scale ( uint32_t colour , uint32_t level )
+{
+    return ( ( ( ( ( colour >> 16 ) & 0xFF ) * level ) / 255 ) << 16 )
+         | ( ( ( ( ( colour >>  8 ) & 0xFF ) * level ) / 255 ) <<  8 )
+         |   ( ( (   colour         & 0xFF ) * level ) / 255 );
+}
+
+/*** end of file ***/
@@ -0,0 +1,233 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           batch.c                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <batch.h>
+#include <buttons.h>
+
+#include <string.h>
+
+// Slot n holds the batch sent with a sequence number of n modulo
+// PROTOCOL_WINDOW , the same slot the protocol window uses for it , with
+// one window per test bed
+typedef struct
+{
+    Button_Event_t Items [ BATCH_ITEMS_MAX ];
+    uint8_t        Count;
+    uint8_t        Sequence;
+    bool           Valid;
+} Batch_InFlight_t;
+
+static Batch_InFlight_t Batch_Window [ TESTBED_COUNT ] [ PROTOCOL_WINDOW ];
+static Button_Event_t   Batch_Pending [ BUTTON_QUEUE_LENGTH ];  // Oldest first
+static uint8_t          Batch_Bed     = 0;                      // Selected by Batch_Select
+static uint8_t          Batch_Count   = 0;
+
+volatile Batch_Stats_t Batch_Stats;
+
+static void Batch_Fill    ( void );
+static void Batch_Requeue ( void );
+
+// Build the next transaction into tx , returns 0 if there is nothing to send.
+// *status requests a status read and is cleared once one has been built.
+uint8_t Batch_Build ( bool *status , uint8_t *tx )
+{
+    Batch_InFlight_t *Slot         = &Batch_Window [ Batch_Bed ] [ Protocol_Next ( ) % PROTOCOL_WINDOW ];
+    uint8_t           Payload      [ PROTOCOL_PAYLOAD_MAX ];
+    uint8_t           Command      [ 2 ];
+    uint8_t           Count        = 0;
+    uint8_t           Length       = 0;
+    uint8_t           Counter_Item = 0;
+    bool              Status       = false;
+
+    Batch_Fill ( );
+
+    if ( Protocol_Legacy ( Batch_Bed ) )    // One command per transaction , never acknowledged
+    {
+        Batch_Requeue ( );
+
+        if ( ( 0 != Batch_Count ) && ( BATCH_BUTTON_BED == Batch_Bed ) )
+        {
+            Command [ 0 ] = Batch_Pending [ 0 ].Mask;
+            Command [ 1 ] = Batch_Pending [ 0 ].Type;
+
+            Length = Protocol_Request ( PROTOCOL_OP_BUTTON , Command , sizeof ( Command ) , tx );
+
+            Batch_Count--;
+            memmove ( &Batch_Pending [ 0 ] , &Batch_Pending [ 1 ] , Batch_Count * sizeof ( Batch_Pending [ 0 ] ) );
+            Batch_Stats.Items++;
+        }
+        else if ( *status )
+        {
+            Length  = Protocol_Request ( PROTOCOL_OP_STATUS , NULL , 0 , tx );
+            *status = false;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else if ( *status || ( ( 0 != Batch_Count ) && ( BATCH_BUTTON_BED == Batch_Bed ) ) )
+    {
+        Count  = ( BATCH_BUTTON_BED != Batch_Bed ) ? 0 : ( ( Batch_Count > BATCH_ITEMS_MAX ) ? BATCH_ITEMS_MAX : Batch_Count );
+        Count  = ( BATCH_SINGLE && ( 0 != Count ) ) ? 1 : Count;
+        Status = *status && !( BATCH_SINGLE && ( 0 != Count ) );     // Single , buttons first
+
+        if ( Slot->Valid )  // Reply never came , the protocol has reused the slot
+        {
+            Batch_Stats.Lost += Slot->Count;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Payload [ 0 ] = ( Status ? BATCH_STATUS_JIG : 0 ) | Count;
+
+        for ( Counter_Item = 0 ; Counter_Item < Count ; Counter_Item++ )
+        {
+            Payload [ 1 + ( Counter_Item * 2 ) ] = Batch_Pending [ Counter_Item ].Mask;
+            Payload [ 2 + ( Counter_Item * 2 ) ] = Batch_Pending [ Counter_Item ].Type;
+            Slot->Items [ Counter_Item ]         = Batch_Pending [ Counter_Item ];
+        }
+
+        Slot->Count    = Count;
+        Slot->Sequence = Protocol_Next ( );
+        Slot->Valid    = true;
+
+        Batch_Count -= Count;
+        memmove ( &Batch_Pending [ 0 ] , &Batch_Pending [ Count ] , Batch_Count * sizeof ( Batch_Pending [ 0 ] ) );
+
+        Batch_Stats.Batches++;
+        Batch_Stats.Items += Count;
+
+        Length  = Protocol_Request ( PROTOCOL_OP_BATCH , Payload , 1 + ( Count * 2 ) , tx );
+        *status = *status && !Status;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Length;
+}
+
+// Act on a reply from Protocol_Receive , true if it carried a status
+bool Batch_Reply ( const Protocol_Frame_t *frame , Protocol_Status_t *status )
+{
+    Batch_InFlight_t *Slot   = &Batch_Window [ Batch_Bed ] [ frame->Sequence % PROTOCOL_WINDOW ];
+    Protocol_Frame_t  Status;
+    uint8_t           Acked  = 0;
+    uint8_t           Resend = 0;
+    bool              Valid  = false;
+
+    if ( ( PROTOCOL_OP_BATCH == frame->Opcode ) && ( 1 <= frame->Length ) && Slot->Valid && ( frame->Sequence == Slot->Sequence ) )
+    {
+        Slot->Valid = false;
+        Acked       = ( frame->Payload [ 0 ] > Slot->Count ) ? Slot->Count : frame->Payload [ 0 ];
+        Resend      = Slot->Count - Acked;
+
+        // Unacknowledged buttons are older than anything still pending
+        if ( ( 0 != Resend ) && ( ( Batch_Count + Resend ) <= BUTTON_QUEUE_LENGTH ) )
+        {
+            memmove ( &Batch_Pending [ Resend ] , &Batch_Pending [ 0 ] , Batch_Count * sizeof ( Batch_Pending [ 0 ] ) );
+            memcpy  ( &Batch_Pending [ 0 ] , &Slot->Items [ Acked ] , Resend * sizeof ( Batch_Pending [ 0 ] ) );
+            Batch_Count += Resend;
+            Batch_Stats.Resent += Resend;
+        }
+        else
+        {
+            Batch_Stats.Lost += Resend;
+        }
+
+        Batch_Stats.Acknowledged += Acked;
+
+        // The rest of the payload is a status reply
+        Status.Opcode   = PROTOCOL_OP_STATUS_JIG;
+        Status.Sequence = frame->Sequence;
+        Status.Length   = frame->Length - 1;
+        memcpy ( Status.Payload , &frame->Payload [ 1 ] , Status.Length );
+
+        Valid = Protocol_Status ( &Status , status );
+    }
+    else
+    {
+        Valid = Protocol_Status ( frame , status );
+    }
+
+    return Valid;
+}
+
+// Test bed the following Batch_Build and Batch_Reply calls belong to , along
+// with Protocol_Select
+void Batch_Select ( uint8_t bed )
+{
+    Batch_Bed = ( bed < TESTBED_COUNT ) ? bed : 0;
+}
+
+// Move button events from the interrupt queue , releases are not sent
+static void Batch_Fill ( void )
+{
+    Button_Event_t Button;
+
+    while ( ( Batch_Count < BUTTON_QUEUE_LENGTH ) && Buttons_Get ( &Button ) )
+    {
+        if ( BUTTON_EVENT_RELEASE != Button.Type )
+        {
+            Batch_Pending [ Batch_Count++ ] = Button;
+            Buttons_Sent ( &Button );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+}
+
+// Batches still in flight when the test bed fell back to legacy , after a v2
+// probe or on going quiet , were never answered. Their buttons go again
+// ahead of anything pending.
+static void Batch_Requeue ( void )
+{
+    Batch_InFlight_t *Slot         = NULL;
+    uint8_t           Counter_Slot = 0;
+
+    // Newest first , each goes ahead of the last so the oldest ends up first
+    for ( Counter_Slot = PROTOCOL_WINDOW ; Counter_Slot > 0 ; Counter_Slot-- )
+    {
+        Slot = &Batch_Window [ Batch_Bed ] [ ( Protocol_Next ( ) + Counter_Slot - 1 ) % PROTOCOL_WINDOW ];
+
+        if ( Slot->Valid && ( ( Batch_Count + Slot->Count ) <= BUTTON_QUEUE_LENGTH ) )
+        {
+            memmove ( &Batch_Pending [ Slot->Count ] , &Batch_Pending [ 0 ] , Batch_Count * sizeof ( Batch_Pending [ 0 ] ) );
+            memcpy  ( &Batch_Pending [ 0 ] , &Slot->Items [ 0 ] , Slot->Count * sizeof ( Batch_Pending [ 0 ] ) );
+            Batch_Count        += Slot->Count;
+            Batch_Stats.Resent += Slot->Count;
+        }
+        else if ( Slot->Valid )
+        {
+            Batch_Stats.Lost += Slot->Count;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Slot->Valid = false;
+    }
+}
+
+/*** end of file ***/
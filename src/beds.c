@@ -0,0 +1,101 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           beds.c                                                *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <beds.h>
+
+#include <string.h>
+
+static uint32_t Beds_Last  [ TESTBED_COUNT ];   // Hal_Micros of the last status
+static bool     Beds_Shown [ TESTBED_COUNT ];   // Last Beds_Stale answer , counts each stale once
+
+volatile Beds_Stats_t Beds_Stats [ TESTBED_COUNT ];
+
+// Ages start from here , a bed that never answers goes stale after BEDS_STALE_MS
+void Beds_Init ( void )
+{
+    uint32_t Now         = Hal_Micros ( );
+    uint8_t  Counter_Bed = 0;
+
+    memset ( ( void * ) Beds_Stats , 0 , sizeof ( Beds_Stats ) );
+
+    for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
+    {
+        Beds_Last  [ Counter_Bed ] = Now;
+        Beds_Shown [ Counter_Bed ] = false;
+    }
+}
+
+// Called for each decoded status reply from bed
+void Beds_Received ( uint8_t bed )
+{
+    uint32_t Now = Hal_Micros ( );
+    uint32_t Age = 0;
+
+    if ( bed < TESTBED_COUNT )
+    {
+        Age = Now - Beds_Last [ bed ];
+
+        if ( 0 != Beds_Stats [ bed ].Statuses )     // The first is boot time , not a gap
+        {
+            Beds_Stats [ bed ].AgeMax = ( Age > Beds_Stats [ bed ].AgeMax ) ? Age : Beds_Stats [ bed ].AgeMax;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Beds_Last  [ bed ] = Now;
+        Beds_Shown [ bed ] = false;
+        Beds_Stats [ bed ].Age = 0;
+        Beds_Stats [ bed ].Statuses++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// True once bed has not answered a status for BEDS_STALE_MS
+bool Beds_Stale ( uint8_t bed )
+{
+    bool Stale = true;
+
+    if ( bed < TESTBED_COUNT )
+    {
+        Beds_Stats [ bed ].Age = Hal_Micros ( ) - Beds_Last [ bed ];
+        Stale                  = ( Beds_Stats [ bed ].Age >= ( BEDS_STALE_MS * 1000u ) );
+
+        if ( Stale && !Beds_Shown [ bed ] )
+        {
+            Beds_Stats [ bed ].Stale++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Beds_Shown [ bed ] = Stale;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Stale;
+}
+
+/*** end of file ***/
@@ -0,0 +1,82 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           bench.c                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <bench.h>
+#include <hub75.h>
+#include <scheduler.h>
+
+#include <string.h>
+
+static const char *Bench_Names [ BENCH_STAGES ] = { "compose" , "frame" , "swap" , "text" };
+
+volatile Bench_Stage_t Bench_Stages [ BENCH_STAGES ];
+
+void Bench_Add ( uint stage , uint32_t cycles )
+{
+    volatile Bench_Stage_t *Stage = &Bench_Stages [ stage ];
+
+    Stage->Last   = cycles;
+    Stage->Max    = ( cycles > Stage->Max ) ? cycles : Stage->Max;
+    Stage->Min    = ( ( 0 == Stage->Count ) || ( cycles < Stage->Min ) ) ? cycles : Stage->Min;
+    Stage->Total += cycles;
+    Stage->Count++;
+}
+
+// { "clock_hz" , "ways" , "pixels" , "scan_lines" , "planes" ,
+//   "model" : { PIO stages per frame } , "fps" , "min_fps" , "load" ,
+//   stage : { "count" , "last" , "min" , "max" , "mean" } , ... }
+void Bench_Report ( void )
+{
+    const volatile Bench_Stage_t *Frame         = &Bench_Stages [ BENCH_STAGE_FRAME ];
+    Hub75_Timing_t                Timing;
+    uint32_t                      Clock         = Hal_ClockHz ( );
+    uint64_t                      Now           = Hal_Micros64 ( );
+    uint32_t                      Mean          = 0;
+    uint                          Counter_Stage = 0;
+
+    Hub75_Timing ( &Timing );
+
+    printf ( "{\"clock_hz\":%u,\"ways\":%u,\"pixels\":%u,\"scan_lines\":%u,\"planes\":%u,\"model\":{\"shift\":%u,\"latch\":%u,\"dwell\":%u,\"frame\":%u,\"fps\":%.2f},\"fps\":%.2f,\"min_fps\":%u,\"load\":%.1f" ,
+             ( uint ) Clock , ( uint ) SENSOR_COUNT , ( uint ) ( MATRIX_WIDTH * MATRIX_HEIGHT ) , ( uint ) HUB75_SCAN_LINES , ( uint ) HUB75_COLOUR_DEPTH ,
+             ( uint ) Timing.Shift , ( uint ) Timing.Latch , ( uint ) Timing.Dwell , ( uint ) ( Timing.Shift + Timing.Latch + Timing.Dwell ) ,
+             ( double ) Clock / ( double ) ( Timing.Shift + Timing.Latch + Timing.Dwell ) ,
+             ( 0 != Frame->Total ) ? ( ( double ) Clock * Frame->Count ) / ( double ) Frame->Total : 0.0 , ( uint ) HUB75_REFRESH_MIN_HZ ,
+             ( 0 != Now ) ? ( 100.0 * ( double ) ( Now - Scheduler_Stats.Idle ) ) / ( double ) Now : 0.0 );   // Percent of the run awake
+
+    for ( Counter_Stage = 0 ; Counter_Stage < BENCH_STAGES ; Counter_Stage++ )
+    {
+        Mean = ( 0 != Bench_Stages [ Counter_Stage ].Count ) ? ( uint32_t ) ( Bench_Stages [ Counter_Stage ].Total / Bench_Stages [ Counter_Stage ].Count ) : 0;
+
+        printf ( ",\"%s\":{\"count\":%u,\"last\":%u,\"min\":%u,\"max\":%u,\"mean\":%u}" , Bench_Names [ Counter_Stage ] ,
+                 ( uint ) Bench_Stages [ Counter_Stage ].Count , ( uint ) Bench_Stages [ Counter_Stage ].Last ,
+                 ( uint ) Bench_Stages [ Counter_Stage ].Min   , ( uint ) Bench_Stages [ Counter_Stage ].Max  , ( uint ) Mean );
+    }
+
+    printf ( "}\n" );
+}
+
+void Bench_Reset ( void )
+{
+    memset ( ( void * ) Bench_Stages , 0 , sizeof ( Bench_Stages ) );
+}
+
+void Bench_Stop ( uint stage , uint32_t start )
+{
+    Bench_Add ( stage , ( Hal_Cycles ( ) - start ) & HAL_CYCLES_MASK );
+}
+
+/*** end of file ***/
@@ -0,0 +1,210 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           buttons.c                                             *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <buttons.h>
+#include <scheduler.h>
+#include <telemetry.h>
+
+#include <string.h>
+
+static const uint ButtonPin [ BUTTON_COUNT ] = { SW1 , SW2 , SW3 , SW4 };
+
+// Written from the GPIO and alarm interrupts only
+static int32_t    Button_Alarm    [ BUTTON_COUNT ] = { 0 };
+static bool       Button_Bouncing [ BUTTON_COUNT ] = { 0 };  // Edges seen , debounce alarm pending
+static uint32_t   Button_Edge     [ BUTTON_COUNT ] = { 0 };  // First edge since the switch was last stable
+static bool       Button_Long     [ BUTTON_COUNT ] = { 0 };  // Long press still to be reported
+static uint32_t   Button_Since    [ BUTTON_COUNT ] = { 0 };  // First edge of the current press
+static uint8_t    Button_Stable   = 0;                       // Debounced state , one bit per switch
+
+static Button_Event_t   Button_Queue [ BUTTON_QUEUE_LENGTH ];
+static volatile uint8_t Button_Head  = 0;   // Written by the interrupts
+static volatile uint8_t Button_Tail  = 0;   // Written by Buttons_Get
+
+volatile Buttons_Stats_t Buttons_Stats;
+
+static int64_t Buttons_Alarm ( int32_t id , void *user_data );
+static void    Buttons_ISR   ( void );
+static void    Buttons_Queue ( uint8_t type , uint8_t mask , uint32_t time );
+
+// Oldest queued event , false if there is none
+bool Buttons_Get ( Button_Event_t *event )
+{
+    bool Available = ( Button_Head != Button_Tail );
+
+    if ( Available )
+    {
+        *event = Button_Queue [ Button_Tail & ( BUTTON_QUEUE_LENGTH - 1 ) ];
+        Hal_Barrier ( );
+        Button_Tail++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Available;
+}
+
+void Buttons_Init ( void )
+{
+    uint32_t Mask           = 0;
+    uint     Counter_Button = 0;
+
+    memset ( ( void * ) &Buttons_Stats , 0 , sizeof ( Buttons_Stats ) );
+
+    for ( Counter_Button = 0 ; Counter_Button < BUTTON_COUNT ; Counter_Button++ )
+    {
+        Mask |= 1u << ButtonPin [ Counter_Button ];
+        Button_Stable |= ( uint8_t ) ( Hal_GpioGet ( ButtonPin [ Counter_Button ] ) << Counter_Button );
+    }
+
+    Hal_GpioIrq ( Mask , HAL_EDGE_FALL | HAL_EDGE_RISE , Buttons_ISR );
+}
+
+// Record that an event's command has been handed to the SPI link
+void Buttons_Sent ( const Button_Event_t *event )
+{
+    uint32_t Latency = Hal_Micros ( ) - event->Time;
+
+    Buttons_Stats.Latency    = Latency;
+    Buttons_Stats.LatencyMax = ( Latency > Buttons_Stats.LatencyMax ) ? Latency : Buttons_Stats.LatencyMax;
+    Buttons_Stats.Sent++;
+}
+
+// Debounce expiry , or the long press check while a switch is held.
+// A positive return runs the alarm again that many microseconds later.
+static int64_t Buttons_Alarm ( int32_t id , void *user_data )
+{
+    uint     Button  = ( uint ) ( uintptr_t ) user_data;
+    uint8_t  Bit     = ( uint8_t ) ( 1u << Button );
+    uint32_t Held    = 0;
+    int64_t  Again   = 0;
+    bool     Pressed = Hal_GpioGet ( ButtonPin [ Button ] );
+
+    Button_Bouncing [ Button ] = false;
+
+    if ( Pressed != ( 0 != ( Button_Stable & Bit ) ) )
+    {
+        Button_Stable ^= Bit;
+
+        if ( Pressed )
+        {
+            Buttons_Queue ( ( Button_Stable != Bit ) ? BUTTON_EVENT_CHORD : BUTTON_EVENT_PRESS , ( Button_Stable != Bit ) ? Button_Stable : Bit , Button_Edge [ Button ] );
+
+            Button_Long  [ Button ] = true;
+            Button_Since [ Button ] = Button_Edge [ Button ];
+            Held  = Hal_Micros ( ) - Button_Since [ Button ];
+            Again = ( BUTTON_LONG_MS * 1000 ) - Held;
+        }
+        else
+        {
+            Buttons_Queue ( BUTTON_EVENT_RELEASE , Bit , Button_Edge [ Button ] );
+
+            Button_Long [ Button ] = false;
+        }
+    }
+    else if ( Pressed && Button_Long [ Button ] )   // Still held , possibly after a glitch
+    {
+        Held = Hal_Micros ( ) - Button_Since [ Button ];
+
+        if ( Held >= ( BUTTON_LONG_MS * 1000 ) )
+        {
+            Buttons_Queue ( BUTTON_EVENT_LONG , Bit , Hal_Micros ( ) );    // Not the edge , or the hold counts as latency
+
+            Button_Long [ Button ] = false;
+        }
+        else
+        {
+            Again = ( BUTTON_LONG_MS * 1000 ) - Held;
+        }
+    }
+    else
+    {
+        // Bounce settled back to the stable state
+    }
+
+    Button_Alarm [ Button ] = ( 0 < Again ) ? id : 0;
+
+    return ( 0 < Again ) ? Again : 0;
+}
+
+// Any edge restarts that switch's debounce alarm
+static void Buttons_ISR ( void )
+{
+    uint32_t Events         = 0;
+    uint     Counter_Button = 0;
+
+    for ( Counter_Button = 0 ; Counter_Button < BUTTON_COUNT ; Counter_Button++ )
+    {
+        Events = Hal_GpioEvents ( ButtonPin [ Counter_Button ] ) & ( HAL_EDGE_FALL | HAL_EDGE_RISE );
+
+        if ( 0 != Events )
+        {
+            Buttons_Stats.Edges++;
+
+            if ( 0 != Button_Alarm [ Counter_Button ] )
+            {
+                Hal_TimerCancel ( Button_Alarm [ Counter_Button ] );
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            if ( !Button_Bouncing [ Counter_Button ] )  // First edge after a quiet period
+            {
+                Button_Edge     [ Counter_Button ] = Hal_Micros ( );
+                Button_Bouncing [ Counter_Button ] = true;
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            Button_Alarm [ Counter_Button ] = Hal_TimerStart ( BUTTON_DEBOUNCE_MS * 1000 , Buttons_Alarm , ( void * ) ( uintptr_t ) Counter_Button );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+}
+
+static void Buttons_Queue ( uint8_t type , uint8_t mask , uint32_t time )
+{
+    Button_Event_t *Event = &Button_Queue [ Button_Head & ( BUTTON_QUEUE_LENGTH - 1 ) ];
+
+    if ( ( uint8_t ) ( Button_Head - Button_Tail ) < BUTTON_QUEUE_LENGTH )
+    {
+        Event->Mask = mask;
+        Event->Time = time;
+        Event->Type = type;
+        Hal_Barrier ( );
+        Button_Head++;
+        Buttons_Stats.Events++;
+
+        Scheduler_Event ( );
+    }
+    else
+    {
+        Buttons_Stats.Dropped++;
+        Telemetry_ButtonDrop ( mask , type );
+    }
+}
+
+/*** end of file ***/
@@ -0,0 +1,213 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           hal_rp2040.c                                          *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <main.h>
+
+#include <hardware/clocks.h>
+#include <hardware/irq.h>
+#include <hardware/structs/systick.h>
+#include <hardware/sync.h>
+#include <hardware/timer.h>
+#include <hardware/watchdog.h>
+#include <pico/binary_info.h>
+#include <pico/stdio_usb.h>
+
+static int Hal_Alarm = -1;  // Hardware alarm behind Hal_WakeAt
+
+static void Hal_AlarmISR ( uint alarm_num );
+
+void Hal_Init ( void )
+{
+    // Useful information for picotool
+    bi_decl ( bi_program_description ( "RP2040 Premier" ) );
+
+    // Initialise standard stdio types
+    stdio_init_all ( );
+
+    // Set up watchdog
+    watchdog_enable ( WATCHDOG_MILLISECONDS , 1 );
+
+    Hal_Alarm = hardware_alarm_claim_unused ( true );
+    hardware_alarm_set_callback ( ( uint ) Hal_Alarm , Hal_AlarmISR );
+
+    Hal_CyclesStart ( );
+}
+
+uint32_t Hal_ClockHz ( void )
+{
+    return clock_get_hz ( clk_sys );
+}
+
+// SysTick counts down , so the count is inverted to run upwards
+uint32_t Hal_Cycles ( void )
+{
+    return HAL_CYCLES_MASK - systick_hw->cvr;
+}
+
+// Free running SysTick from the processor clock , no interrupt
+void Hal_CyclesStart ( void )
+{
+    systick_hw->csr = 0;
+    systick_hw->rvr = HAL_CYCLES_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+void Hal_DelayUs ( uint32_t us )
+{
+    sleep_us ( us );
+}
+
+uint32_t Hal_Micros ( void )
+{
+    return time_us_32 ( );
+}
+
+uint64_t Hal_Micros64 ( void )
+{
+    return time_us_64 ( );
+}
+
+// A terminal has the port open ( DTR set )
+bool Hal_HostConnected ( void )
+{
+    return stdio_usb_connected ( );
+}
+
+// Straight to the USB driver , bypassing stdout's CR / LF handling
+void Hal_HostWrite ( const uint8_t *data , uint32_t length )
+{
+    if ( 0 != length )
+    {
+        stdio_usb.out_chars ( ( const char * ) data , ( int ) length );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+uint32_t Hal_GpioEvents ( uint pin )
+{
+    uint32_t Events = gpio_get_irq_event_mask ( pin );
+
+    gpio_acknowledge_irq ( pin , Events );
+
+    return Events;
+}
+
+bool Hal_GpioGet ( uint pin )
+{
+    return gpio_get ( pin );
+}
+
+void Hal_GpioInput ( uint pin , bool pull_down )
+{
+    gpio_init    ( pin           );
+    gpio_set_dir ( pin , GPIO_IN );
+
+    if ( pull_down )
+    {
+        gpio_pull_down ( pin );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// handler runs for any enabled edge on pins ( bit n = GPIO n ) and reads them with Hal_GpioEvents
+void Hal_GpioIrq ( uint32_t pins , uint32_t edges , Hal_Handler_t handler )
+{
+    uint Counter_Pin = 0;
+
+    for ( Counter_Pin = 0 ; Counter_Pin < 32 ; Counter_Pin++ )
+    {
+        if ( ( pins >> Counter_Pin ) & 1 )
+        {
+            gpio_set_irq_enabled ( Counter_Pin , edges , true );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    gpio_add_raw_irq_handler_masked ( pins         , handler );
+    irq_set_enabled                 ( IO_IRQ_BANK0 , true    );
+}
+
+void Hal_GpioOutput ( uint pin )
+{
+    gpio_init    ( pin            );
+    gpio_set_dir ( pin , GPIO_OUT );
+}
+
+void Hal_GpioPut ( uint pin , bool level )
+{
+    gpio_put ( pin , level );
+}
+
+void Hal_Barrier ( void )
+{
+    __dmb ( );
+}
+
+uint32_t Hal_IrqDisable ( void )
+{
+    return save_and_disable_interrupts ( );
+}
+
+void Hal_IrqRestore ( uint32_t state )
+{
+    restore_interrupts ( state );
+}
+
+void Hal_TimerCancel ( int32_t id )
+{
+    cancel_alarm ( ( alarm_id_t ) id );
+}
+
+// Runs from the default alarm pool , 0 or less if no timer was free
+int32_t Hal_TimerStart ( uint32_t delay_us , Hal_TimerCallback_t callback , void *user_data )
+{
+    return ( int32_t ) add_alarm_in_us ( delay_us , ( alarm_callback_t ) callback , user_data , true );
+}
+
+// A pending interrupt still ends __wfi with interrupts disabled , so none is missed
+void Hal_Sleep ( void )
+{
+    __wfi ( );
+}
+
+bool Hal_WakeAt ( uint64_t time )
+{
+    return !hardware_alarm_set_target ( ( uint ) Hal_Alarm , from_us_since_boot ( time ) );
+}
+
+void Hal_WatchdogFeed ( void )
+{
+    watchdog_update ( );
+}
+
+// Only there to end __wfi
+static void Hal_AlarmISR ( uint alarm_num )
+{
+    // Nothing to do
+}
+
+/*** end of file ***/
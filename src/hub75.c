@@ -0,0 +1,501 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           hub75.c                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <hub75.h>
+#include <bench.h>
+#include <gamma.h>
+#include <matrix_default.h>
+
+#include <string.h>
+#include <hardware/clocks.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/pio.h>
+#include <hardware/sync.h>
+#include <pico/multicore.h>
+
+#include "hub75.pio.h"
+
+const uint64_t MATRIX_DELAY_REFRESH = HUB75_DWELL_US;  // microseconds
+
+// Scan order framebuffer : one byte per column per scan line holding
+// R1 G1 B1 R2 G2 B2 in GPIO order , so a column is a single masked write
+// of ( byte << HUB75_RGB_BASE_PIN ) and four columns are one DMA beat.
+//
+// Binary code modulation : every line is sent once per bit-plane , plane n
+// being shown for 2^n times the least significant plane. The planes are
+// rebuilt per pixel in Hub75_SetPixel and read continuously by DMA.
+// Hub75_Gamma takes each 8 bit channel straight to its HUB75_COLOUR_DEPTH
+// bit linear level as it is written , so the scan itself never changes.
+//
+// Core 0 composes into the back buffer while core 1 owns the refresh and
+// swaps the buffers at a frame boundary after Hub75_Present.
+static uint8_t  Hub75_Data [ 2 ] [ HUB75_SCAN_LINES ] [ HUB75_COLOUR_DEPTH ] [ MATRIX_WIDTH ] __attribute__ ( ( aligned ( 4 ) ) );
+static uint32_t Hub75_Line [ HUB75_SCAN_LINES ] [ HUB75_COLOUR_DEPTH ];
+static uint8_t  Hub75_Gamma [ 256 ];
+
+// Reload addresses for the control channels , the data address is the front buffer
+static const uint32_t * volatile Hub75_DataAddress = ( const uint32_t * ) &Hub75_Data [ 0 ] [ 0 ] [ 0 ] [ 0 ];
+static const uint32_t *          Hub75_LineAddress = &Hub75_Line [ 0 ] [ 0 ];
+
+static volatile uint     Hub75_Back       = 1;  // Buffer composed by core 0
+static volatile uint8_t  Hub75_Brightness = HUB75_BRIGHTNESS;
+static          uint32_t Hub75_Dwell      = 0;  // Least significant plane dwell in clk_sys cycles
+static          uint8_t  Hub75_LineLevel  = 0;  // Brightness in Hub75_Line
+static          uint32_t Hub75_Cycles     = 0;  // Hal_Cycles at the last frame boundary
+static volatile uint32_t Hub75_DirtyLines = 0;  // Scan lines changed in the presented buffer
+static          uint     Hub75_DMA_Data   = 0;
+static volatile uint8_t  Hub75_SwapState  = HUB75_SWAP_IDLE;
+
+volatile uint32_t Hub75_FrameCount = 0;         // Frames refreshed , the animation timebase
+volatile Jitter_t Hub75_Jitter;                 // Core 1 frame period
+volatile uint32_t Hub75_ShownTime = 0;          // time_us_32 when the last presented buffer was first scanned
+
+static void     Hub75_Core1        ( void );
+static void     Hub75_FrameISR     ( void );
+static void     Hub75_Lines        ( void );
+static uint32_t Hub75_PackAddress  ( uint16_t pixel );
+static void     Hub75_PinMasks     ( uint row , uint8_t *red , uint8_t *green , uint8_t *blue );
+static void     Hub75_StartChannel ( uint channel , uint control , const uint32_t **address , volatile uint32_t *fifo , uint dreq , uint count );
+
+void Hub75_Init ( void )
+{
+    uint Counter_Level = 0;
+
+    for ( Counter_Level = 0 ; Counter_Level < 256 ; Counter_Level++ )
+    {
+        Hub75_Gamma [ Counter_Level ] = ( uint8_t ) GAMMA_LEVEL ( Counter_Level , ( 1u << HUB75_COLOUR_DEPTH ) - 1 );
+    }
+
+    multicore_launch_core1 ( Hub75_Core1 );
+}
+
+// Back buffer may be written once the previous Hub75_Present has completed
+bool Hub75_IsReady ( void )
+{
+    return ( HUB75_SWAP_IDLE == Hub75_SwapState );
+}
+
+// Hand the back buffer to core 1 , shown from the next frame boundary.
+// Only the scan lines holding dirty rows are carried over to the new back buffer.
+void Hub75_Present ( uint32_t dirty_rows )
+{
+    uint32_t Lines       = 0;
+    uint     Counter_Row = 0;
+
+    if ( ( HUB75_SWAP_IDLE == Hub75_SwapState ) && ( 0 != dirty_rows ) )
+    {
+        for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+        {
+            Lines |= ( ( dirty_rows >> Counter_Row ) & 1 ) << ( Counter_Row % HUB75_SCAN_LINES );
+        }
+
+        Hub75_DirtyLines = Lines;
+        __dmb ( );
+        Hub75_SwapState  = HUB75_SWAP_REQUESTED;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Panel brightness , 0 to 255 , taken up by core 1 at the next frame boundary
+void Hub75_SetBrightness ( uint8_t level )
+{
+    Hub75_Brightness = level;
+}
+
+// Core 1 : set up the refresh engine and service frame boundaries
+static void Hub75_Core1 ( void )
+{
+    uint     Offset_Data   = 0;
+    uint     Offset_Row    = 0;
+    uint     SM_Data       = 0;
+    uint     SM_Row        = 0;
+
+    Jitter_Reset    ( &Hub75_Jitter );
+    Hal_CyclesStart ( );
+
+    // The planes share the original per row dwell , so refresh rate only drops by one shift per extra bit
+    Hub75_Dwell = ( uint32_t ) ( MATRIX_DELAY_REFRESH * ( clock_get_hz ( clk_sys ) / 1000000 ) ) / ( ( 1u << HUB75_COLOUR_DEPTH ) - 1 );
+
+    Offset_Row  = pio_add_program ( HUB75_PIO , &hub75_row_program  );
+    Offset_Data = pio_add_program ( HUB75_PIO , &hub75_data_program );
+    SM_Row      = ( uint ) pio_claim_unused_sm ( HUB75_PIO , true );
+    SM_Data     = ( uint ) pio_claim_unused_sm ( HUB75_PIO , true );
+
+    // Hand the panel pins over to the PIO , output off
+    pio_gpio_init ( HUB75_PIO , BIT_A_PIN      );
+    pio_gpio_init ( HUB75_PIO , BIT_B_PIN      );
+    pio_gpio_init ( HUB75_PIO , BIT_C_PIN      );
+    pio_gpio_init ( HUB75_PIO , BIT_D_PIN      );
+    pio_gpio_init ( HUB75_PIO , LED_B1_PIN     );
+    pio_gpio_init ( HUB75_PIO , LED_B2_PIN     );
+    pio_gpio_init ( HUB75_PIO , LED_G1_PIN     );
+    pio_gpio_init ( HUB75_PIO , LED_G2_PIN     );
+    pio_gpio_init ( HUB75_PIO , LED_R1_PIN     );
+    pio_gpio_init ( HUB75_PIO , LED_R2_PIN     );
+    pio_gpio_init ( HUB75_PIO , MATRIX_CLK_PIN );
+    pio_gpio_init ( HUB75_PIO , MATRIX_LAT_PIN );
+    pio_gpio_init ( HUB75_PIO , MATRIX_OE_PIN  );
+
+    pio_sm_set_pins_with_mask    ( HUB75_PIO , SM_Row  , HUB75_OE_MASK , HUB75_OE_MASK | HUB75_ADDRESS_MASK );
+    pio_sm_set_pindirs_with_mask ( HUB75_PIO , SM_Row  , HUB75_OE_MASK | HUB75_ADDRESS_MASK , HUB75_OE_MASK | HUB75_ADDRESS_MASK );
+    pio_sm_set_pins_with_mask    ( HUB75_PIO , SM_Data , 0 , HUB75_LAT_MASK | HUB75_CLK_MASK | HUB75_RGB_MASK );
+    pio_sm_set_pindirs_with_mask ( HUB75_PIO , SM_Data , HUB75_LAT_MASK | HUB75_CLK_MASK | HUB75_RGB_MASK , HUB75_LAT_MASK | HUB75_CLK_MASK | HUB75_RGB_MASK );
+
+    hub75_row_program_init  ( HUB75_PIO , SM_Row  , Offset_Row  , HUB75_ADDRESS_BASE_PIN , MATRIX_OE_PIN );
+    hub75_data_program_init ( HUB75_PIO , SM_Data , Offset_Data , HUB75_RGB_BASE_PIN , MATRIX_LAT_PIN , MATRIX_CLK_PIN , HUB75_CLK_DIV , MATRIX_WIDTH );
+
+    // Colour data starts blank
+    Hub75_Lines ( );
+
+    // Each data channel is re-triggered by its control channel at the end of a frame
+    Hub75_DMA_Data = ( uint ) dma_claim_unused_channel ( true );
+    Hub75_StartChannel ( ( uint ) dma_claim_unused_channel ( true ) , ( uint ) dma_claim_unused_channel ( true ) , &Hub75_LineAddress , &HUB75_PIO->txf [ SM_Row  ] , pio_get_dreq ( HUB75_PIO , SM_Row  , true ) , HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH );
+    Hub75_StartChannel ( Hub75_DMA_Data , ( uint ) dma_claim_unused_channel ( true ) , ( const uint32_t ** ) &Hub75_DataAddress , &HUB75_PIO->txf [ SM_Data ] , pio_get_dreq ( HUB75_PIO , SM_Data , true ) , HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH * HUB75_WORDS_PER_LINE );
+
+    // Frame boundary interrupt , taken on this core
+    dma_channel_set_irq1_enabled ( Hub75_DMA_Data , true );
+    irq_set_exclusive_handler    ( DMA_IRQ_1 , Hub75_FrameISR );
+    irq_set_enabled              ( DMA_IRQ_1 , true );
+
+    pio_enable_sm_mask_in_sync ( HUB75_PIO , ( 1u << SM_Row ) | ( 1u << SM_Data ) );
+
+    for ( ; ; )
+    {
+        __wfi ( );
+    }
+}
+
+// End of a frame , the control channel has already started the next one
+// from Hub75_DataAddress. A new front buffer written here is picked up one
+// frame later and the old one is free once that frame has ended.
+static void Hub75_FrameISR ( void )
+{
+    uint32_t Start        = Hal_Cycles ( );
+    uint     Counter_Line = 0;
+
+    dma_channel_acknowledge_irq1 ( Hub75_DMA_Data );
+    Jitter_Sample ( &Hub75_Jitter , time_us_32 ( ) );
+    Hub75_FrameCount++;
+
+    if ( 1 < Hub75_Jitter.Count )
+    {
+        Bench_Add ( BENCH_STAGE_FRAME , ( Start - Hub75_Cycles ) & HAL_CYCLES_MASK );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Hub75_Cycles = Start;
+
+    if ( Hub75_Brightness != Hub75_LineLevel )
+    {
+        Hub75_Lines ( );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    switch ( Hub75_SwapState )
+    {
+        case HUB75_SWAP_REQUESTED:
+            Hub75_DataAddress = ( const uint32_t * ) &Hub75_Data [ Hub75_Back ] [ 0 ] [ 0 ] [ 0 ];
+            Hub75_SwapState   = HUB75_SWAP_LATCHED;
+        break;
+
+        case HUB75_SWAP_LATCHED:
+            Hub75_ShownTime   = time_us_32 ( );
+            Hub75_SwapState   = HUB75_SWAP_SHOWN;
+        break;
+
+        case HUB75_SWAP_SHOWN:
+            // Old front buffer is idle , bring it up to date so core 0 only has to apply changes
+            for ( Counter_Line = 0 ; Counter_Line < HUB75_SCAN_LINES ; Counter_Line++ )
+            {
+                if ( ( Hub75_DirtyLines >> Counter_Line ) & 1 )
+                {
+                    memcpy ( Hub75_Data [ Hub75_Back ^ 1 ] [ Counter_Line ] , Hub75_Data [ Hub75_Back ] [ Counter_Line ] , sizeof ( Hub75_Data [ 0 ] [ 0 ] ) );
+                }
+                else
+                {
+                    // Nothing to do
+                }
+            }
+
+            Hub75_Back     ^= 1;
+            __dmb ( );
+            Hub75_SwapState = HUB75_SWAP_IDLE;
+        break;
+
+        default:
+        break;
+    }
+
+    Bench_Stop ( BENCH_STAGE_SWAP , Start );
+}
+
+// Colour as stored after gamma correction , each channel holding HUB75_COLOUR_DEPTH significant bits
+uint32_t Hub75_GetPixel ( uint row , uint column )
+{
+    uint32_t Colour        = 0;
+    uint8_t  Blue          = 0;
+    uint8_t  Green         = 0;
+    uint8_t  Red           = 0;
+    uint8_t  Pixel         = 0;
+    uint     Counter_Plane = 0;
+    uint     Shift         = 0;
+
+    if ( ( row < MATRIX_HEIGHT ) && ( column < MATRIX_WIDTH ) )
+    {
+        Hub75_PinMasks ( row , &Red , &Green , &Blue );
+
+        for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+        {
+            Shift = 8 - HUB75_COLOUR_DEPTH + Counter_Plane;
+            Pixel = Hub75_Data [ Hub75_Back ] [ row % HUB75_SCAN_LINES ] [ Counter_Plane ] [ column ];
+
+            Colour |= ( Pixel & Red   ) ? ( 1u << ( 16 + Shift ) ) : 0;
+            Colour |= ( Pixel & Green ) ? ( 1u << (  8 + Shift ) ) : 0;
+            Colour |= ( Pixel & Blue  ) ? ( 1u <<        Shift   ) : 0;
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Colour;
+}
+
+void Hub75_SetPixel ( uint row , uint column , uint32_t colour )
+{
+    uint8_t *Column        = NULL;
+    uint8_t  Blue          = 0;
+    uint8_t  Green         = 0;
+    uint8_t  Red           = 0;
+    uint     Counter_Plane = 0;
+
+    if ( ( row < MATRIX_HEIGHT ) && ( column < MATRIX_WIDTH ) )
+    {
+        Hub75_PinMasks ( row , &Red , &Green , &Blue );
+
+        // Plane n takes bit n of each corrected channel
+        for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+        {
+            Column = &Hub75_Data [ Hub75_Back ] [ row % HUB75_SCAN_LINES ] [ Counter_Plane ] [ column ];
+
+            *Column = ( *Column & ( uint8_t ) ~( Red | Green | Blue ) )
+                    | ( ( ( Hub75_Gamma [ ( colour >> 16 ) & 0xFF ] >> Counter_Plane ) & 1 ) ? Red   : 0 )
+                    | ( ( ( Hub75_Gamma [ ( colour >>  8 ) & 0xFF ] >> Counter_Plane ) & 1 ) ? Green : 0 )
+                    | ( ( ( Hub75_Gamma [   colour         & 0xFF ] >> Counter_Plane ) & 1 ) ? Blue  : 0 );
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Text kernel : words of four columns on one row from a multiple of four ,
+// each byte lane 0xFF for colour and 0x00 for black. Every plane is a masked
+// word copy , the mask keeping the other half of the panel sharing the line.
+void Hub75_Blit ( uint row , uint column , const uint32_t *lanes , uint words , uint32_t colour )
+{
+    uint32_t *Line          = NULL;
+    uint32_t  Level         = 0;
+    uint32_t  Pins          = 0;
+    uint32_t  Value         = 0;
+    uint8_t   Blue          = 0;
+    uint8_t   Green         = 0;
+    uint8_t   Red           = 0;
+    uint      Counter_Plane = 0;
+    uint      Counter_Word  = 0;
+
+    if ( ( row < MATRIX_HEIGHT ) && ( column < MATRIX_WIDTH ) && ( 0 == ( column & 3 ) ) )
+    {
+        words = ( words < ( ( MATRIX_WIDTH - column ) >> 2 ) ) ? words : ( ( MATRIX_WIDTH - column ) >> 2 );
+        Level = ( ( uint32_t ) Hub75_Gamma [ ( colour >> 16 ) & 0xFF ] << 16 ) | ( ( uint32_t ) Hub75_Gamma [ ( colour >> 8 ) & 0xFF ] << 8 ) | Hub75_Gamma [ colour & 0xFF ];
+
+        Hub75_PinMasks ( row , &Red , &Green , &Blue );
+        Pins = ( uint32_t ) ( Red | Green | Blue ) * 0x01010101u;
+
+        for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+        {
+            Line  = ( uint32_t * ) &Hub75_Data [ Hub75_Back ] [ row % HUB75_SCAN_LINES ] [ Counter_Plane ] [ column ];
+            Value = ( ( ( Level >> ( 16 + Counter_Plane ) ) & 1 ) ? Red   : 0 )
+                  | ( ( ( Level >> (  8 + Counter_Plane ) ) & 1 ) ? Green : 0 )
+                  | ( ( ( Level >>        Counter_Plane   ) & 1 ) ? Blue  : 0 );
+            Value *= 0x01010101u;
+
+            for ( Counter_Word = 0 ; Counter_Word < words ; Counter_Word++ )
+            {
+                Line [ Counter_Word ] = ( Line [ Counter_Word ] & ~Pins ) | ( Value & lanes [ Counter_Word ] );
+            }
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Tile kernel : each covered line / plane is updated with whole word
+// read-modify-writes , four columns at a time
+void Hub75_FillRect ( uint row , uint column , uint width , uint height , uint32_t colour )
+{
+    uint32_t *Line          = NULL;
+    uint32_t  Level         = 0;
+    uint32_t  Mask          = 0;
+    uint32_t  Value         = 0;
+    uint8_t   Blue          = 0;
+    uint8_t   Green         = 0;
+    uint8_t   Red           = 0;
+    uint      Counter_Plane = 0;
+    uint      Counter_Row   = 0;
+    uint      Counter_Word  = 0;
+    uint      End           = 0;
+    uint      First         = 0;
+    uint      Last          = 0;
+
+    End   = ( ( column + width ) < MATRIX_WIDTH ) ? ( column + width ) : MATRIX_WIDTH;
+    Level = ( ( uint32_t ) Hub75_Gamma [ ( colour >> 16 ) & 0xFF ] << 16 ) | ( ( uint32_t ) Hub75_Gamma [ ( colour >> 8 ) & 0xFF ] << 8 ) | Hub75_Gamma [ colour & 0xFF ];
+
+    for ( Counter_Row = row ; ( Counter_Row < ( row + height ) ) && ( Counter_Row < MATRIX_HEIGHT ) && ( column < End ) ; Counter_Row++ )
+    {
+        Hub75_PinMasks ( Counter_Row , &Red , &Green , &Blue );
+
+        for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+        {
+            Line  = ( uint32_t * ) Hub75_Data [ Hub75_Back ] [ Counter_Row % HUB75_SCAN_LINES ] [ Counter_Plane ];
+            Value = ( ( ( Level >> ( 16 + Counter_Plane ) ) & 1 ) ? Red   : 0 )
+                  | ( ( ( Level >> (  8 + Counter_Plane ) ) & 1 ) ? Green : 0 )
+                  | ( ( ( Level >>        Counter_Plane   ) & 1 ) ? Blue  : 0 );
+            Value *= 0x01010101u;
+
+            for ( Counter_Word = column >> 2 ; Counter_Word <= ( ( End - 1 ) >> 2 ) ; Counter_Word++ )
+            {
+                First = ( column > ( Counter_Word << 2 ) ) ? ( column & 3 ) : 0;
+                Last  = ( End < ( ( Counter_Word + 1 ) << 2 ) ) ? ( End & 3 ) : 4;
+                Mask  = ( ( 4 == Last ) ? 0xFFFFFFFFu : ( ( 1u << ( Last << 3 ) ) - 1 ) ) & ~( ( 1u << ( First << 3 ) ) - 1 );
+                Mask &= ( uint32_t ) ( Red | Green | Blue ) * 0x01010101u;
+
+                Line [ Counter_Word ] = ( Line [ Counter_Word ] & ~Mask ) | ( Value & Mask );
+            }
+        }
+    }
+}
+
+void Hub75_Timing ( Hub75_Timing_t *timing )
+{
+    uint Counter_Plane = 0;
+    uint Counter_Line  = 0;
+
+    timing->Dwell = 0;
+    timing->Latch = HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH * ( ( uint32_t ) ( HUB75_LATCH_CYCLES * HUB75_CLK_DIV ) + HUB75_ROW_CYCLES );
+    timing->Shift = HUB75_SCAN_LINES * HUB75_COLOUR_DEPTH * ( uint32_t ) ( HUB75_SHIFT_CYCLES * HUB75_CLK_DIV );
+
+    // The off loop runs once more than the count it is given
+    for ( Counter_Line = 0 ; Counter_Line < HUB75_SCAN_LINES ; Counter_Line++ )
+    {
+        for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+        {
+            timing->Dwell += ( ( ( Hub75_Line [ Counter_Line ] [ Counter_Plane ] >> 6 ) & ( HUB75_DWELL_FIELD - 1 ) ) + ( Hub75_Line [ Counter_Line ] [ Counter_Plane ] >> 19 ) + 1 ) * HUB75_DWELL_UNIT;
+        }
+    }
+}
+
+// Line words for Hub75_Brightness. Each plane keeps its full weighted dwell
+// and the brightness only moves the split between output on and off. The
+// off part is at least one HUB75_DWELL_UNIT , the on part may be none so
+// brightness 0 blanks the panel.
+static void Hub75_Lines ( void )
+{
+    uint32_t Level         = 0;
+    uint32_t Off           = 0;
+    uint32_t On            = 0;
+    uint32_t Units         = 0;
+    uint     Counter_Line  = 0;
+    uint     Counter_Plane = 0;
+
+    Hub75_LineLevel = Hub75_Brightness;
+    Level           = Gamma_Table [ Hub75_LineLevel ];
+
+    for ( Counter_Plane = 0 ; Counter_Plane < HUB75_COLOUR_DEPTH ; Counter_Plane++ )
+    {
+        Units = ( Hub75_Dwell << Counter_Plane ) / HUB75_DWELL_UNIT;
+        Units = ( Units < 2 ) ? 2 : ( ( Units > HUB75_DWELL_FIELD ) ? HUB75_DWELL_FIELD : Units );
+        On    = ( Units * Level ) / GAMMA_FULL;
+        On    = ( On > ( Units - 1 ) ) ? ( Units - 1 ) : On;
+        Off   = Units - On;
+
+        for ( Counter_Line = 0 ; Counter_Line < HUB75_SCAN_LINES ; Counter_Line++ )
+        {
+            Hub75_Line [ Counter_Line ] [ Counter_Plane ] = ( ( Off - 1 ) << 19 ) | ( On << 6 ) | Hub75_PackAddress ( MatrixRow [ Counter_Line ] );
+        }
+    }
+}
+
+// MatrixRow address bits to hub75_row pin order
+static uint32_t Hub75_PackAddress ( uint16_t pixel )
+{
+    return ( ( pixel & BIT_A_MASK ) ? ( 1u << ( BIT_A_PIN - HUB75_ADDRESS_BASE_PIN ) ) : 0 )
+         | ( ( pixel & BIT_B_MASK ) ? ( 1u << ( BIT_B_PIN - HUB75_ADDRESS_BASE_PIN ) ) : 0 )
+         | ( ( pixel & BIT_C_MASK ) ? ( 1u << ( BIT_C_PIN - HUB75_ADDRESS_BASE_PIN ) ) : 0 )
+         | ( ( pixel & BIT_D_MASK ) ? ( 1u << ( BIT_D_PIN - HUB75_ADDRESS_BASE_PIN ) ) : 0 );
+}
+
+// Top half rows drive R1 G1 B1 , bottom half rows R2 G2 B2
+static void Hub75_PinMasks ( uint row , uint8_t *red , uint8_t *green , uint8_t *blue )
+{
+    if ( row < HUB75_SCAN_LINES )
+    {
+        *blue  = 1u << ( LED_B1_PIN - HUB75_RGB_BASE_PIN );
+        *green = 1u << ( LED_G1_PIN - HUB75_RGB_BASE_PIN );
+        *red   = 1u << ( LED_R1_PIN - HUB75_RGB_BASE_PIN );
+    }
+    else
+    {
+        *blue  = 1u << ( LED_B2_PIN - HUB75_RGB_BASE_PIN );
+        *green = 1u << ( LED_G2_PIN - HUB75_RGB_BASE_PIN );
+        *red   = 1u << ( LED_R2_PIN - HUB75_RGB_BASE_PIN );
+    }
+}
+
+static void Hub75_StartChannel ( uint channel , uint control , const uint32_t **address , volatile uint32_t *fifo , uint dreq , uint count )
+{
+    dma_channel_config Config_Channel = dma_channel_get_default_config ( channel );
+    dma_channel_config Config_Control = dma_channel_get_default_config ( control );
+
+    channel_config_set_transfer_data_size ( &Config_Channel , DMA_SIZE_32 );
+    channel_config_set_read_increment     ( &Config_Channel , true        );
+    channel_config_set_write_increment    ( &Config_Channel , false       );
+    channel_config_set_dreq               ( &Config_Channel , dreq        );
+    channel_config_set_chain_to           ( &Config_Channel , control     );
+    dma_channel_configure ( channel , &Config_Channel , fifo , *address , count , false );
+
+    channel_config_set_transfer_data_size ( &Config_Control , DMA_SIZE_32 );
+    channel_config_set_read_increment     ( &Config_Control , false       );
+    channel_config_set_write_increment    ( &Config_Control , false       );
+    dma_channel_configure ( control , &Config_Control , &dma_hw->ch [ channel ].al3_read_addr_trig , address , 1 , true );
+}
+
+/*** end of file ***/
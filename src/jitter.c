@@ -0,0 +1,55 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           jitter.c                                              *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <jitter.h>
+
+void Jitter_Reset ( volatile Jitter_t *jitter )
+{
+    jitter->Count  = 0;
+    jitter->Last   = 0;
+    jitter->Max    = 0;
+    jitter->Min    = UINT32_MAX;
+    jitter->Period = 0;
+}
+
+// The first call after a reset only records the timestamp
+void Jitter_Sample ( volatile Jitter_t *jitter , uint32_t now )
+{
+    uint32_t Period = now - jitter->Last;
+
+    if ( 0 != jitter->Count )
+    {
+        jitter->Period = Period;
+        jitter->Max    = ( Period > jitter->Max ) ? Period : jitter->Max;
+        jitter->Min    = ( Period < jitter->Min ) ? Period : jitter->Min;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    jitter->Count++;
+    jitter->Last = now;
+}
+
+// Peak to peak period variation
+uint32_t Jitter_Spread ( const volatile Jitter_t *jitter )
+{
+    return ( 1 < jitter->Count ) ? ( jitter->Max - jitter->Min ) : 0;
+}
+
+/*** end of file ***/
@@ -0,0 +1,233 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           link.c                                                *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <link.h>
+#include <spi_link.h>
+
+#include <string.h>
+
+// Clock steps tried by Link_Train , the first is the original SPI_BAUD_RATE
+static const uint32_t LinkBaud [ ] = {
+    SPI_BAUD_RATE * 1000,
+      250000,
+      500000,
+     1000000,
+     2000000,
+     4000000,
+     8000000,
+};
+
+// Run time monitor , one per test bed
+typedef struct
+{
+    uint8_t Retries;                // Consecutive retries of the current request
+    uint8_t Window_Errors;
+    uint8_t Window_Transactions;
+} Link_Monitor_t;
+
+static Link_Monitor_t Link_Monitor [ TESTBED_COUNT ];
+static uint8_t        Link_Bed     = 0;     // Selected by Link_Select
+static uint8_t        Link_OnBus   = 0xFF;  // Test bed whose clock SPI_SetBaud last set
+static uint8_t        Link_OnStep  = 0xFF;
+
+volatile Link_Stats_t Link_Stats [ TESTBED_COUNT ];
+
+static void Link_Pattern ( uint8_t sequence , uint8_t *payload );
+static void Link_SetStep ( uint8_t step );
+
+// Put the selected test bed's clock on the bus , only between transactions
+void Link_Apply ( void )
+{
+    if ( ( Link_Bed != Link_OnBus ) || ( Link_Stats [ Link_Bed ].Step != Link_OnStep ) )
+    {
+        Link_SetStep ( Link_Stats [ Link_Bed ].Step );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// One blocking transaction , used before the main loop starts
+bool Link_Exchange ( uint8_t opcode , const uint8_t *payload , uint8_t length , uint8_t *rx , Protocol_Frame_t *frame )
+{
+    uint8_t Tx [ PROTOCOL_FRAME_LENGTH ];
+    uint8_t Length = Protocol_Request ( opcode , payload , length , Tx );
+    uint8_t Status = SPI_STATUS_BUSY;
+
+    memset ( rx , 0 , PROTOCOL_FRAME_LENGTH );
+    SPI_Submit ( Tx , rx , Length , SPI_TIMEOUT , NULL );
+
+    while ( SPI_STATUS_BUSY == Status )
+    {
+        Status = SPI_Poll ( );
+    }
+
+    return ( SPI_STATUS_DONE == Status ) && Protocol_Receive ( rx , Length , frame );
+}
+
+// Step the clock up while echo replies come back intact , then settle
+// LINK_MARGIN steps below the fastest clean rate. A test bed that does not
+// answer in protocol v2 is left at the original clock. Trains the bed
+// selected with Link_Select , its chip select already on the bus.
+void Link_Train ( void )
+{
+    Protocol_Frame_t Frame;
+    uint8_t          Payload [ 8 ];
+    uint8_t          Rx [ PROTOCOL_FRAME_LENGTH ];
+    uint8_t          Counter_Exchange = 0;
+    uint8_t          Step             = 0;
+    uint8_t          Good             = 0;
+    bool             Clean            = true;
+
+    memset ( ( void * ) &Link_Stats [ Link_Bed ] , 0 , sizeof ( Link_Stats [ Link_Bed ] ) );
+
+    for ( Step = 0 ; ( Step < count_of ( LinkBaud ) ) && Clean && !Protocol_Legacy ( Link_Bed ) ; Step++ )
+    {
+        Link_SetStep ( Step );
+
+        // The first reply at a new rate answers the last request at the old one
+        Link_Pattern ( 0 , Payload );
+        Link_Exchange ( PROTOCOL_OP_ECHO , Payload , sizeof ( Payload ) , Rx , &Frame );
+
+        for ( Counter_Exchange = 0 ; ( Counter_Exchange < LINK_TRAIN_EXCHANGES ) && Clean ; Counter_Exchange++ )
+        {
+            Hal_WatchdogFeed ( );
+
+            Link_Pattern ( Counter_Exchange + 1 , Payload );
+            Clean = Link_Exchange ( PROTOCOL_OP_ECHO , Payload , sizeof ( Payload ) , Rx , &Frame );
+
+            // Each echo carries its own counter , so replies are checked against what was sent
+            if ( Clean )
+            {
+                Link_Pattern ( Frame.Payload [ 0 ] , Payload );
+                Clean = ( PROTOCOL_OP_ECHO == Frame.Opcode ) && ( sizeof ( Payload ) == Frame.Length ) && ( 0 == memcmp ( Frame.Payload , Payload , sizeof ( Payload ) ) );
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+
+        if ( Clean )
+        {
+            Good = Step;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    Link_Stats [ Link_Bed ].StepTrained = Good;
+    Link_SetStep ( ( Good > LINK_MARGIN ) ? ( Good - LINK_MARGIN ) : 0 );
+
+    // Drain the last echo at the settled rate
+    Link_Pattern ( 0 , Payload );
+    Link_Exchange ( PROTOCOL_OP_ECHO , Payload , sizeof ( Payload ) , Rx , &Frame );
+}
+
+// Run time link quality , called once per completed or failed transaction
+// of the selected test bed. A step down takes effect at its next
+// Link_Apply , another bed's transaction may be on the bus.
+// Returns true if the failed request should be repeated straight away.
+bool Link_Update ( bool ok )
+{
+    volatile Link_Stats_t *Stats   = &Link_Stats [ Link_Bed ];
+    Link_Monitor_t        *Monitor = &Link_Monitor [ Link_Bed ];
+    bool                   Retry   = false;
+
+    if ( !Protocol_Legacy ( Link_Bed ) )
+    {
+        Stats->Transactions++;
+        Monitor->Window_Transactions++;
+
+        if ( ok )
+        {
+            Monitor->Retries = 0;
+        }
+        else
+        {
+            Stats->Errors++;
+            Monitor->Window_Errors++;
+
+            Retry = ( Monitor->Retries < LINK_RETRIES );
+
+            if ( Retry )
+            {
+                Monitor->Retries++;
+                Stats->Retries++;
+            }
+            else
+            {
+                Monitor->Retries = 0;
+            }
+        }
+
+        if ( ( Monitor->Window_Errors >= LINK_MONITOR_ERRORS ) && ( 0 != Stats->Step ) )
+        {
+            Stats->Step--;
+            Stats->StepDowns++;
+            Monitor->Window_Errors       = 0;
+            Monitor->Window_Transactions = 0;
+        }
+        else if ( Monitor->Window_Transactions >= LINK_MONITOR_WINDOW )
+        {
+            Monitor->Window_Errors       = 0;
+            Monitor->Window_Transactions = 0;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Retry;
+}
+
+// Alternating and walking bit patterns , byte 0 identifies the exchange
+static void Link_Pattern ( uint8_t sequence , uint8_t *payload )
+{
+    payload [ 0 ] = sequence;
+    payload [ 1 ] = ( uint8_t ) ~sequence;
+    payload [ 2 ] = 0x55;
+    payload [ 3 ] = 0xAA;
+    payload [ 4 ] = 0x00;
+    payload [ 5 ] = 0xFF;
+    payload [ 6 ] = ( uint8_t ) ( 1u << ( sequence & 7 ) );
+    payload [ 7 ] = ( uint8_t ) ~( 1u << ( sequence & 7 ) );
+}
+
+// Test bed the following link calls belong to , along with Protocol_Select
+void Link_Select ( uint8_t bed )
+{
+    Link_Bed = ( bed < TESTBED_COUNT ) ? bed : 0;
+}
+
+static void Link_SetStep ( uint8_t step )
+{
+    Link_Stats [ Link_Bed ].Step = step;
+    Link_Stats [ Link_Bed ].Baud = SPI_SetBaud ( LinkBaud [ step ] );
+    Link_OnBus                   = Link_Bed;
+    Link_OnStep                  = step;
+}
+
+/*** end of file ***/
@@ -16,146 +16,115 @@
 */
 
 #include <main.h>
-#include <matrix_default.h>
+#include <batch.h>
+#include <beds.h>
+#include <bench.h>
+#include <buttons.h>
+#include <hub75.h>
+#include <link.h>
+#include <matrix.h>
+#include <protocol.h>
+#include <ready.h>
+#include <readings.h>
+#include <scheduler.h>
+#include <spi_link.h>
+#include <telemetry.h>
+#include <text.h>
 
 #include <string.h>
-#include <hardware/spi.h>
-#include <hardware/watchdog.h>
-#include <pico/binary_info.h>
-
-// LED Matrix
-#define MATRIX_HEIGHT   32
-#define MATRIX_WIDTH    32
-const uint64_t MATRIX_DELAY_REFRESH = 450;  // microseconds
-uint16_t MatrixData [ MATRIX_HEIGHT ] [ MATRIX_WIDTH ];
-
-// SPI
-uint8_t SPI_RxBuffer [ 11 ] = { 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 };
-const    uint16_t SPI_RX_PERIOD = 500;  // Minimum delay ( ms ) between messages ( polling )
-const    uint16_t SPI_TX_PERIOD = 500;  // Minimum delay ( ms ) between messages ( button press )
-volatile uint16_t g_SPI_RxPeriod  = 0;
-volatile uint16_t g_SPI_TxPeriod  = 0;
-
-// DAC check
-const uint8_t DAC_CHECK_IS_READY    = 0x10;
-const uint8_t DAC_CHECK_RUNNING     = 0x0B;
-const uint8_t DAC_CHECK_NOT_RUNNING = 0x0F;
-const uint8_t SYNC_BYTE             = 0x55;
-
-// struct repeating_timer refresh_display;
-struct repeating_timer timer_counter;
-struct repeating_timer timer_heartbeat;
-
-static void Matrix_Draw      ( void );
-static void Matrix_SetBuffer ( uint8_t sensor , uint8_t state , uint8_t pos );
-static void Watchdog         ( void );
-
-// Timer interrupts
-static bool timer_counter_isr ( struct repeating_timer *t )
-{
-    if ( g_SPI_RxPeriod )
-    {
-        g_SPI_RxPeriod--;
-    }
-    else
-    {
-        // Nothing to do
-    }
 
-    if ( g_SPI_TxPeriod )
-    {
-        g_SPI_TxPeriod--;
-    }
-    else
-    {
-        // Nothing to do
-    }
-}
-
-static bool timer_heartbeat_isr ( struct repeating_timer *t )
-{
-    if ( gpio_get ( LED_PICO_PIN ) )
-    {
-        LED_PICO_OFF;
-    }
-    else
-    {
-        LED_PICO_ON;
-    }
-}
+// SPI , receive double buffered so one test bed's reply is decoded while
+// the next bed's transaction is on the wire
+uint8_t SPI_RxBuffer [ 2 ] [ PROTOCOL_FRAME_LENGTH ] = { { 0 } };
+uint8_t SPI_TxBuffer [ PROTOCOL_FRAME_LENGTH ]       = { 0 };
+uint8_t SPI_Length                                   = 0;
+const    uint16_t SPI_RX_PERIOD          =  500;    // Minimum delay ( ms ) between messages ( polling )
+const    uint16_t SPI_RX_PERIOD_LIVENESS = 2000;    // Polling once the test bed uses data ready
+
+const uint16_t BARS_HOLD_PERIOD = 1000;     // Longest ( ms ) bars wait for a present to ride on
+
+// Task periods ( ms )
+const uint16_t TASK_COMPOSE_PERIOD   =  10;     // Also woken by each status reply
+const uint16_t TASK_HEARTBEAT_PERIOD = 500;
+const uint16_t TASK_LINK_PERIOD      =   5;     // Also woken by SPI , button and data ready events
+const uint16_t TASK_READINGS_PERIOD  = 100;     // Live readings , changes only
+const uint16_t TASK_TELEMETRY_PERIOD = 100;
+const uint16_t TASK_WATCHDOG_PERIOD  = 100;
+
+#ifdef BENCH
+Task_t Task_Bench;
+#endif
+Task_t Task_Compose;
+Task_t Task_Heartbeat;
+Task_t Task_Link;
+Task_t Task_Poll;
+Task_t Task_Readings;
+Task_t Task_Telemetry;
+Task_t Task_Watchdog;
+
+// Latest status of each test bed
+static uint8_t  DAC_CheckState [ TESTBED_COUNT ]                = { 0 };
+static uint8_t  LinkError      [ TESTBED_COUNT ]                = { 0 };        // TELEMETRY_ERROR_ kind since the last status , 0 for none
+static uint8_t  SensorPass     [ TESTBED_COUNT ] [ SENSOR_BYTES ] = { { 0 } };
+static uint8_t  SensorPos      [ TESTBED_COUNT ]                = { 0 };
+static bool     ReadingsDue    [ TESTBED_COUNT ]                = { false };
+static bool     ReplyHeld      [ TESTBED_COUNT ]                = { false };    // Reply to the last v2 request still waits in the test bed
+static bool     StatusDue      [ TESTBED_COUNT ]                = { false };
+static bool     StatusValid    [ TESTBED_COUNT ]                = { false };    // A status has been received
+
+// Transaction in flight
+static uint8_t  LinkBed        = TESTBED_COUNT - 1;     // Round robin starts at bed 0
+static uint8_t  LinkBuffer     = 0;                     // SPI_RxBuffer in use
+static bool     ReplyExpected  = false;                 // Clocks out a reply
+static uint32_t BarsTime       = 0;                     // Hal_Micros of the last bars
+
+#ifdef BENCH
+static void Bench      ( void );
+#endif
+static void Bed_Label  ( uint8_t bed , uint8_t pos , char *label , uint32_t *colour );
+static void Bed_Reply  ( uint8_t bed , uint8_t spi_status , const uint8_t *rx , uint8_t length , bool expected );
+static void Bed_Select ( uint8_t bed );
+static bool Bed_Start  ( uint8_t skip );
+static void Compose    ( void );
+static void Heartbeat  ( void );
+static void Link       ( void );
+static void Poll       ( void );
+static void Readings   ( void );
+static void SPI_Done   ( const uint8_t *rx , uint8_t length );
+static void Telemetry  ( void );
+static void Watchdog   ( void );
 
 int main ( void )
 {
-    uint8_t SPI_TxBuffer [ 11 ] = { 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 };
-
-    uint8_t  ButtonPress    = 0;
-    uint8_t  DAC_CheckState = 0;
-    uint8_t  SensorState    = 0;
-    uint8_t  SensorPos      = 0;
-    uint32_t SensorPass     = 0;
-
-    volatile uint8_t Counter_Columns = 0;
-    volatile uint8_t Counter_Rows    = 0;
+    uint8_t Counter_Bed = 0;
 
-    // Useful information for picotool
-    bi_decl ( bi_program_description ( "RP2040 Premier" ) );
+    // Stdio , watchdog and the wake up alarm
+    Hal_Init ( );
 
-    // Initialise standard stdio types
-    stdio_init_all ( );
-
-    // Set up watchdog
-    watchdog_enable ( WATCHDOG_MILLISECONDS , 1 );
+    // Panel output off before anything else , the shift registers hold garbage until the first line
+    Hal_GpioOutput ( MATRIX_OE_PIN  );
+    MATRIX_OUTPUT_OFF;
 
     // Initialize all configured peripherals
     // Set up GPIO
-    gpio_init    ( BIT_A_PIN      );
-    gpio_init    ( BIT_B_PIN      );
-    gpio_init    ( BIT_C_PIN      );
-    gpio_init    ( BIT_D_PIN      );
-    gpio_init    ( LED_B1_PIN     );
-    gpio_init    ( LED_B2_PIN     );
-    gpio_init    ( LED_G1_PIN     );
-    gpio_init    ( LED_G2_PIN     );
-    gpio_init    ( LED_PICO_PIN   );
-    gpio_init    ( LED_R1_PIN     );
-    gpio_init    ( LED_R2_PIN     );
-    gpio_init    ( MATRIX_CLK_PIN );
-    gpio_init    ( MATRIX_LAT_PIN );
-    gpio_init    ( MATRIX_OE_PIN  );
-    gpio_init    ( SW1            );
-    gpio_init    ( SW2            );
-    gpio_init    ( SW3            );
-    gpio_init    ( SW4            );
-    gpio_set_dir ( BIT_A_PIN      , GPIO_OUT );
-    gpio_set_dir ( BIT_B_PIN      , GPIO_OUT );
-    gpio_set_dir ( BIT_C_PIN      , GPIO_OUT );
-    gpio_set_dir ( BIT_D_PIN      , GPIO_OUT );
-    gpio_set_dir ( LED_B1_PIN     , GPIO_OUT );
-    gpio_set_dir ( LED_B2_PIN     , GPIO_OUT );
-    gpio_set_dir ( LED_G1_PIN     , GPIO_OUT );
-    gpio_set_dir ( LED_G2_PIN     , GPIO_OUT );
-    gpio_set_dir ( LED_PICO_PIN   , GPIO_OUT );
-    gpio_set_dir ( LED_R1_PIN     , GPIO_OUT );
-    gpio_set_dir ( LED_R2_PIN     , GPIO_OUT );
-    gpio_set_dir ( MATRIX_CLK_PIN , GPIO_OUT );
-    gpio_set_dir ( MATRIX_LAT_PIN , GPIO_OUT );
-    gpio_set_dir ( MATRIX_OE_PIN  , GPIO_OUT );
-    gpio_set_dir ( SW1            , GPIO_IN  );
-    gpio_set_dir ( SW2            , GPIO_IN  );
-    gpio_set_dir ( SW3            , GPIO_IN  );
-    gpio_set_dir ( SW4            , GPIO_IN  );
-
-    // SPI ( Master )
-    spi_init          ( SPI_MASTER   , SPI_BAUD_RATE * 1000 );
-    spi_set_slave     ( SPI_MASTER   , false                );
-    gpio_set_function ( SPI_CS_PIN   , GPIO_FUNC_SPI        );
-    gpio_set_function ( SPI_MISO_PIN , GPIO_FUNC_SPI        );
-    gpio_set_function ( SPI_MOSI_PIN , GPIO_FUNC_SPI        );
-    gpio_set_function ( SPI_SCK_PIN  , GPIO_FUNC_SPI        );
-
-    // Set up timer interrupts
-    add_repeating_timer_ms ( 500 , timer_heartbeat_isr , NULL , &timer_heartbeat );
-    add_repeating_timer_ms (   1 , timer_counter_isr   , NULL , &timer_counter   );
+    Hal_GpioOutput ( BIT_A_PIN      );
+    Hal_GpioOutput ( BIT_B_PIN      );
+    Hal_GpioOutput ( BIT_C_PIN      );
+    Hal_GpioOutput ( BIT_D_PIN      );
+    Hal_GpioInput  ( DATA_READY_PIN , false );
+    Hal_GpioOutput ( LED_B1_PIN     );
+    Hal_GpioOutput ( LED_B2_PIN     );
+    Hal_GpioOutput ( LED_G1_PIN     );
+    Hal_GpioOutput ( LED_G2_PIN     );
+    Hal_GpioOutput ( LED_PICO_PIN   );
+    Hal_GpioOutput ( LED_R1_PIN     );
+    Hal_GpioOutput ( LED_R2_PIN     );
+    Hal_GpioOutput ( MATRIX_CLK_PIN );
+    Hal_GpioOutput ( MATRIX_LAT_PIN );
+    Hal_GpioInput  ( SW1            , false );
+    Hal_GpioInput  ( SW2            , false );
+    Hal_GpioInput  ( SW3            , false );
+    Hal_GpioInput  ( SW4            , false );
 
     BIT_A_LOW;
     BIT_B_LOW;
@@ -168,865 +137,443 @@ int main ( void )
     LED_PICO_OFF;
     LED_R1_LOW;
     LED_R2_LOW;
+    MATRIX_CLK_LOW;
+    MATRIX_LAT_LOW;
+
+    // Panel refresh runs on core 1 from PIO / DMA from here on. Every line
+    // shifts a full row at the PIO clock , so the first frame clears the
+    // shift registers and the splash follows a frame later.
+    Bench_Reset    ( );
+    Hub75_Init     ( );
+    Matrix_Splash  ( );
+    Telemetry_Init ( );
 
-    // Clear any shift register data
-    for ( Counter_Rows = 0 ; Counter_Rows < 32 ; Counter_Rows++ )
+    // Test bed links , each trained on its own chip select while the splash is already up
+    SPI_Init       ( );
+
+    for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
     {
-        for ( Counter_Columns = 0 ; Counter_Columns < 32 ; Counter_Columns++ )
-        {
-            MATRIX_CLK_HIGH;
-            sleep_us ( 1 );
-            MATRIX_CLK_LOW;
-            sleep_us ( 1 );
-        }
+        Bed_Select     ( Counter_Bed );
+        SPI_Select     ( Counter_Bed );
+        Link_Train     ( );
+        Readings_Reset ( );
     }
 
-    // Load default pixel data
-    for ( Counter_Rows = 0 ; Counter_Rows < MATRIX_HEIGHT ; Counter_Rows++ )
+    Beds_Init      ( );
+    Ready_Init     ( );
+    Buttons_Init   ( );
+
+    // Everything else on core 0 runs as scheduled tasks
+    Scheduler_Init ( &Task_Link );
+    Scheduler_Add  ( &Task_Watchdog  , Watchdog  , "Watchdog"  , TASK_WATCHDOG_PERIOD  * 1000 , 0 );
+    Scheduler_Add  ( &Task_Link      , Link      , "Link"      , TASK_LINK_PERIOD      * 1000 , 0 );
+    Scheduler_Add  ( &Task_Poll      , Poll      , "Poll"      , SPI_RX_PERIOD         * 1000 , 0 );
+    Scheduler_Add  ( &Task_Readings  , Readings  , "Readings"  , TASK_READINGS_PERIOD  * 1000 , 0 );
+    Scheduler_Add  ( &Task_Compose   , Compose   , "Compose"   , TASK_COMPOSE_PERIOD   * 1000 , 0 );
+    Scheduler_Add  ( &Task_Heartbeat , Heartbeat , "Heartbeat" , TASK_HEARTBEAT_PERIOD * 1000 , 0 );
+    Scheduler_Add  ( &Task_Telemetry , Telemetry , "Telemetry" , TASK_TELEMETRY_PERIOD * 1000 , 0 );
+#ifdef BENCH
+    Scheduler_Add  ( &Task_Bench     , Bench     , "Bench"     , BENCH_REPORT_MS       * 1000 , BENCH_REPORT_MS * 1000 );
+#endif
+    Scheduler_Run  ( );
+}
+
+#ifdef BENCH
+// Benchmark report over stdio
+static void Bench ( void )
+{
+    Bench_Report ( );
+}
+#endif
+
+// Compose changed tiles and labels into the back buffer , the splash stays
+// until the first status. A test bed that has not answered , or has gone
+// quiet , shows unknown tiles rather than its last result.
+static void Compose ( void )
+{
+    uint32_t Characters  = 0;
+    uint32_t Colour      = 0;
+    uint32_t Dirty       = 0;
+    uint32_t Start       = 0;
+    uint32_t Text        = 0;
+    char     Label       [ TEXT_LENGTH + 1 ];
+    uint8_t  Pos         [ TESTBED_COUNT ];
+    uint8_t  Counter_Bed = 0;
+    bool     Valid       = false;
+
+    for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
     {
-        for ( Counter_Columns = 0 ; Counter_Columns < MATRIX_WIDTH ; Counter_Columns++ )
-        {
-            if ( Counter_Rows < 16 )
-            {
-                MatrixData [ Counter_Rows ] [ Counter_Columns ] = MatrixRow [ Counter_Rows ];// + 0b0000000000010000;
-            }
-            else
-            {
-                MatrixData [ Counter_Rows ] [ Counter_Columns ] = MatrixRow [ Counter_Rows ];// + 0b0000000010000000;
-            }
-        }
+        Valid               = Valid || StatusValid [ Counter_Bed ];
+        Pos [ Counter_Bed ] = ( StatusValid [ Counter_Bed ] && !Beds_Stale ( Counter_Bed ) ) ? SensorPos [ Counter_Bed ] : MATRIX_POS_UNKNOWN;
     }
-    
-    MATRIX_CLK_LOW;
-    MATRIX_LAT_LOW;
-    MATRIX_OUTPUT_OFF;
 
-    // Infinite loop
-    for ( ; ; )
+    if ( Hub75_IsReady ( ) )
     {
-        Watchdog ( );
-
-        // Get button presses
-        ButtonPress = ( ( gpio_get ( SW4 ) ) << 3 ) + ( ( gpio_get ( SW3 ) ) << 2 ) + ( ( gpio_get ( SW2 ) ) << 1 ) + gpio_get ( SW1 );
+        Telemetry_Boot ( TELEMETRY_BOOT_FRAME , Hub75_ShownTime );     // Only the first , the splash , is kept
+    }
+    else
+    {
+        // Nothing to do
+    }
 
-        if ( !g_SPI_TxPeriod && ( 0 != ButtonPress ) )  // Send command to test bed
-        {
-            memset ( SPI_RxBuffer , 0 , sizeof ( SPI_RxBuffer ) );
+    if ( Hub75_IsReady ( ) && Valid )
+    {
+        Ready_Shown    ( Hub75_ShownTime );
 
-            SPI_TxBuffer [ 0 ] = SYNC_BYTE;
-            SPI_TxBuffer [ 1 ] = ButtonPress;
+        Start = Hal_Cycles ( );
+        Dirty = Matrix_Compose ( &SensorPass [ 0 ] [ 0 ] , Pos );
 
-            spi_write_blocking ( SPI_MASTER , SPI_TxBuffer , 2 );
+        Characters = Text_Stats.Characters;
+        Text       = Hal_Cycles ( );
 
-            g_SPI_TxPeriod = SPI_TX_PERIOD;
-        }
-        else if ( !g_SPI_RxPeriod && ( 0 == ButtonPress ) ) // Poll for data
+        for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
         {
-            memset ( SPI_RxBuffer , 0 , sizeof ( SPI_RxBuffer ) );
-            memset ( SPI_TxBuffer , 0 , sizeof ( SPI_TxBuffer ) );
-
-            SPI_TxBuffer [ 0 ] = SYNC_BYTE;
-            SPI_TxBuffer [ 1 ] = DAC_CHECK_IS_READY;
-
-            spi_write_read_blocking ( SPI_MASTER , SPI_TxBuffer , SPI_RxBuffer , 11 );
-
-            g_SPI_RxPeriod = SPI_RX_PERIOD;
+            Bed_Label ( Counter_Bed , Pos [ Counter_Bed ] , Label , &Colour );
+            Dirty |= Matrix_Label ( Counter_Bed , Label , Colour );
+        }
 
-            if ( ( SYNC_BYTE == SPI_RxBuffer [ 4 ] ) && ( DAC_CHECK_IS_READY == SPI_RxBuffer [ 5 ] ) )
-            {
-                DAC_CheckState = SPI_RxBuffer [ 6 ];
-                SensorPass = ( uint32_t ) ( ( SPI_RxBuffer [ 7 ] << 16 ) + ( SPI_RxBuffer [ 8 ] << 8 ) + SPI_RxBuffer [ 9 ] );
-                SensorPos  = SPI_RxBuffer [ 10 ];
-            }
-            else
-            {
-                // Nothing to do
-            }
+        if ( Text_Stats.Characters != Characters )
+        {
+            Bench_Add ( BENCH_STAGE_TEXT , ( ( Hal_Cycles ( ) - Text ) & HAL_CYCLES_MASK ) / ( Text_Stats.Characters - Characters ) );
         }
         else
         {
             // Nothing to do
         }
 
-        for ( Counter_Columns = 0 ; Counter_Columns < 24 ; Counter_Columns++ )
+        // Bars ride on presents already due , so a status is not queued
+        // behind a swap of bars. On a still panel they go alone now and then.
+        if ( ( 0 != Dirty ) || ( !Ready_Waiting ( ) && ( ( Hal_Micros ( ) - BarsTime ) >= ( BARS_HOLD_PERIOD * 1000u ) ) ) )
         {
-            SensorState = ( SensorPass >> Counter_Columns ) & 0b00000001; 
-            Matrix_SetBuffer ( Counter_Columns , SensorState , SensorPos );
+            Dirty   |= Matrix_Bars ( Readings_Value , Readings_Changed , READINGS_FULL_SCALE );
+            BarsTime = Hal_Micros ( );
+        }
+        else
+        {
+            // Nothing to do
         }
 
-        Matrix_Draw ( );
+        Hub75_Present  ( Dirty );
+        Bench_Stop     ( BENCH_STAGE_COMPOSE , Start );
+        Ready_Composed ( Dirty );
+    }
+    else
+    {
+        // Nothing to do
     }
 }
 
-void Matrix_Draw ( void )
+static void Heartbeat ( void )
 {
-    volatile uint8_t Counter_Column = 0;
-    volatile uint8_t Counter_Row    = 0;
-
-    for ( Counter_Row = 0 ; Counter_Row < MATRIX_HEIGHT ; Counter_Row++ )
+    if ( Hal_GpioGet ( LED_PICO_PIN ) )
+    {
+        LED_PICO_OFF;
+    }
+    else
     {
-        MATRIX_OUTPUT_OFF;
-        MATRIX_LAT_HIGH;
+        LED_PICO_ON;
+    }
+}
 
-        for ( Counter_Column = 0 ; Counter_Column < MATRIX_WIDTH ; Counter_Column++ )
-        {
-            gpio_put ( LED_R1_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_RED_TOP      ) );
-            gpio_put ( LED_G1_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_GREEN_TOP    ) );
-            gpio_put ( LED_B1_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_BLUE_TOP     ) );
-            gpio_put ( LED_R2_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_RED_BOTTOM   ) );
-            gpio_put ( LED_G2_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_GREEN_BOTTOM ) );
-            gpio_put ( LED_B2_PIN , ( MatrixData [ Counter_Row ] [ Counter_Column ] & LED_BLUE_BOTTOM  ) );
-
-            gpio_put ( BIT_D_PIN  , ( MatrixData [ Counter_Row ] [ Counter_Column ] & BIT_D_MASK ) );
-            gpio_put ( BIT_C_PIN  , ( MatrixData [ Counter_Row ] [ Counter_Column ] & BIT_C_MASK ) );
-            gpio_put ( BIT_B_PIN  , ( MatrixData [ Counter_Row ] [ Counter_Column ] & BIT_B_MASK ) );
-            gpio_put ( BIT_A_PIN  , ( MatrixData [ Counter_Row ] [ Counter_Column ] & BIT_A_MASK ) );
-
-            MATRIX_CLK_HIGH;
-            sleep_us ( 1 );
-            MATRIX_CLK_LOW;
-        }
+// Collect the last transaction and start the next. With several test beds
+// the next bed's transaction is started before the reply just received is
+// decoded , so its DMA runs while this one is parsed.
+static void Link ( void )
+{
+    uint8_t SPI_Status = SPI_Poll ( );
+    uint8_t Bed        = LinkBed;
+    uint8_t Buffer     = LinkBuffer;
+    uint8_t Length     = SPI_Length;
+    bool    Expected   = ReplyExpected;
+    bool    Started    = false;
+
+    if ( ( SPI_STATUS_DONE == SPI_Status ) || ( SPI_STATUS_TIMEOUT == SPI_Status ) )
+    {
+        Started = Bed_Start ( Bed );    // Any other bed , this one's reply may change what it needs next
+        Bed_Reply ( Bed , SPI_Status , SPI_RxBuffer [ Buffer ] , Length , Expected );
+    }
+    else
+    {
+        // Nothing to do
+    }
 
-        MATRIX_LAT_LOW;
-        MATRIX_OUTPUT_ON;
-        sleep_us ( MATRIX_DELAY_REFRESH );
+    if ( ( SPI_STATUS_BUSY != SPI_Status ) && !Started )
+    {
+        Bed_Start ( TESTBED_COUNT );
+    }
+    else
+    {
+        // Transaction in progress
     }
 }
 
-void Matrix_SetBuffer ( uint8_t sensor , uint8_t state , uint8_t pos )
+// Status label of bed , pos being MATRIX_POS_UNKNOWN while it is silent or
+// stale : the DAC check state and the slot under test ( from 1 ) , the last
+// link error once it has gone quiet , dashes until it first answers
+static void Bed_Label ( uint8_t bed , uint8_t pos , char *label , uint32_t *colour )
 {
-    volatile uint8_t Counter = 0;
+    const char *State = "DAC";
 
-    switch ( sensor )
+    if ( DAC_CHECK_RUNNING == DAC_CheckState [ bed ] )
     {
-        case 0:
-            for ( Counter = 2 ; Counter < 6 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 0 != pos ) )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 0 != pos ) )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 0 == pos )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+        State = "RUN";
+    }
+    else if ( DAC_CHECK_NOT_RUNNING == DAC_CheckState [ bed ] )
+    {
+        State = "OFF";
+    }
+    else
+    {
+        // Nothing to do
+    }
 
-        case 1:
-            for ( Counter = 2 ; Counter < 6 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 1 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 1 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 1 == pos )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+    if ( pos < SENSOR_COUNT )
+    {
+        snprintf ( label , TEXT_LENGTH + 1 , "%s %u" , State , ( uint ) pos + 1 );
+        *colour = COLOUR_AMBER;
+    }
+    else if ( SENSOR_COUNT == pos )
+    {
+        snprintf ( label , TEXT_LENGTH + 1 , "%s END" , State );
+        *colour = COLOUR_AMBER;
+    }
+    else if ( MATRIX_POS_UNKNOWN != pos )     // Outside the jig
+    {
+        snprintf ( label , TEXT_LENGTH + 1 , "%s ?" , State );
+        *colour = COLOUR_RED;
+    }
+    else if ( 0 != LinkError [ bed ] )
+    {
+        snprintf ( label , TEXT_LENGTH + 1 , "ERR %u" , ( uint ) LinkError [ bed ] );
+        *colour = COLOUR_RED;
+    }
+    else
+    {
+        snprintf ( label , TEXT_LENGTH + 1 , "%s" , StatusValid [ bed ] ? "LOST" : "----" );
+        *colour = COLOUR_IDLE;
+    }
+}
 
-        case 2:
-            for ( Counter = 2 ; Counter < 6 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 2 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 2 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 2 == pos )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+// Decode a finished transaction of bed
+static void Bed_Reply ( uint8_t bed , uint8_t spi_status , const uint8_t *rx , uint8_t length , bool expected )
+{
+    Protocol_Frame_t  Frame;
+    Protocol_Status_t Status = { { 0 } , 0 , 0 , 0 , 0 };
+    bool              Legacy = false;
 
-        case 3:
-            for ( Counter = 2 ; Counter < 6 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 3 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 3 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 3 == pos )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+    Bed_Select ( bed );
 
-        case 4:
-            for ( Counter = 2 ; Counter < 6 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 4 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 4 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 4 == pos )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+    Legacy = Protocol_Legacy ( bed );
 
-        case 5:
-            for ( Counter = 2 ; Counter < 6 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 5 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 5 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 5 == pos )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+    if ( ( SPI_STATUS_DONE == spi_status ) && !expected )
+    {
+        // Nothing was due back
+    }
+    else if ( ( SPI_STATUS_DONE == spi_status ) && Protocol_Receive ( rx , length , &Frame ) )
+    {
+        Link_Update ( true );
 
-        case 6:
-            for ( Counter = 9 ; Counter < 13 ; Counter++ )
+        if ( Batch_Reply ( &Frame , &Status ) )
+        {
+            // Back from an error or from going stale , readings are tried again
+            if ( ( 0 != LinkError [ bed ] ) || Beds_Stale ( bed ) )
             {
-                if ( ( SENSOR_FAIL == state ) && ( 6 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 6 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 6 == pos )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
+                Readings_Reset ( );
             }
-        break;
-
-        case 7:
-            for ( Counter = 9 ; Counter < 13 ; Counter++ )
+            else
             {
-                if ( ( SENSOR_FAIL == state ) && ( 7 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 7 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 7 == pos )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
+                // Nothing to do
             }
-        break;
 
-        case 8:
-            for ( Counter = 9 ; Counter < 13 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 8 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 8 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 8 == pos )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+            DAC_CheckState [ bed ] = Status.DAC_CheckState;
+            LinkError      [ bed ] = 0;
+            SensorPos      [ bed ] = Status.SensorPos;
+            memcpy ( SensorPass [ bed ] , Status.SensorPass , sizeof ( SensorPass [ bed ] ) );
+            StatusValid    [ bed ] = true;
 
-        case 9:
-            for ( Counter = 9 ; Counter < 13 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 9 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 9 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 9 == pos )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+            Beds_Received  ( bed );
+            Telemetry_Boot ( TELEMETRY_BOOT_STATUS , Hal_Micros ( ) );
 
-        case 10:
-            for ( Counter = 9 ; Counter < 13 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 10 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 10 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 10 == pos )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
-            }
-        break;
+            Ready_Received ( );
+            Scheduler_Wake ( &Task_Compose );
 
-        case 11:
-            for ( Counter = 9 ; Counter < 13 ; Counter++ )
+            if ( PROTOCOL_FLAG_READY & Status.Flags )
             {
-                if ( ( SENSOR_FAIL == state ) && ( 11 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_RED_TOP + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 11 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_GREEN_TOP + MatrixRow [ Counter ];
-                }
-                else if ( 11 == pos )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_YELLOW_TOP + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_BLUE_TOP + MatrixRow [ Counter ];
-                }
+                Ready_Signal ( );
             }
-        break;
-
-        case 12:
-            for ( Counter = 16 ; Counter < 20 ; Counter++ )
+            else
             {
-                if ( ( SENSOR_FAIL == state ) && ( 12 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 12 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 12 == pos )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
+                // Nothing to do
             }
-        break;
 
-        case 13:
-            for ( Counter = 16 ; Counter < 20 ; Counter++ )
+            if ( PROTOCOL_FLAG_BRIGHTNESS & Status.Flags )
             {
-                if ( ( SENSOR_FAIL == state ) && ( 13 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 13 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 13 == pos )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
+                Hub75_SetBrightness ( Status.Brightness );
             }
-        break;
-
-        case 14:
-            for ( Counter = 16 ; Counter < 20 ; Counter++ )
+            else
             {
-                if ( ( SENSOR_FAIL == state ) && ( 14 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 14 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 14 == pos )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
+                // Nothing to do
             }
-        break;
+        }
+        else if ( PROTOCOL_OP_READINGS == Frame.Opcode )
+        {
+            ReadingsDue [ bed ] = Readings_Reply ( &Frame );
+            Scheduler_Wake ( &Task_Compose );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else if ( ( SPI_STATUS_DONE == spi_status ) && !Legacy && Protocol_Legacy ( bed ) )
+    {
+        // A v2 probe went unanswered , or the last miss before falling back ,
+        // the test bed speaks the original exchange
+    }
+    else
+    {
+        LinkError [ bed ] = ( SPI_STATUS_TIMEOUT == spi_status ) ? TELEMETRY_ERROR_TIMEOUT : TELEMETRY_ERROR_REPLY;
+        Telemetry_LinkError ( bed , LinkError [ bed ] );
 
-        case 15:
-            for ( Counter = 16 ; Counter < 20 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 15 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 15 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 15 == pos )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
-            }
-        break;
+        if ( Link_Update ( false ) )    // Poll again without waiting for SPI_RX_PERIOD
+        {
+            StatusDue [ bed ] = true;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+}
 
-        case 16:
-            for ( Counter = 16 ; Counter < 20 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 16 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 16 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 16 == pos )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
-            }
-        break;
+// Protocol , batch and link state of bed for the calls that follow
+static void Bed_Select ( uint8_t bed )
+{
+    Protocol_Select ( bed );
+    Batch_Select    ( bed );
+    Link_Select     ( bed );
+    Readings_Select ( bed );
+}
 
-        case 17:
-            for ( Counter = 16 ; Counter < 20 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 17 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 17 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 17 == pos )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
-            }
-        break;
+// Start the next test bed in turn with something to send , other than skip.
+// Queued button events and any status read share one transaction , readings
+// go when neither is waiting and no result is being read. Returns true if a
+// transaction was started.
+static bool Bed_Start ( uint8_t skip )
+{
+    uint8_t Bed         = 0;
+    uint8_t Counter_Bed = 0;
+    bool    Polled      = false;
 
-        case 18:
-            for ( Counter = 23 ; Counter < 27 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 18 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 18 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 18 == pos )
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 2 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 3 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 4 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
-            }
-        break;
+    if ( Ready_Take ( ) )   // Read on data ready , the line is shared by every bed
+    {
+        memset ( StatusDue , true , sizeof ( StatusDue ) );
+    }
+    else
+    {
+        // Nothing to do
+    }
 
-        case 19:
-            for ( Counter = 23 ; Counter < 27 ; Counter++ )
-            {
-                if ( ( SENSOR_FAIL == state ) && ( 19 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 19 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 19 == pos )
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 7 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 8 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 9 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
-            }
-        break;
+    SPI_Length = 0;
+
+    for ( Counter_Bed = 1 ; ( Counter_Bed <= TESTBED_COUNT ) && ( 0 == SPI_Length ) ; Counter_Bed++ )
+    {
+        Bed = ( LinkBed + Counter_Bed ) % TESTBED_COUNT;
 
-        case 20:
-            for ( Counter = 23 ; Counter < 27 ; Counter++ )
+        if ( Bed != skip )
+        {
+            Bed_Select ( Bed );
+
+            Polled     = StatusDue [ Bed ];
+            SPI_Length = Batch_Build ( &StatusDue [ Bed ] , SPI_TxBuffer );
+
+            if ( ( 0 == SPI_Length ) && ReadingsDue [ Bed ] && !Ready_Waiting ( ) )
             {
-                if ( ( SENSOR_FAIL == state ) && ( 20 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 20 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 20 == pos )
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 12 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 13 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 14 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
+                SPI_Length          = Readings_Build ( SPI_TxBuffer );
+                ReadingsDue [ Bed ] = false;
             }
-        break;
-
-        case 21:
-            for ( Counter = 23 ; Counter < 27 ; Counter++ )
+            else
             {
-                if ( ( SENSOR_FAIL == state ) && ( 21 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 21 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 21 == pos )
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 17 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 18 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 19 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
+                // Nothing to do
             }
-        break;
 
-        case 22:
-            for ( Counter = 23 ; Counter < 27 ; Counter++ )
+            if ( ( 0 == SPI_Length ) && ReplyHeld [ Bed ] )     // Nothing new to send , clock out the reply
             {
-                if ( ( SENSOR_FAIL == state ) && ( 22 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 22 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 22 == pos )
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 22 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 23 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 24 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
+                SPI_Length = Protocol_Idle ( SPI_TxBuffer );
             }
-        break;
-
-        case 23:
-            for ( Counter = 23 ; Counter < 27 ; Counter++ )
+            else
             {
-                if ( ( SENSOR_FAIL == state ) && ( 23 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_RED_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( ( SENSOR_PASS == state ) && ( 23 < pos ) )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_GREEN_BOTTOM + MatrixRow [ Counter ];
-                }
-                else if ( 23 == pos )
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_YELLOW_BOTTOM + MatrixRow [ Counter ];
-                }
-                else    // Invalid state
-                {
-                    MatrixData [ Counter ] [ 27 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 28 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                    MatrixData [ Counter ] [ 29 ] = LED_BLUE_BOTTOM + MatrixRow [ Counter ];
-                }
+                // Nothing to do
             }
-        break;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
 
-        default:
-        break;
+    if ( 0 != SPI_Length )
+    {
+        // Legacy replies come back in the same transaction , to a status read
+        // only. A v2 reply held when the test bed fell back never comes.
+        ReplyExpected     = ( ReplyHeld [ Bed ] && !Protocol_Legacy ( Bed ) ) || Protocol_LegacyReply ( );
+        ReplyHeld [ Bed ] = !Protocol_Legacy ( Bed ) && ( 0 != SPI_TxBuffer [ 0 ] );
+        LinkBed           = Bed;
+        LinkBuffer       ^= 1;
+
+        memset     ( SPI_RxBuffer [ LinkBuffer ] , 0 , sizeof ( SPI_RxBuffer [ LinkBuffer ] ) );
+        Link_Apply ( );
+        SPI_Select ( Bed );
+        SPI_Submit ( SPI_TxBuffer , SPI_RxBuffer [ LinkBuffer ] , SPI_Length , SPI_TIMEOUT , SPI_Done );
+
+        if ( Polled && !StatusDue [ Bed ] )
+        {
+            Scheduler_SetPeriod ( &Task_Poll , ( Ready_Active ( ) ? SPI_RX_PERIOD_LIVENESS : SPI_RX_PERIOD ) * 1000 );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // Nothing to do
     }
+
+    return ( 0 != SPI_Length );
+}
+
+// Status poll , a liveness check once the test bed uses data ready
+static void Poll ( void )
+{
+    memset ( StatusDue , true , sizeof ( StatusDue ) );
+    Scheduler_Wake ( &Task_Link );
+}
+
+// Live readings , every test bed is asked for what changed
+static void Readings ( void )
+{
+    memset ( ReadingsDue , true , sizeof ( ReadingsDue ) );
+    Scheduler_Wake ( &Task_Link );
+}
+
+// Transaction complete , called from the SPI DMA interrupt
+static void SPI_Done ( const uint8_t *rx , uint8_t length )
+{
+    Telemetry_SPI   ( SPI_Stats.Duration );
+    Scheduler_Event ( );
+}
+
+// Health record and USB output
+static void Telemetry ( void )
+{
+    Telemetry_Drain ( );
 }
 
 static void Watchdog ( void )
 {
-    watchdog_update ( );
+    Hal_WatchdogFeed ( );
+    Telemetry_Fed    ( );
 }
 
 /*** end of file ***/
@@ -0,0 +1,222 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           matrix.c                                              *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <matrix.h>
+#include <matrix_layout.h>
+#include <animation.h>
+#include <hub75.h>
+#include <text.h>
+
+#include <string.h>
+
+// Tile colour for each MATRIX_TILE_ state
+static const uint32_t MatrixTileColour [ ] = {
+    COLOUR_RED,     // MATRIX_TILE_FAIL
+    COLOUR_GREEN,   // MATRIX_TILE_PASS
+    COLOUR_YELLOW,  // MATRIX_TILE_TESTING
+    COLOUR_BLUE,    // MATRIX_TILE_WAITING
+    COLOUR_BLUE,    // MATRIX_TILE_UNKNOWN
+};
+
+// Tile effect for each MATRIX_TILE_ state , the sensor under test has to stand out
+static const uint8_t MatrixTileEffect [ ] = {
+    ANIMATION_BLINK,    // MATRIX_TILE_FAIL
+    ANIMATION_NONE,     // MATRIX_TILE_PASS
+    ANIMATION_PULSE,    // MATRIX_TILE_TESTING
+    ANIMATION_NONE,     // MATRIX_TILE_WAITING
+    ANIMATION_CHASE,    // MATRIX_TILE_UNKNOWN
+};
+
+// State last drawn into the back buffer for each slot
+static uint8_t Matrix_TileState [ MATRIX_SLOTS ] = { [ 0 ... MATRIX_SLOTS - 1 ] = MATRIX_TILE_NONE };
+
+// Label last drawn for each test bed
+static char     Matrix_LabelText   [ TESTBED_COUNT ] [ TEXT_LENGTH + 1 ];
+static uint32_t Matrix_LabelColour [ TESTBED_COUNT ];
+
+static uint32_t Matrix_DirtyRows  = 0;
+static uint32_t Matrix_Drawn      = 0;  // Since Matrix_RateStart
+static uint32_t Matrix_RateStart  = 0;
+static uint32_t Matrix_Skipped    = 0;  // Since Matrix_RateStart
+
+volatile MatrixStats_t Matrix_Stats;
+
+// Bar graph of each slot whose reading has changed , value 0 to full_scale
+// or above it for none , shown as a whole tile. Only slots flagged in
+// changed ( slot n in bit ( n % 8 ) of byte ( n / 8 ) ) are looked at , and
+// their flags cleared. Returns the pixel rows that changed.
+uint32_t Matrix_Bars ( const uint16_t *value , uint8_t *changed , uint16_t full_scale )
+{
+    uint32_t Dirty        = 0;
+    uint8_t  Counter_Slot = 0;
+
+    for ( Counter_Slot = 0 ; Counter_Slot < MATRIX_SLOTS ; Counter_Slot++ )
+    {
+        if ( 0 == changed [ Counter_Slot / 8 ] )    // Eight unchanged slots at a time
+        {
+            Counter_Slot |= 7;
+        }
+        else if ( changed [ Counter_Slot / 8 ] & ( 1u << ( Counter_Slot % 8 ) ) )
+        {
+            changed [ Counter_Slot / 8 ] &= ( uint8_t ) ~( 1u << ( Counter_Slot % 8 ) );
+
+            Dirty |= Animation_Bar ( Counter_Slot , ( value [ Counter_Slot ] > full_scale ) ? TILE_HEIGHT :
+                                     ( uint8_t ) ( ( ( value [ Counter_Slot ] * TILE_HEIGHT ) + ( full_scale / 2 ) ) / full_scale ) );
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    return Dirty;
+}
+
+// Bring every tile up to date , animations included , and return the pixel
+// rows that changed ( bit n = row n ). pass holds SENSOR_BYTES per test bed ,
+// sensor n in bit ( n % 8 ) of byte ( n / 8 ) , and pos one position per bed.
+uint32_t Matrix_Compose ( const uint8_t *pass , const uint8_t *pos )
+{
+    const uint8_t *Pass         = NULL;
+    uint32_t       Dirty        = 0;
+    uint32_t       Now          = Hal_Micros ( );
+    uint8_t        Counter_Slot = 0;
+    uint8_t        Sensor       = 0;
+
+    Matrix_DirtyRows = 0;
+
+    for ( Counter_Slot = 0 ; Counter_Slot < MATRIX_SLOTS ; Counter_Slot++ )
+    {
+        Pass   = &pass [ ( Counter_Slot / SENSOR_COUNT ) * SENSOR_BYTES ];
+        Sensor = Counter_Slot % SENSOR_COUNT;
+
+        Matrix_SetBuffer ( Counter_Slot , ( Pass [ Sensor / 8 ] >> ( Sensor % 8 ) ) & 0b00000001 , pos [ Counter_Slot / SENSOR_COUNT ] );
+    }
+
+    Dirty = Matrix_DirtyRows | Animation_Step ( );
+
+    if ( ( Now - Matrix_RateStart ) >= 1000000 )
+    {
+        Matrix_Stats.DrawnPerSecond   = Matrix_Drawn;
+        Matrix_Stats.SkippedPerSecond = Matrix_Skipped;
+        Matrix_Drawn                  = 0;
+        Matrix_Skipped                = 0;
+        Matrix_RateStart              = Now;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Dirty;
+}
+
+// Status label of bed under its band of tiles , only drawn when its text or
+// colour differs from what is already in the framebuffer. Returns the pixel
+// rows that changed.
+uint32_t Matrix_Label ( uint8_t bed , const char *text , uint32_t colour )
+{
+    uint32_t Dirty = 0;
+
+    if ( ( bed < TESTBED_COUNT ) && ( ( colour != Matrix_LabelColour [ bed ] ) || ( 0 != strncmp ( text , Matrix_LabelText [ bed ] , LABEL_CHARS ) ) ) )
+    {
+        Dirty = Text_Draw ( LABEL_ROW , LABEL_COLUMN ( bed ) , text , LABEL_CHARS , colour );
+
+        strncpy ( Matrix_LabelText [ bed ] , text , LABEL_CHARS );
+        Matrix_LabelColour [ bed ] = colour;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Dirty;
+}
+
+// Completed sensors below pos show pass / fail , pos is under test and
+// anything beyond it has not been reached yet. A pos past the end of the
+// jig , MATRIX_POS_UNKNOWN included , is unknown. pos is the slot's own test
+// bed position. The tile is only restarted when that outcome differs from
+// what is already in the framebuffer , Animation_Step moves it on from there.
+bool Matrix_SetBuffer ( uint8_t slot , uint8_t state , uint8_t pos )
+{
+    uint8_t Sensor = slot % SENSOR_COUNT;
+    uint8_t Tile   = MATRIX_TILE_WAITING;
+    bool    Redraw = false;
+
+    if ( slot < MATRIX_SLOTS )
+    {
+        if ( pos > SENSOR_COUNT )   // Before pass / fail , every sensor is below an unknown pos
+        {
+            Tile = MATRIX_TILE_UNKNOWN;
+        }
+        else if ( ( SENSOR_FAIL == state ) && ( Sensor < pos ) )
+        {
+            Tile = MATRIX_TILE_FAIL;
+        }
+        else if ( ( SENSOR_PASS == state ) && ( Sensor < pos ) )
+        {
+            Tile = MATRIX_TILE_PASS;
+        }
+        else if ( Sensor == pos )
+        {
+            Tile = MATRIX_TILE_TESTING;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Redraw = ( Tile != Matrix_TileState [ slot ] );
+
+        if ( Redraw )
+        {
+            Matrix_DirtyRows         |= Animation_Start ( slot , MatrixTile [ slot ].Row , MatrixTile [ slot ].Column , MatrixTileEffect [ Tile ] , MatrixTileColour [ Tile ] );
+            Matrix_TileState [ slot ] = Tile;
+            Matrix_Stats.Drawn++;
+            Matrix_Drawn++;
+        }
+        else
+        {
+            Matrix_Stats.Skipped++;
+            Matrix_Skipped++;
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Redraw;
+}
+
+// Start up frame , every tile dimmed until the test bed first answers. The
+// tiles are left marked undrawn so the first Matrix_Compose redraws them all.
+void Matrix_Splash ( void )
+{
+    uint32_t Dirty        = 0;
+    uint8_t  Counter_Slot = 0;
+
+    for ( Counter_Slot = 0 ; Counter_Slot < MATRIX_SLOTS ; Counter_Slot++ )
+    {
+        Dirty |= Animation_Start ( Counter_Slot , MatrixTile [ Counter_Slot ].Row , MatrixTile [ Counter_Slot ].Column , ANIMATION_NONE , COLOUR_IDLE );
+    }
+
+    Hub75_Present ( Dirty );
+}
+
+/*** end of file ***/
@@ -0,0 +1,373 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           protocol.c                                            *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <protocol.h>
+
+#include <string.h>
+
+// DAC check
+const uint8_t DAC_CHECK_IS_READY    = 0x10;
+const uint8_t DAC_CHECK_RUNNING     = 0x0B;
+const uint8_t DAC_CHECK_NOT_RUNNING = 0x0F;
+const uint8_t SYNC_BYTE             = 0x55;
+
+typedef struct
+{
+    uint8_t Opcode;
+    uint8_t Sequence;
+    bool    Valid;
+} Protocol_InFlight_t;
+
+// Each test bed has its own sequence numbers , window and mode. Every bed
+// starts out in PROTOCOL_MODE_V2 ( 0 ).
+typedef struct
+{
+    Protocol_InFlight_t Window [ PROTOCOL_WINDOW ];
+    uint8_t             LastOpcode;     // Legacy mode , request of the current transaction
+    uint8_t             Misses;         // Consecutive v2 transactions without a valid reply
+    uint8_t             Mode;
+    uint8_t             Oldest;         // Next window slot to reuse
+    uint8_t             Probe;          // Legacy status reads since falling back or the last probe
+    uint8_t             Sequence;
+} Protocol_Bed_t;
+
+static Protocol_Bed_t  Protocol_Beds [ TESTBED_COUNT ];
+static Protocol_Bed_t *Protocol_Bed = &Protocol_Beds [ 0 ];    // Selected by Protocol_Select
+
+volatile Protocol_Stats_t Protocol_Stats;
+
+uint16_t Protocol_CRC16 ( const uint8_t *data , uint8_t length )
+{
+    uint16_t CRC         = 0xFFFF;
+    uint8_t  Counter_Bit = 0;
+
+    while ( length-- )
+    {
+        CRC ^= ( uint16_t ) ( *data++ << 8 );
+
+        for ( Counter_Bit = 0 ; Counter_Bit < 8 ; Counter_Bit++ )
+        {
+            CRC = ( CRC & 0x8000 ) ? ( uint16_t ) ( ( CRC << 1 ) ^ 0x1021 ) : ( uint16_t ) ( CRC << 1 );
+        }
+    }
+
+    return CRC;
+}
+
+// Collect the reply to the last request without making another
+uint8_t Protocol_Idle ( uint8_t *tx )
+{
+    memset ( tx , 0 , PROTOCOL_FRAME_LENGTH );
+
+    return PROTOCOL_FRAME_LENGTH;
+}
+
+// Test bed only speaks the original exchange
+bool Protocol_Legacy ( uint8_t bed )
+{
+    return ( bed < TESTBED_COUNT ) && ( PROTOCOL_MODE_LEGACY == Protocol_Beds [ bed ].Mode );
+}
+
+// Legacy mode , true if the transaction just built returns a reply. Only a
+// status read does , a button command is never answered.
+bool Protocol_LegacyReply ( void )
+{
+    return ( PROTOCOL_MODE_LEGACY == Protocol_Bed->Mode ) && ( PROTOCOL_OP_STATUS == Protocol_Bed->LastOpcode );
+}
+
+// Sequence number the next v2 request will carry
+uint8_t Protocol_Next ( void )
+{
+    return Protocol_Bed->Sequence;
+}
+
+// Test bed the following requests and replies belong to
+void Protocol_Select ( uint8_t bed )
+{
+    Protocol_Bed = &Protocol_Beds [ ( bed < TESTBED_COUNT ) ? bed : 0 ];
+}
+
+// Build the next transaction into tx and return its length
+uint8_t Protocol_Request ( uint8_t opcode , const uint8_t *payload , uint8_t length , uint8_t *tx )
+{
+    uint16_t CRC    = 0;
+    uint8_t  Length = 0;
+
+    if ( PROTOCOL_MODE_V2 == Protocol_Bed->Mode )
+    {
+        length = ( length > PROTOCOL_PAYLOAD_MAX ) ? PROTOCOL_PAYLOAD_MAX : length;
+
+        // Oldest request in flight is given up on when the window is full
+        if ( Protocol_Bed->Window [ Protocol_Bed->Oldest ].Valid )
+        {
+            Protocol_Stats.Lost++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Protocol_Bed->Window [ Protocol_Bed->Oldest ].Opcode   = opcode;
+        Protocol_Bed->Window [ Protocol_Bed->Oldest ].Sequence = Protocol_Bed->Sequence;
+        Protocol_Bed->Window [ Protocol_Bed->Oldest ].Valid    = true;
+        Protocol_Bed->Oldest = ( Protocol_Bed->Oldest + 1 ) % PROTOCOL_WINDOW;
+
+        memset ( tx , 0 , PROTOCOL_FRAME_LENGTH );
+        tx [ 0 ] = SYNC_BYTE;
+        tx [ 1 ] = PROTOCOL_VERSION;
+        tx [ 2 ] = length;
+        tx [ 3 ] = Protocol_Bed->Sequence++;
+        tx [ 4 ] = opcode;
+
+        if ( 0 != length )
+        {
+            memcpy ( &tx [ PROTOCOL_HEADER_LENGTH ] , payload , length );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        CRC = Protocol_CRC16 ( &tx [ 1 ] , PROTOCOL_HEADER_LENGTH - 1 + length );
+        tx [ PROTOCOL_HEADER_LENGTH + length     ] = ( uint8_t ) ( CRC >> 8 );
+        tx [ PROTOCOL_HEADER_LENGTH + length + 1 ] = ( uint8_t ) CRC;
+
+        Length = PROTOCOL_FRAME_LENGTH;
+    }
+    else if ( PROTOCOL_OP_STATUS == opcode )
+    {
+        memset ( tx , 0 , PROTOCOL_LEGACY_LENGTH );
+        tx [ 0 ] = SYNC_BYTE;
+        tx [ 1 ] = DAC_CHECK_IS_READY;
+
+        Length = PROTOCOL_LEGACY_LENGTH;
+    }
+    else    // Legacy button command
+    {
+        tx [ 0 ] = SYNC_BYTE;
+        tx [ 1 ] = ( 0 != length ) ? payload [ 0 ] : 0;
+
+        Length = 2;
+    }
+
+    Protocol_Bed->LastOpcode = opcode;
+
+    return Length;
+}
+
+// Check a completed transaction , true if it carried a valid reply to one of our requests
+bool Protocol_Receive ( const uint8_t *rx , uint8_t length , Protocol_Frame_t *frame )
+{
+    uint16_t CRC            = 0;
+    uint8_t  Counter_Offset = 0;
+    uint8_t  Counter_Slot   = 0;
+    uint8_t  Length         = 0;
+    bool     Found          = false;
+    bool     Valid          = false;
+
+    if ( PROTOCOL_MODE_LEGACY == Protocol_Bed->Mode )
+    {
+        if ( ( PROTOCOL_OP_STATUS == Protocol_Bed->LastOpcode ) && ( PROTOCOL_LEGACY_LENGTH <= length ) && ( SYNC_BYTE == rx [ 4 ] ) && ( DAC_CHECK_IS_READY == rx [ 5 ] ) )
+        {
+            // DAC state , sensor pass and position sit where the v2 status payload does
+            frame->Opcode   = PROTOCOL_OP_STATUS;
+            frame->Sequence = 0;
+            frame->Length   = 5;
+            memcpy ( frame->Payload , &rx [ 6 ] , 5 );
+
+            Protocol_Stats.Frames++;
+            Valid = true;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        // Try v2 again , a single miss falls back at once
+        if ( ++Protocol_Bed->Probe >= PROTOCOL_V2_PROBE )
+        {
+            Protocol_Bed->Probe  = 0;
+            Protocol_Bed->Misses = PROTOCOL_V2_ATTEMPTS - 1;
+            Protocol_Bed->Mode   = PROTOCOL_MODE_V2;
+            Protocol_Stats.Probes++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // The reply may start anywhere in the transaction
+        for ( Counter_Offset = 0 ; ( Counter_Offset + PROTOCOL_HEADER_LENGTH + PROTOCOL_CRC_LENGTH ) <= length ; Counter_Offset++ )
+        {
+            if ( ( SYNC_BYTE != rx [ Counter_Offset ] ) || ( PROTOCOL_VERSION != rx [ Counter_Offset + 1 ] ) )
+            {
+                continue;
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            Length = rx [ Counter_Offset + 2 ];
+
+            if ( ( Length > PROTOCOL_PAYLOAD_MAX ) || ( ( Counter_Offset + PROTOCOL_HEADER_LENGTH + Length + PROTOCOL_CRC_LENGTH ) > length ) )
+            {
+                continue;
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            CRC = Protocol_CRC16 ( &rx [ Counter_Offset + 1 ] , PROTOCOL_HEADER_LENGTH - 1 + Length );
+
+            if ( ( ( uint8_t ) ( CRC >> 8 ) != rx [ Counter_Offset + PROTOCOL_HEADER_LENGTH + Length ] ) || ( ( uint8_t ) CRC != rx [ Counter_Offset + PROTOCOL_HEADER_LENGTH + Length + 1 ] ) )
+            {
+                Protocol_Stats.CRC_Errors++;
+                continue;
+            }
+            else
+            {
+                // Nothing to do
+            }
+
+            Found = true;
+            break;
+        }
+
+        if ( Found )
+        {
+            Protocol_Bed->Misses = 0;
+            Protocol_Stats.Frames++;
+
+            // Match the reply to its request
+            for ( Counter_Slot = 0 ; Counter_Slot < PROTOCOL_WINDOW ; Counter_Slot++ )
+            {
+                if ( ( Protocol_Bed->Window [ Counter_Slot ].Valid ) && ( rx [ Counter_Offset + 3 ] == Protocol_Bed->Window [ Counter_Slot ].Sequence ) && ( rx [ Counter_Offset + 4 ] == Protocol_Bed->Window [ Counter_Slot ].Opcode ) )
+                {
+                    Protocol_Bed->Window [ Counter_Slot ].Valid = false;
+                    break;
+                }
+                else
+                {
+                    // Nothing to do
+                }
+            }
+
+            if ( PROTOCOL_WINDOW == Counter_Slot )
+            {
+                Protocol_Stats.Unmatched++;
+            }
+            else
+            {
+                frame->Opcode   = rx [ Counter_Offset + 4 ];
+                frame->Sequence = rx [ Counter_Offset + 3 ];
+                frame->Length   = Length;
+                memcpy ( frame->Payload , &rx [ Counter_Offset + PROTOCOL_HEADER_LENGTH ] , Length );
+
+                Valid = true;
+            }
+        }
+        else
+        {
+            Protocol_Stats.Sync_Errors++;
+
+            if ( ++Protocol_Bed->Misses >= PROTOCOL_V2_ATTEMPTS )   // Test bed only speaks the original exchange
+            {
+                memset ( Protocol_Bed->Window , 0 , sizeof ( Protocol_Bed->Window ) );
+                Protocol_Bed->Mode  = PROTOCOL_MODE_LEGACY;
+                Protocol_Bed->Probe = 0;
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+    }
+
+    return Valid;
+}
+
+// Decode a status reply , either layout , into the jig's pass bitmap
+bool Protocol_Status ( const Protocol_Frame_t *frame , Protocol_Status_t *status )
+{
+    uint8_t Bytes = 0;
+    uint8_t Count = 0;
+    bool    Valid = false;
+
+    if ( ( PROTOCOL_OP_STATUS == frame->Opcode ) && ( 5 <= frame->Length ) )
+    {
+        status->DAC_CheckState = frame->Payload [ 0 ];
+        status->SensorPos      = frame->Payload [ 4 ];
+        status->Flags          = ( 6 <= frame->Length ) ? frame->Payload [ 5 ] : 0;
+        status->Brightness     = ( 7 <= frame->Length ) ? frame->Payload [ 6 ] : 0;
+
+        // 24 bits MSB first , sensor 0 in the last byte
+        memset ( status->SensorPass , 0 , sizeof ( status->SensorPass ) );
+
+        for ( Count = 0 ; ( Count < 3 ) && ( Count < SENSOR_BYTES ) ; Count++ )
+        {
+            status->SensorPass [ Count ] = frame->Payload [ 3 - Count ];
+        }
+
+        if ( 7 > frame->Length )
+        {
+            status->Flags &= ( uint8_t ) ~PROTOCOL_FLAG_BRIGHTNESS;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Valid = true;
+    }
+    else if ( ( PROTOCOL_OP_STATUS_N == frame->Opcode ) && ( PROTOCOL_STATUS_N_BASE <= frame->Length ) &&
+              ( ( PROTOCOL_STATUS_N_BASE + ( ( frame->Payload [ 4 ] + 7 ) / 8 ) ) <= frame->Length ) )
+    {
+        status->DAC_CheckState = frame->Payload [ 0 ];
+        status->SensorPos      = frame->Payload [ 1 ];
+        status->Flags          = frame->Payload [ 2 ];
+        status->Brightness     = frame->Payload [ 3 ];
+
+        // Only the sensors both ends know about
+        Count = ( frame->Payload [ 4 ] < SENSOR_COUNT ) ? frame->Payload [ 4 ] : SENSOR_COUNT;
+        Bytes = ( Count + 7 ) / 8;
+        memset ( status->SensorPass , 0 , sizeof ( status->SensorPass ) );
+        memcpy ( status->SensorPass , &frame->Payload [ PROTOCOL_STATUS_N_BASE ] , Bytes );
+
+        if ( 0 != ( Count % 8 ) )
+        {
+            status->SensorPass [ Bytes - 1 ] &= ( uint8_t ) ( ( 1u << ( Count % 8 ) ) - 1 );
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Valid = true;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Valid;
+}
+
+/*** end of file ***/
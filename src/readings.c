@@ -0,0 +1,135 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           readings.c                                            *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <readings.h>
+
+#include <string.h>
+
+static uint8_t Readings_Bed                          = 0;   // Selected by Readings_Select
+static uint8_t Readings_Held       [ TESTBED_COUNT ] = { 0 };
+static uint8_t Readings_Unanswered [ TESTBED_COUNT ] = { 0 };
+
+uint8_t  Readings_Changed [ READINGS_BYTES ] = { 0 };
+uint16_t Readings_Value   [ MATRIX_SLOTS ]   = { [ 0 ... MATRIX_SLOTS - 1 ] = READINGS_NONE };
+
+volatile Readings_Stats_t Readings_Stats;
+
+// Build a readings request into tx , returns 0 if the test bed does not
+// support them
+uint8_t Readings_Build ( uint8_t *tx )
+{
+    uint8_t Length = 0;
+
+    if ( !Protocol_Legacy ( Readings_Bed ) && ( Readings_Unanswered [ Readings_Bed ] < READINGS_ATTEMPTS ) )
+    {
+        Length = Protocol_Request ( PROTOCOL_OP_READINGS , &Readings_Held [ Readings_Bed ] , 1 , tx );
+
+        Readings_Unanswered [ Readings_Bed ]++;
+        Readings_Stats.Requests++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Length;
+}
+
+// Apply a PROTOCOL_OP_READINGS reply , true if the test bed has more changes
+bool Readings_Reply ( const Protocol_Frame_t *frame )
+{
+    uint16_t *Value         = NULL;
+    uint16_t  New           = 0;
+    uint8_t   Sensor        = 0;
+    uint8_t   Counter_Entry = 2;
+    bool      More          = false;
+    bool      Valid         = true;
+
+    if ( ( PROTOCOL_OP_READINGS == frame->Opcode ) && ( 2 <= frame->Length ) )
+    {
+        Readings_Unanswered [ Readings_Bed ] = 0;
+
+        if ( frame->Payload [ 1 ] == Readings_Held [ Readings_Bed ] )
+        {
+            while ( Counter_Entry < frame->Length )
+            {
+                Sensor = frame->Payload [ Counter_Entry ] & ~READINGS_LONG;
+                Value  = &Readings_Value [ ( Readings_Bed * SENSOR_COUNT ) + ( ( Sensor < SENSOR_COUNT ) ? Sensor : 0 ) ];
+
+                if ( ( READINGS_LONG & frame->Payload [ Counter_Entry ] ) && ( ( Counter_Entry + 2 ) < frame->Length ) )
+                {
+                    New            = ( ( frame->Payload [ Counter_Entry + 1 ] & 0x0F ) << 8 ) | frame->Payload [ Counter_Entry + 2 ];
+                    Counter_Entry += 3;
+                }
+                else if ( !( READINGS_LONG & frame->Payload [ Counter_Entry ] ) && ( ( Counter_Entry + 1 ) < frame->Length ) && ( READINGS_NONE != *Value ) )
+                {
+                    New            = ( uint16_t ) ( *Value + ( int8_t ) frame->Payload [ Counter_Entry + 1 ] ) & READINGS_FULL_SCALE;
+                    Counter_Entry += 2;
+                    Readings_Stats.Deltas++;
+                }
+                else    // Cut short , or a change to a value never sent
+                {
+                    Sensor        = SENSOR_COUNT;
+                    Counter_Entry = frame->Length;
+                    Valid         = false;
+                }
+
+                if ( Sensor < SENSOR_COUNT )
+                {
+                    *Value = New;
+                    Readings_Changed [ ( Value - Readings_Value ) / 8 ] |= ( uint8_t ) ( 1u << ( ( Value - Readings_Value ) % 8 ) );
+                    Readings_Stats.Entries++;
+                }
+                else
+                {
+                    // Nothing to do
+                }
+            }
+
+            // A reply that does not decode asks for every value again
+            Readings_Held [ Readings_Bed ] = Valid ? ( frame->Payload [ 0 ] & READINGS_GENERATION ) : 0;
+            More                           = !Valid || ( 0 != ( READINGS_MORE & frame->Payload [ 0 ] ) );
+            Readings_Stats.Replies++;
+        }
+        else
+        {
+            Readings_Stats.Mismatched++;
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return More;
+}
+
+// Test bed the following Readings_Build and Readings_Reply calls belong to ,
+// along with Protocol_Select
+// Give the selected test bed READINGS_ATTEMPTS again , after its link has
+// been trained or it has come back from going quiet
+void Readings_Reset ( void )
+{
+    Readings_Unanswered [ Readings_Bed ] = 0;
+}
+
+void Readings_Select ( uint8_t bed )
+{
+    Readings_Bed = ( bed < TESTBED_COUNT ) ? bed : 0;
+}
+
+/*** end of file ***/
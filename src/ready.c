@@ -0,0 +1,162 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           ready.c                                               *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <ready.h>
+#include <scheduler.h>
+
+#include <string.h>
+
+static volatile uint32_t Ready_Start = 0;   // Hal_Micros of the signal being tracked
+static volatile uint8_t  Ready_State = READY_STATE_IDLE;
+
+volatile Ready_Stats_t Ready_Stats;
+
+static void Ready_ISR ( void );
+
+// Test bed signalled since start-up , so polling can slow down
+bool Ready_Active ( void )
+{
+    return ( 0 != Ready_Stats.Events );
+}
+
+// Called after each Hub75_Present
+void Ready_Composed ( uint32_t dirty_rows )
+{
+    if ( READY_STATE_RECEIVED == Ready_State )
+    {
+        if ( 0 != dirty_rows )
+        {
+            Ready_State = READY_STATE_COMPOSED;
+        }
+        else
+        {
+            Ready_Stats.Unchanged++;
+            Ready_State = READY_STATE_IDLE;
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+void Ready_Init ( void )
+{
+    memset ( ( void * ) &Ready_Stats , 0 , sizeof ( Ready_Stats ) );
+
+    // Idle low , so a test bed without the line never signals
+    Hal_GpioInput ( DATA_READY_PIN       , true                      );
+    Hal_GpioIrq   ( 1u << DATA_READY_PIN , HAL_EDGE_RISE , Ready_ISR );
+}
+
+// Called for each decoded status reply
+void Ready_Received ( void )
+{
+    if ( READY_STATE_READING == Ready_State )
+    {
+        Ready_State = READY_STATE_RECEIVED;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Called once Hub75_IsReady , i.e. the last presented buffer is on the panel
+void Ready_Shown ( uint32_t shown )
+{
+    uint32_t Latency = 0;
+    uint     Bin     = 0;
+
+    if ( READY_STATE_COMPOSED == Ready_State )
+    {
+        Latency = shown - Ready_Start;
+        Bin     = 31 - __builtin_clz ( Latency | 1 );
+
+        Ready_Stats.Histogram [ ( Bin < READY_HISTOGRAM_BINS ) ? Bin : ( READY_HISTOGRAM_BINS - 1 ) ]++;
+        Ready_Stats.Latency    = Latency;
+        Ready_Stats.LatencyMax = ( Latency > Ready_Stats.LatencyMax ) ? Latency : Ready_Stats.LatencyMax;
+        Ready_Stats.Shown++;
+
+        Ready_State = READY_STATE_IDLE;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// A result is waiting , from the data ready edge or a status reply flag
+void Ready_Signal ( void )
+{
+    uint32_t Interrupts = Hal_IrqDisable ( );
+
+    Ready_Stats.Events++;
+
+    if ( READY_STATE_IDLE == Ready_State )
+    {
+        Ready_Start = Hal_Micros ( );
+        Ready_State = READY_STATE_SIGNALLED;
+
+        Scheduler_Event ( );
+    }
+    else
+    {
+        Ready_Stats.Coalesced++;
+    }
+
+    Hal_IrqRestore ( Interrupts );
+}
+
+// True once per signal , the caller reads the status straight away
+bool Ready_Take ( void )
+{
+    bool Take = ( READY_STATE_SIGNALLED == Ready_State );
+
+    if ( Take )
+    {
+        Ready_State = READY_STATE_READING;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Take;
+}
+
+// A signal is being read , so readings and bars should hold off
+bool Ready_Waiting ( void )
+{
+    uint8_t State = Ready_State;
+
+    return ( ( READY_STATE_SIGNALLED == State ) || ( READY_STATE_READING == State ) );
+}
+
+static void Ready_ISR ( void )
+{
+    if ( HAL_EDGE_RISE & Hal_GpioEvents ( DATA_READY_PIN ) )
+    {
+        Ready_Signal ( );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+/*** end of file ***/
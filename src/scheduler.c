@@ -0,0 +1,246 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           scheduler.c                                           *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <scheduler.h>
+
+#include <string.h>
+
+// Heap order on Deadline , only changed with interrupts disabled as
+// interrupt handlers may wake tasks
+static Task_t *Scheduler_Heap [ SCHEDULER_TASKS_MAX ];
+static uint8_t Scheduler_Count     = 0;
+static Task_t *Scheduler_EventTask = NULL;
+
+volatile Scheduler_Stats_t Scheduler_Stats;
+
+static void Scheduler_Down     ( uint8_t index );
+static void Scheduler_Place    ( Task_t *task , uint8_t index );
+static void Scheduler_Up       ( uint8_t index );
+
+// Tasks may be added before or after Scheduler_Run starts
+void Scheduler_Add ( Task_t *task , Task_Function_t function , const char *name , uint32_t period_us , uint32_t delay_us )
+{
+    uint32_t Interrupts = 0;
+
+    memset ( task , 0 , sizeof ( *task ) );
+    task->Function = function;
+    task->Name     = name;
+    task->Period   = period_us;
+    task->Deadline = ( 0 != period_us ) ? ( Hal_Micros64 ( ) + delay_us ) : UINT64_MAX;
+
+    Interrupts = Hal_IrqDisable ( );
+
+    if ( Scheduler_Count < SCHEDULER_TASKS_MAX )
+    {
+        Scheduler_Place ( task , Scheduler_Count++ );
+        Scheduler_Up    ( task->Index );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Hal_IrqRestore ( Interrupts );
+}
+
+// Wake the task given to Scheduler_Init , for drivers that signal work from an interrupt
+void Scheduler_Event ( void )
+{
+    if ( NULL != Scheduler_EventTask )
+    {
+        Scheduler_Wake ( Scheduler_EventTask );
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+void Scheduler_Init ( Task_t *event_task )
+{
+    memset ( ( void * ) &Scheduler_Stats , 0 , sizeof ( Scheduler_Stats ) );
+
+    Scheduler_EventTask = event_task;
+}
+
+// Run tasks as they fall due , never returns
+void Scheduler_Run ( void )
+{
+    Task_t   *Task       = NULL;
+    uint64_t  Now        = 0;
+    uint64_t  Start      = 0;
+    uint32_t  Interrupts = 0;
+    uint32_t  RunTime    = 0;
+
+    for ( ; ; )
+    {
+        Interrupts = Hal_IrqDisable ( );
+        Now        = Hal_Micros64 ( );
+        Task       = Scheduler_Heap [ 0 ];
+
+        if ( ( 0 != Scheduler_Count ) && ( Task->Deadline <= Now ) )
+        {
+            // Take the task off the heap while it runs
+            Scheduler_Place ( Scheduler_Heap [ --Scheduler_Count ] , 0 );
+            Scheduler_Down  ( 0 );
+            Task->Index = SCHEDULER_RUNNING;
+            Task->Woken = false;
+            Hal_IrqRestore ( Interrupts );
+
+            Task->Late    = ( uint32_t ) ( Now - Task->Deadline );
+            Task->LateMax = ( Task->Late > Task->LateMax ) ? Task->Late : Task->LateMax;
+
+            Start = Hal_Micros64 ( );
+            Task->Function ( );
+            RunTime = ( uint32_t ) ( Hal_Micros64 ( ) - Start );
+
+            Task->RunTime    = RunTime;
+            Task->RunTimeMax = ( RunTime > Task->RunTimeMax ) ? RunTime : Task->RunTimeMax;
+            Task->Runs++;
+
+            // Missed periods are dropped rather than run back to back , whole
+            // periods at a time so the task keeps its phase. A wake restarts
+            // the period from the woken run.
+            Interrupts = Hal_IrqDisable ( );
+
+            if ( Task->Woken )
+            {
+                Task->Deadline = Start;
+            }
+            else if ( 0 != Task->Period )
+            {
+                Task->Deadline += Task->Period;
+                Task->Deadline += ( Task->Deadline < Start ) ? ( ( Start - Task->Deadline ) / Task->Period ) * Task->Period : 0;
+            }
+            else
+            {
+                Task->Deadline = UINT64_MAX;
+            }
+
+            Scheduler_Place ( Task , Scheduler_Count++ );
+            Scheduler_Up    ( Task->Index );
+            Hal_IrqRestore ( Interrupts );
+        }
+        else
+        {
+            if ( ( 0 == Scheduler_Count ) || ( UINT64_MAX == Task->Deadline ) || Hal_WakeAt ( Task->Deadline ) )
+            {
+                Scheduler_Stats.Sleeps++;
+                Hal_Sleep ( );
+                Scheduler_Stats.Idle += Hal_Micros64 ( ) - Now;
+            }
+            else
+            {
+                // Deadline passed while setting the alarm
+            }
+
+            Hal_IrqRestore ( Interrupts );
+        }
+    }
+}
+
+// Takes effect from the task's next run
+void Scheduler_SetPeriod ( Task_t *task , uint32_t period_us )
+{
+    task->Period = period_us;
+}
+
+// Make a task due now , may be called from an interrupt handler
+void Scheduler_Wake ( Task_t *task )
+{
+    uint32_t Interrupts = Hal_IrqDisable ( );
+    uint64_t Now        = Hal_Micros64 ( );
+
+    if ( SCHEDULER_RUNNING == task->Index )
+    {
+        task->Woken = true;
+    }
+    else if ( task->Index < Scheduler_Count )
+    {
+        // Only ever brought forward , so it only moves up the heap and an
+        // overdue task keeps its place ahead of later deadlines
+        task->Deadline = ( task->Deadline < Now ) ? task->Deadline : Now;
+        Scheduler_Up ( task->Index );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Hal_IrqRestore ( Interrupts );
+}
+
+static void Scheduler_Down ( uint8_t index )
+{
+    Task_t  *Task  = Scheduler_Heap [ index ];
+    uint8_t  Child = 0;
+
+    while ( ( Child = ( uint8_t ) ( ( 2 * index ) + 1 ) ) < Scheduler_Count )
+    {
+        if ( ( ( Child + 1 ) < Scheduler_Count ) && ( Scheduler_Heap [ Child + 1 ]->Deadline < Scheduler_Heap [ Child ]->Deadline ) )
+        {
+            Child++;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        if ( Scheduler_Heap [ Child ]->Deadline >= Task->Deadline )
+        {
+            break;
+        }
+        else
+        {
+            Scheduler_Place ( Scheduler_Heap [ Child ] , index );
+            index = Child;
+        }
+    }
+
+    Scheduler_Place ( Task , index );
+}
+
+static void Scheduler_Place ( Task_t *task , uint8_t index )
+{
+    Scheduler_Heap [ index ] = task;
+    task->Index              = index;
+}
+
+static void Scheduler_Up ( uint8_t index )
+{
+    Task_t  *Task   = Scheduler_Heap [ index ];
+    uint8_t  Parent = 0;
+
+    while ( 0 != index )
+    {
+        Parent = ( uint8_t ) ( ( index - 1 ) / 2 );
+
+        if ( Scheduler_Heap [ Parent ]->Deadline <= Task->Deadline )
+        {
+            break;
+        }
+        else
+        {
+            Scheduler_Place ( Scheduler_Heap [ Parent ] , index );
+            index = Parent;
+        }
+    }
+
+    Scheduler_Place ( Task , index );
+}
+
+/*** end of file ***/
@@ -0,0 +1,258 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           spi_link.c                                            *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <spi_link.h>
+
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/spi.h>
+
+// Transactions run entirely from DMA. The receive channel always runs ,
+// into a scratch byte for write only transfers , so completion means the
+// last byte has actually left the shift register.
+//
+// Every test bed chip select is an SPI0 CSn pin. The selected bed's pin is
+// given to the peripheral , the others are held high as plain outputs , so
+// the hardware still frames each transfer.
+static const uint              SPI_CS [ ] = SPI_CS_PINS;
+static uint8_t                 SPI_Bed      = 0;
+static volatile SPI_Callback_t SPI_Callback = NULL;
+static uint                    SPI_DMA_Rx   = 0;
+static uint                    SPI_DMA_Tx   = 0;
+static uint32_t                SPI_Deadline = 0;
+static uint8_t                 SPI_Discard  = 0;
+static uint8_t                 SPI_Length   = 0;
+static uint8_t                *SPI_Rx       = NULL;
+static uint32_t                SPI_Start    = 0;
+static volatile uint8_t        SPI_State    = SPI_STATUS_IDLE;
+
+volatile SPI_Stats_t SPI_Stats;
+
+static void SPI_DMA_ISR ( void );
+static void SPI_Release ( uint pin );
+
+void SPI_Init ( void )
+{
+    dma_channel_config Config_Rx;
+    dma_channel_config Config_Tx;
+    uint8_t            Counter_Bed = 0;
+
+    // SPI ( Master )
+    spi_init          ( SPI_MASTER   , SPI_BAUD_RATE * 1000 );
+    spi_set_slave     ( SPI_MASTER   , false                );
+    gpio_set_function ( SPI_CS_PIN   , GPIO_FUNC_SPI        );
+    gpio_set_function ( SPI_MISO_PIN , GPIO_FUNC_SPI        );
+    gpio_set_function ( SPI_MOSI_PIN , GPIO_FUNC_SPI        );
+    gpio_set_function ( SPI_SCK_PIN  , GPIO_FUNC_SPI        );
+
+    // Remaining test beds deselected
+    for ( Counter_Bed = 1 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
+    {
+        SPI_Release ( SPI_CS [ Counter_Bed ] );
+    }
+
+    SPI_DMA_Rx = ( uint ) dma_claim_unused_channel ( true );
+    SPI_DMA_Tx = ( uint ) dma_claim_unused_channel ( true );
+
+    Config_Tx = dma_channel_get_default_config ( SPI_DMA_Tx );
+    channel_config_set_transfer_data_size ( &Config_Tx , DMA_SIZE_8                          );
+    channel_config_set_read_increment     ( &Config_Tx , true                                );
+    channel_config_set_write_increment    ( &Config_Tx , false                               );
+    channel_config_set_dreq               ( &Config_Tx , spi_get_dreq ( SPI_MASTER , true  ) );
+    dma_channel_configure ( SPI_DMA_Tx , &Config_Tx , &spi_get_hw ( SPI_MASTER )->dr , NULL , 0 , false );
+
+    Config_Rx = dma_channel_get_default_config ( SPI_DMA_Rx );
+    channel_config_set_transfer_data_size ( &Config_Rx , DMA_SIZE_8                          );
+    channel_config_set_read_increment     ( &Config_Rx , false                               );
+    channel_config_set_write_increment    ( &Config_Rx , true                                );
+    channel_config_set_dreq               ( &Config_Rx , spi_get_dreq ( SPI_MASTER , false ) );
+    dma_channel_configure ( SPI_DMA_Rx , &Config_Rx , NULL , &spi_get_hw ( SPI_MASTER )->dr , 0 , false );
+
+    dma_channel_set_irq0_enabled ( SPI_DMA_Rx , true );
+    irq_set_exclusive_handler    ( SPI_DMA_IRQ , SPI_DMA_ISR );
+    irq_set_enabled              ( SPI_DMA_IRQ , true );
+}
+
+// Route the chip select to bed , between transactions only. Returns false
+// while a transaction is in progress.
+bool SPI_Select ( uint8_t bed )
+{
+    bool Selected = false;
+
+    if ( ( SPI_STATUS_BUSY != SPI_State ) && ( bed < TESTBED_COUNT ) )
+    {
+        if ( bed != SPI_Bed )
+        {
+            // Old pin high before the new one is handed over , never two selected
+            SPI_Release       ( SPI_CS [ SPI_Bed ] );
+            gpio_set_function ( SPI_CS [ bed ] , GPIO_FUNC_SPI );
+            SPI_Bed = bed;
+        }
+        else
+        {
+            // Nothing to do
+        }
+
+        Selected = true;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Selected;
+}
+
+// Returns the clock actually set
+uint32_t SPI_SetBaud ( uint32_t baud )
+{
+    return spi_set_baudrate ( SPI_MASTER , baud );
+}
+
+// Start a full duplex transfer , rx may be NULL for a write only transfer.
+// Returns false if a transaction is already in progress.
+bool SPI_Submit ( const uint8_t *tx , uint8_t *rx , uint8_t length , uint16_t timeout_ms , SPI_Callback_t callback )
+{
+    dma_channel_config Config_Rx = dma_get_channel_config ( SPI_DMA_Rx );
+    bool               Accepted  = false;
+
+    if ( ( SPI_STATUS_BUSY != SPI_State ) && ( 0 != length ) )
+    {
+        SPI_Callback = callback;
+        SPI_Length   = length;
+        SPI_Rx       = rx;
+        SPI_Start    = time_us_32 ( );
+        SPI_Deadline = SPI_Start + ( ( uint32_t ) timeout_ms * 1000 );
+        SPI_State    = SPI_STATUS_BUSY;
+
+        channel_config_set_write_increment ( &Config_Rx , ( NULL != rx ) );
+        dma_channel_set_config      ( SPI_DMA_Rx , &Config_Rx , false );
+        dma_channel_set_write_addr  ( SPI_DMA_Rx , ( NULL != rx ) ? rx : &SPI_Discard , false );
+        dma_channel_set_trans_count ( SPI_DMA_Rx , length , false );
+        dma_channel_set_read_addr   ( SPI_DMA_Tx , tx , false );
+        dma_channel_set_trans_count ( SPI_DMA_Tx , length , false );
+
+        // Start both together so the receive FIFO can never overflow
+        dma_start_channel_mask ( ( 1u << SPI_DMA_Rx ) | ( 1u << SPI_DMA_Tx ) );
+
+        Accepted = true;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Accepted;
+}
+
+// Current status , expiring the transaction if its timeout has passed
+uint8_t SPI_Poll ( void )
+{
+    uint8_t Status = SPI_State;
+
+    if ( ( SPI_STATUS_BUSY == Status ) && ( ( int32_t ) ( time_us_32 ( ) - SPI_Deadline ) > 0 ) )
+    {
+        // Leave BUSY first so a late completion interrupt is ignored
+        SPI_State = SPI_STATUS_TIMEOUT;
+
+        dma_channel_set_irq0_enabled ( SPI_DMA_Rx , false );
+        dma_channel_abort            ( SPI_DMA_Tx );
+        dma_channel_abort            ( SPI_DMA_Rx );
+        dma_channel_acknowledge_irq0 ( SPI_DMA_Rx );
+        dma_channel_set_irq0_enabled ( SPI_DMA_Rx , true  );
+
+        // Bytes already in the transmit FIFO still clock out after the abort ,
+        // so drain the receive FIFO until the shifter is idle , then once more
+        // for the last byte , and clear any overrun from the aborted transfer
+        while ( spi_is_busy ( SPI_MASTER ) )
+        {
+            while ( spi_is_readable ( SPI_MASTER ) )
+            {
+                ( void ) spi_get_hw ( SPI_MASTER )->dr;
+            }
+        }
+
+        while ( spi_is_readable ( SPI_MASTER ) )
+        {
+            ( void ) spi_get_hw ( SPI_MASTER )->dr;
+        }
+
+        spi_get_hw ( SPI_MASTER )->icr = SPI_SSPICR_RORIC_BITS;
+
+        SPI_Stats.Timeouts++;
+        Status = SPI_STATUS_TIMEOUT;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( SPI_STATUS_BUSY != Status )
+    {
+        SPI_State = SPI_STATUS_IDLE;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Status;
+}
+
+static void SPI_DMA_ISR ( void )
+{
+    if ( dma_channel_get_irq0_status ( SPI_DMA_Rx ) )
+    {
+        dma_channel_acknowledge_irq0 ( SPI_DMA_Rx );
+
+        if ( SPI_STATUS_BUSY == SPI_State )
+        {
+            SPI_Stats.Duration    = time_us_32 ( ) - SPI_Start;
+            SPI_Stats.DurationMax = ( SPI_Stats.Duration > SPI_Stats.DurationMax ) ? SPI_Stats.Duration : SPI_Stats.DurationMax;
+            SPI_Stats.Completed++;
+            SPI_State             = SPI_STATUS_DONE;
+
+            if ( NULL != SPI_Callback )
+            {
+                SPI_Callback ( SPI_Rx , SPI_Length );
+            }
+            else
+            {
+                // Nothing to do
+            }
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Chip select driven high from SIO , level and direction set before the
+// function so the pin never glitches low
+static void SPI_Release ( uint pin )
+{
+    gpio_put          ( pin , 1             );
+    gpio_set_dir      ( pin , GPIO_OUT      );
+    gpio_set_function ( pin , GPIO_FUNC_SIO );
+}
+
+/*** end of file ***/
@@ -0,0 +1,349 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           telemetry.c                                           *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <telemetry.h>
+#include <beds.h>
+#include <buttons.h>
+#include <hub75.h>
+#include <link.h>
+#include <protocol.h>
+#include <spi_link.h>
+
+#include <string.h>
+
+// Single producer , single consumer : only tasks on core 0 push , and the
+// scheduler never runs one task inside another , so Telemetry_Push is the
+// only writer of the head and Telemetry_Drain the only writer of the tail.
+// Nothing masks interrupts. Interrupt handlers never push , they count into
+// the variables below and Telemetry_Drain turns those into records.
+static uint8_t           Telemetry_Ring [ TELEMETRY_RING_LENGTH ];
+static volatile uint32_t Telemetry_Head = 0;    // Free running byte counts
+static volatile uint32_t Telemetry_Tail = 0;
+
+// Written by the SPI interrupt only , Count and Total free running
+static volatile uint32_t Telemetry_SPI_Count  = 0;
+static volatile uint32_t Telemetry_SPI_Max    = 0;    // us , over Telemetry_SPI_Seen
+static volatile uint32_t Telemetry_SPI_Seen   = 0;    // Window the max is for
+static volatile uint32_t Telemetry_SPI_Total  = 0;    // us
+
+// Written by the button interrupt only , the latest drop and a free running count
+static volatile uint32_t Telemetry_Drops      = 0;
+static volatile uint8_t  Telemetry_DropMask   = 0;
+static volatile uint8_t  Telemetry_DropType   = 0;
+
+// Written by Telemetry_Drain only
+static volatile uint32_t Telemetry_SPI_Window = 0;    // Moved on by each drain , restarts the max
+static uint32_t          Telemetry_Drops_Last = 0;
+static uint32_t          Telemetry_SPI_Last   = 0;    // Telemetry_SPI_Count at the last drain
+static uint32_t          Telemetry_SPI_Sum    = 0;    // Telemetry_SPI_Total at the last drain
+
+// Health period , reset by each TELEMETRY_HEALTH record
+static uint32_t          Telemetry_Booted [ 2 ] = { 0 , 0 };     // us , by TELEMETRY_BOOT_ event
+static uint32_t          Telemetry_Fed_Last   = 0;
+static uint32_t          Telemetry_Frames     = 0;
+static uint32_t          Telemetry_Margin     = UINT32_MAX;   // us
+static uint32_t          Telemetry_Overruns   = 0;
+static uint32_t          Telemetry_CRC        = 0;
+static uint32_t          Telemetry_Dropped    = 0;
+static uint32_t          Telemetry_Since      = 0;
+static uint32_t          Telemetry_Sync       = 0;
+static uint32_t          Telemetry_Timeouts   = 0;
+static uint32_t          Telemetry_Period_Count = 0;    // SPI transactions , from each drain
+static uint32_t          Telemetry_Period_Max   = 0;    // us
+static uint32_t          Telemetry_Period_Total = 0;    // us
+
+volatile Telemetry_Stats_t Telemetry_Stats;
+
+static void Telemetry_Collect ( void );
+static void Telemetry_Health  ( uint32_t now );
+static void Telemetry_Put16   ( uint8_t *data , uint32_t value );
+
+// A button event lost to a full queue , called from the debounce interrupt
+void Telemetry_ButtonDrop ( uint8_t mask , uint8_t type )
+{
+    Telemetry_DropMask = mask;
+    Telemetry_DropType = type;
+    Hal_Barrier ( );
+    Telemetry_Drops++;
+}
+
+// Send what the ring holds , called from a task
+void Telemetry_Drain ( void )
+{
+    uint32_t Now    = Hal_Micros ( );
+    uint32_t Head   = Telemetry_Head;
+    uint32_t Length = 0;
+    uint32_t First  = 0;
+    uint32_t Offset = Telemetry_Tail & ( TELEMETRY_RING_LENGTH - 1 );
+
+    Telemetry_Collect ( );
+    Head = Telemetry_Head;
+
+    if ( ( Now - Telemetry_Since ) >= ( TELEMETRY_HEALTH_MS * 1000 ) )
+    {
+        Telemetry_Health ( Now );
+        Head = Telemetry_Head;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Hal_Barrier ( );
+    Length = Head - Telemetry_Tail;
+    Length = ( Length > TELEMETRY_DRAIN_MAX ) ? TELEMETRY_DRAIN_MAX : Length;
+    First  = ( Length > ( TELEMETRY_RING_LENGTH - Offset ) ) ? ( TELEMETRY_RING_LENGTH - Offset ) : Length;
+
+    if ( ( 0 != Length ) && Hal_HostConnected ( ) )
+    {
+        Hal_HostWrite ( &Telemetry_Ring [ Offset ] , First );
+        Hal_HostWrite ( &Telemetry_Ring [ 0 ] , Length - First );
+        Telemetry_Stats.Sent += Length;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Hal_Barrier ( );
+    Telemetry_Tail += Length;
+}
+
+// Records the first-frame and first-status times , TELEMETRY_BOOT_FRAME and
+// TELEMETRY_BOOT_STATUS , only the first time of each is kept
+void Telemetry_Boot ( uint8_t event , uint32_t time )
+{
+    if ( ( event <= TELEMETRY_BOOT_STATUS ) && ( 0 == Telemetry_Booted [ event ] ) )
+    {
+        Telemetry_Booted [ event ] = ( 0 != time ) ? time : 1;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// Called on each watchdog feed , keeps the closest the watchdog came to expiring
+void Telemetry_Fed ( void )
+{
+    uint32_t Now      = Hal_Micros ( );
+    uint32_t Interval = Now - Telemetry_Fed_Last;
+    uint32_t Margin   = ( Interval < ( WATCHDOG_MILLISECONDS * 1000 ) ) ? ( ( WATCHDOG_MILLISECONDS * 1000 ) - Interval ) : 0;
+
+    Telemetry_Margin   = ( Margin < Telemetry_Margin ) ? Margin : Telemetry_Margin;
+    Telemetry_Fed_Last = Now;
+}
+
+void Telemetry_Init ( void )
+{
+    memset ( ( void * ) &Telemetry_Stats , 0 , sizeof ( Telemetry_Stats ) );
+
+    Telemetry_Fed_Last = Hal_Micros ( );
+    Telemetry_Since    = Telemetry_Fed_Last;
+    Telemetry_Frames   = Hub75_Jitter.Count;
+}
+
+void Telemetry_LinkError ( uint8_t bed , uint8_t kind )
+{
+    uint8_t Payload [ 7 ];
+
+    bed = ( bed < TESTBED_COUNT ) ? bed : 0;
+
+    Payload [ 0 ] = kind;
+    Payload [ 1 ] = Link_Stats [ bed ].Step;
+    Telemetry_Put16 ( &Payload [ 2 ] , Link_Stats [ bed ].Baud >> 16    );
+    Telemetry_Put16 ( &Payload [ 4 ] , Link_Stats [ bed ].Baud & 0xFFFF );
+    Payload [ 6 ] = bed;
+
+    Telemetry_Push ( TELEMETRY_LINK_ERROR , Payload , sizeof ( Payload ) );
+}
+
+// Safe from interrupt handlers and tasks on core 0 , false if the ring is full
+bool Telemetry_Push ( uint8_t type , const uint8_t *payload , uint8_t length )
+{
+    uint8_t  Record [ TELEMETRY_HEADER_LENGTH + TELEMETRY_PAYLOAD_MAX + 2 ];
+    uint32_t Now            = Hal_Micros ( );
+    uint16_t CRC            = 0;
+    uint8_t  Length         = 0;
+    uint8_t  Counter_Byte   = 0;
+    bool     Pushed         = false;
+
+    length = ( length > TELEMETRY_PAYLOAD_MAX ) ? TELEMETRY_PAYLOAD_MAX : length;
+    Length = TELEMETRY_HEADER_LENGTH + length + 2;
+
+    Record [ 0 ] = TELEMETRY_SYNC;
+    Record [ 1 ] = type;
+    Record [ 2 ] = length;
+    Telemetry_Put16 ( &Record [ 3 ] , Now >> 16    );
+    Telemetry_Put16 ( &Record [ 5 ] , Now & 0xFFFF );
+    memcpy ( &Record [ TELEMETRY_HEADER_LENGTH ] , payload , length );
+
+    CRC = Protocol_CRC16 ( &Record [ 1 ] , TELEMETRY_HEADER_LENGTH - 1 + length );
+    Telemetry_Put16 ( &Record [ TELEMETRY_HEADER_LENGTH + length ] , CRC );
+
+    if ( ( TELEMETRY_RING_LENGTH - ( Telemetry_Head - Telemetry_Tail ) ) >= Length )
+    {
+        for ( Counter_Byte = 0 ; Counter_Byte < Length ; Counter_Byte++ )
+        {
+            Telemetry_Ring [ ( Telemetry_Head + Counter_Byte ) & ( TELEMETRY_RING_LENGTH - 1 ) ] = Record [ Counter_Byte ];
+        }
+
+        Hal_Barrier ( );
+        Telemetry_Head += Length;
+        Telemetry_Stats.Records++;
+        Pushed = true;
+    }
+    else
+    {
+        Telemetry_Stats.Overruns++;
+    }
+
+    return Pushed;
+}
+
+// Transaction complete , called from the SPI interrupt. A window the drain
+// has moved on from starts a new max.
+void Telemetry_SPI ( uint32_t latency )
+{
+    uint32_t Window = Telemetry_SPI_Window;
+
+    Telemetry_SPI_Max    = ( ( Window != Telemetry_SPI_Seen ) || ( latency > Telemetry_SPI_Max ) ) ? latency : Telemetry_SPI_Max;
+    Telemetry_SPI_Seen   = Window;
+    Telemetry_SPI_Total += latency;
+    Hal_Barrier ( );
+    Telemetry_SPI_Count++;
+}
+
+// What the interrupt handlers counted since the last drain , one
+// TELEMETRY_SPI record for all its transactions and one TELEMETRY_BUTTON_DROP
+// for any drops. A transaction completing part way through may have its
+// latency in the max of one window and its count in the next.
+static void Telemetry_Collect ( void )
+{
+    uint8_t  Payload [ 4 ];
+    uint32_t Window = Telemetry_SPI_Window;
+    uint32_t Count  = Telemetry_SPI_Count;
+    uint32_t Drops  = Telemetry_Drops;
+    uint32_t Max    = 0;
+    uint32_t Total  = 0;
+
+    Hal_Barrier ( );
+    Total = Telemetry_SPI_Total;
+    Max   = ( Window == Telemetry_SPI_Seen ) ? Telemetry_SPI_Max : 0;
+    Telemetry_SPI_Window = Window + 1;
+
+    if ( Count != Telemetry_SPI_Last )
+    {
+        Telemetry_Period_Count += Count - Telemetry_SPI_Last;
+        Telemetry_Period_Total += Total - Telemetry_SPI_Sum;
+        Telemetry_Period_Max    = ( Max > Telemetry_Period_Max ) ? Max : Telemetry_Period_Max;
+
+        Telemetry_Put16 ( &Payload [ 0 ] , Max );
+        Telemetry_Put16 ( &Payload [ 2 ] , Count - Telemetry_SPI_Last );
+        Telemetry_Push  ( TELEMETRY_SPI , Payload , 4 );
+
+        Telemetry_SPI_Last = Count;
+        Telemetry_SPI_Sum  = Total;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    if ( Drops != Telemetry_Drops_Last )
+    {
+        Payload [ 0 ] = Telemetry_DropMask;
+        Payload [ 1 ] = Telemetry_DropType;
+        Payload [ 2 ] = ( uint8_t ) ( ( ( Drops - Telemetry_Drops_Last ) > UINT8_MAX ) ? UINT8_MAX : ( Drops - Telemetry_Drops_Last ) );
+        Telemetry_Push ( TELEMETRY_BUTTON_DROP , Payload , 3 );
+
+        Telemetry_Drops_Last = Drops;
+    }
+    else
+    {
+        // Nothing to do
+    }
+}
+
+// TELEMETRY_HEALTH payload , 16 bits each :
+//   refresh ( Hz x 100 ) , watchdog margin ( ms ) , SPI transactions ,
+//   SPI latency mean and max ( us ) , CRC errors , sync errors , SPI timeouts ,
+//   buttons dropped , records lost , SPI clock of test bed 0 ( kHz )
+// Counts are for the period since the previous health record.
+static void Telemetry_Health ( uint32_t now )
+{
+    uint8_t  Payload [ 22 ];
+    uint8_t  Counter_Bed = 0;
+    uint32_t Count       = Telemetry_Period_Count;
+    uint32_t Frames      = Hub75_Jitter.Count;
+    uint32_t Max         = Telemetry_Period_Max;
+    uint32_t Period      = now - Telemetry_Since;
+    uint32_t Total       = Telemetry_Period_Total;
+
+    Telemetry_Put16 ( &Payload [  0 ] , ( uint32_t ) ( ( ( uint64_t ) ( Frames - Telemetry_Frames ) * 100000000ull ) / Period ) );
+    Telemetry_Put16 ( &Payload [  2 ] , ( UINT32_MAX != Telemetry_Margin ) ? ( Telemetry_Margin / 1000 ) : WATCHDOG_MILLISECONDS );
+    Telemetry_Put16 ( &Payload [  4 ] , Count );
+    Telemetry_Put16 ( &Payload [  6 ] , ( 0 != Count ) ? ( Total / Count ) : 0 );
+    Telemetry_Put16 ( &Payload [  8 ] , Max );
+    Telemetry_Put16 ( &Payload [ 10 ] , Protocol_Stats.CRC_Errors  - Telemetry_CRC      );
+    Telemetry_Put16 ( &Payload [ 12 ] , Protocol_Stats.Sync_Errors - Telemetry_Sync     );
+    Telemetry_Put16 ( &Payload [ 14 ] , SPI_Stats.Timeouts         - Telemetry_Timeouts );
+    Telemetry_Put16 ( &Payload [ 16 ] , Buttons_Stats.Dropped      - Telemetry_Dropped  );
+    Telemetry_Put16 ( &Payload [ 18 ] , Telemetry_Stats.Overruns   - Telemetry_Overruns );
+    Telemetry_Put16 ( &Payload [ 20 ] , Link_Stats [ 0 ].Baud / 1000 );
+
+    Telemetry_CRC      = Protocol_Stats.CRC_Errors;
+    Telemetry_Dropped  = Buttons_Stats.Dropped;
+    Telemetry_Frames   = Frames;
+    Telemetry_Margin   = UINT32_MAX;
+    Telemetry_Overruns = Telemetry_Stats.Overruns;
+    Telemetry_Since    = now;
+    Telemetry_Period_Count = 0;
+    Telemetry_Period_Max   = 0;
+    Telemetry_Period_Total = 0;
+    Telemetry_Sync     = Protocol_Stats.Sync_Errors;
+    Telemetry_Timeouts = SPI_Stats.Timeouts;
+
+    Telemetry_Push ( TELEMETRY_HEALTH , Payload , sizeof ( Payload ) );
+
+    // Repeated , a host may open the port long after start up
+    Telemetry_Put16 ( &Payload [ 0 ] , Telemetry_Booted [ TELEMETRY_BOOT_FRAME  ] >> 16    );
+    Telemetry_Put16 ( &Payload [ 2 ] , Telemetry_Booted [ TELEMETRY_BOOT_FRAME  ] & 0xFFFF );
+    Telemetry_Put16 ( &Payload [ 4 ] , Telemetry_Booted [ TELEMETRY_BOOT_STATUS ] >> 16    );
+    Telemetry_Put16 ( &Payload [ 6 ] , Telemetry_Booted [ TELEMETRY_BOOT_STATUS ] & 0xFFFF );
+
+    Telemetry_Push ( TELEMETRY_BOOT , Payload , 8 );
+
+    for ( Counter_Bed = 0 ; Counter_Bed < TESTBED_COUNT ; Counter_Bed++ )
+    {
+        Telemetry_Put16 ( &Payload [ Counter_Bed * 4     ] , Beds_Stats [ Counter_Bed ].Age    / 1000 );
+        Telemetry_Put16 ( &Payload [ Counter_Bed * 4 + 2 ] , Beds_Stats [ Counter_Bed ].AgeMax / 1000 );
+    }
+
+    Telemetry_Push ( TELEMETRY_BEDS , Payload , TESTBED_COUNT * 4 );
+}
+
+// MSB first , values over 16 bits saturate
+static void Telemetry_Put16 ( uint8_t *data , uint32_t value )
+{
+    value = ( value > UINT16_MAX ) ? UINT16_MAX : value;
+
+    data [ 0 ] = ( uint8_t ) ( value >> 8 );
+    data [ 1 ] = ( uint8_t )   value;
+}
+
+/*** end of file ***/
@@ -0,0 +1,153 @@
+/*
+*******************************************************************************
+ *  Author:             Craig Hemingway                                       *
+ *  Company:            Dynament Ltd.                                         *
+ *                      Status Scientific Controls Ltd.                       *
+ *  Project :           24-Way Premier IR Sensor Jig                          *
+ *  Filename:           text.c                                                *
+ *  Date:               17/10/2026                                            *
+ *  File Version:   	1.0.0                                                 *
+ *  Version history:    1.0.0 - 17/10/2026 - Craig Hemingway                  *
+ *                          Initial release                                   *
+ *  Tools Used: Visual Studio Code -> 1.73.1                                  *
+ *              Compiler           -> GCC 11.3.1 arm-none-eabi                *
+ *                                                                            *
+ ******************************************************************************
+*/
+
+#include <text.h>
+#include <hub75.h>
+
+#include <string.h>
+
+typedef struct
+{
+    uint32_t Lanes  [ FONT_HEIGHT ] [ TEXT_LENGTH ];   // Per row , each character's Font_Lanes word
+    uint32_t Used;                                     // Text_Clock when last drawn , 0 for never
+    uint16_t Column;
+    uint8_t  Row;
+    uint8_t  Length;
+    char     Text   [ TEXT_LENGTH ];
+} Text_Entry_t;
+
+static Text_Entry_t Text_Cache [ TEXT_CACHE_ENTRIES ];
+static uint32_t     Text_Clock = 0;
+
+volatile Text_Stats_t Text_Stats;
+
+static Text_Entry_t *Text_Find      ( uint row , uint column , const char *text , uint8_t length );
+static void          Text_Rasterise ( Text_Entry_t *entry , const char *text , uint8_t length );
+
+// Draw text into a field of chars characters , the rest blanked , with its
+// top left at row , column. column must be a multiple of FONT_PITCH , a
+// framebuffer word boundary. Only valid while Hub75_IsReady. Returns the
+// pixel rows that changed.
+uint32_t Text_Draw ( uint row , uint column , const char *text , uint8_t chars , uint32_t colour )
+{
+    Text_Entry_t *Entry         = NULL;
+    uint32_t      Dirty         = 0;
+    char          Field         [ TEXT_LENGTH ];
+    uint8_t       Counter_Char  = 0;
+    uint          Counter_Row   = 0;
+    bool          End           = false;
+
+    chars = ( chars < TEXT_LENGTH ) ? chars : TEXT_LENGTH;
+
+    for ( Counter_Char = 0 ; Counter_Char < chars ; Counter_Char++ )
+    {
+        End                    = End || ( '\0' == text [ Counter_Char ] );
+        Field [ Counter_Char ] = End ? ' ' : text [ Counter_Char ];
+    }
+
+    if ( 0 != chars )
+    {
+        Entry = Text_Find ( row , column , Field , chars );
+
+        for ( Counter_Row = 0 ; ( Counter_Row < FONT_HEIGHT ) && ( ( row + Counter_Row ) < MATRIX_HEIGHT ) ; Counter_Row++ )
+        {
+            Hub75_Blit ( row + Counter_Row , column , Entry->Lanes [ Counter_Row ] , chars , colour );
+            Dirty |= 1u << ( row + Counter_Row );
+        }
+
+        Text_Stats.Characters += chars;
+        Text_Stats.Draws++;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    return Dirty;
+}
+
+// Cache entry holding text drawn at row , column , gathered into the least
+// recently used entry if it is not there yet
+static Text_Entry_t *Text_Find ( uint row , uint column , const char *text , uint8_t length )
+{
+    Text_Entry_t *Entry         = NULL;
+    Text_Entry_t *Oldest        = &Text_Cache [ 0 ];
+    uint8_t       Counter_Entry = 0;
+
+    for ( Counter_Entry = 0 ; ( Counter_Entry < TEXT_CACHE_ENTRIES ) && ( NULL == Entry ) ; Counter_Entry++ )
+    {
+        if ( ( 0 != Text_Cache [ Counter_Entry ].Used ) && ( row == Text_Cache [ Counter_Entry ].Row ) && ( column == Text_Cache [ Counter_Entry ].Column )
+          && ( length == Text_Cache [ Counter_Entry ].Length ) && ( 0 == memcmp ( text , Text_Cache [ Counter_Entry ].Text , length ) ) )
+        {
+            Entry = &Text_Cache [ Counter_Entry ];
+            Text_Stats.Hits++;
+        }
+        else if ( Text_Cache [ Counter_Entry ].Used < Oldest->Used )
+        {
+            Oldest = &Text_Cache [ Counter_Entry ];
+        }
+        else
+        {
+            // Nothing to do
+        }
+    }
+
+    if ( NULL == Entry )
+    {
+        Entry         = Oldest;
+        Entry->Row    = ( uint8_t  ) row;
+        Entry->Column = ( uint16_t ) column;
+        Text_Rasterise ( Entry , text , length );
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    Entry->Used = ++Text_Clock;
+
+    return Entry;
+}
+
+// Each character's glyph words from flash , a word per character and row
+static void Text_Rasterise ( Text_Entry_t *entry , const char *text , uint8_t length )
+{
+    uint8_t Glyph         = 0;
+    uint8_t Counter_Char  = 0;
+    uint8_t Counter_Row   = 0;
+    char    Char          = 0;
+
+    for ( Counter_Char = 0 ; Counter_Char < length ; Counter_Char++ )
+    {
+        // Lower case as upper case , anything else outside the font as '?'
+        Char  = text [ Counter_Char ];
+        Char  = ( ( Char >= 'a' ) && ( Char <= 'z' ) ) ? ( char ) ( Char - 'a' + 'A' ) : Char;
+        Glyph = ( uint8_t ) ( ( ( Char >= FONT_FIRST ) && ( Char <= FONT_LAST ) ) ? ( Char - FONT_FIRST ) : ( '?' - FONT_FIRST ) );
+
+        for ( Counter_Row = 0 ; Counter_Row < FONT_HEIGHT ; Counter_Row++ )
+        {
+            entry->Lanes [ Counter_Row ] [ Counter_Char ] = Font_Lanes [ Glyph ] [ Counter_Row ];
+        }
+    }
+
+    memcpy ( entry->Text , text , length );
+    entry->Length = length;
+
+    Text_Stats.Rasterised++;
+}
+
+/*** end of file ***/